@@ -17,10 +17,16 @@ repositories {
 
 dependencies {
     implementation("net.minestom:minestom-snapshots:ebaa2bbf64")
+
+    testImplementation(platform("org.junit:junit-bom:5.10.2"))
+    testImplementation("org.junit.jupiter:junit-jupiter")
+    testRuntimeOnly("org.junit.platform:junit-platform-launcher")
 }
 
 application {
     mainClass.set("net.swofty.Bootstrap")
+    // java.lang.foreign is still a preview API in 21; ForeignParser and ScriptDecoder use it
+    applicationDefaultJvmArgs = listOf("--enable-preview", "--enable-native-access=ALL-UNNAMED")
 }
 
 sourceSets {
@@ -66,9 +72,9 @@ tasks.register<JavaCompile>("genJniHeaders") {
     classpath = sourceSets.main.get().compileClasspath
     
     // Configure javac
-    options.compilerArgs = listOf(
+    options.compilerArgs.addAll(listOf(
         "-h", headersDir.absolutePath
-    )
+    ))
     
     // The output directory for class files (not headers)
     destinationDirectory.set(layout.buildDirectory.dir("tmp/jni-header-stubs"))
@@ -103,10 +109,37 @@ tasks.register<JavaCompile>("genJniHeaders") {
     }
 }
 
+tasks.withType<JavaCompile>().configureEach {
+    options.release.set(21)
+    options.compilerArgs.add("--enable-preview")
+}
+
 /* Make Java compilation depend on the header generation */
 tasks.named("compileJava") { dependsOn("genJniHeaders") }
 tasks.named("run") { dependsOn(":buildNative") }
 
+/* Tests and benchmarks load the library cmake writes into src/main/resources */
+val nativeJvmArgs = listOf(
+    "--enable-preview",
+    "--enable-native-access=ALL-UNNAMED",
+    "-Djava.library.path=${file("src/main/resources").absolutePath}",
+    "-Dswoftlang.scripts=${rootProject.file("scripts").absolutePath}"
+)
+
+tasks.test {
+    dependsOn(":buildNative")
+    useJUnitPlatform()
+    jvmArgs(nativeJvmArgs)
+}
+
+// gradle :java:benchmark -Pbenchmark=net.swofty.nativebridge.ParserBenchmark
+tasks.register<JavaExec>("benchmark") {
+    dependsOn(":buildNative")
+    classpath = sourceSets.test.get().runtimeClasspath
+    mainClass.set(providers.gradleProperty("benchmark"))
+    jvmArgs(nativeJvmArgs)
+}
+
 tasks.register("showDependencies") {
     doLast {
         configurations.compileClasspath.get().forEach {
@@ -1,39 +1,62 @@
 package net.swofty;
 
-import java.lang.reflect.Field;
-import java.lang.reflect.Method;
-import java.util.HashMap;
+import java.util.ArrayDeque;
+import java.util.Arrays;
 import java.util.Map;
+import java.util.Objects;
+import java.util.function.Function;
 
 import net.minestom.server.MinecraftServer;
 import net.minestom.server.command.CommandSender;
 import net.minestom.server.coordinate.Pos;
 import net.minestom.server.entity.Player;
 import net.minestom.server.item.ItemStack;
+import net.swofty.mapper.Accessors;
 import net.swofty.mapper.PropertyMapperInitializer;
 import net.swofty.mapper.PropertyMapperRegistry;
-import net.swofty.nativebridge.execution.BlockStatement;
-import net.swofty.nativebridge.execution.Expression;
-import net.swofty.nativebridge.execution.Statement;
-import net.swofty.nativebridge.execution.commands.CancelEventStatement;
-import net.swofty.nativebridge.execution.commands.HaltCommand;
-import net.swofty.nativebridge.execution.commands.IfStatement;
-import net.swofty.nativebridge.execution.commands.SendCommand;
-import net.swofty.nativebridge.execution.commands.TeleportCommand;
-import net.swofty.nativebridge.execution.commands.VariableAssignment;
+import net.swofty.nativebridge.CompiledHandler;
+import net.swofty.nativebridge.NativeEngine;
 import net.swofty.nativebridge.execution.expressions.BinaryExpression;
-import net.swofty.nativebridge.execution.expressions.StringLiteral;
-import net.swofty.nativebridge.execution.expressions.TypeLiteral;
-import net.swofty.nativebridge.execution.expressions.VariableReference;
 import net.swofty.nativebridge.representation.ExecuteBlock;
+import net.swofty.nativebridge.representation.Program;
 
 /**
  * Executes pre-parsed SwoftLang AST directly with enhanced property resolution
+ *
+ * Handlers that run often should take an executor from acquire() and hand it back with
+ * release(). Executors are pooled per thread and keep their variables and frame arrays
+ * between runs, so a warm run does not allocate the executor or its frame again; what
+ * it still allocates comes from the handler (the strings it builds) and from the caller
+ * (an event's wrapper). AllocationBenchmark under src/test/java measures the event and
+ * command paths.
  */
 public class ASTExecutor {
-    private final CommandSender sender;
-    private final Map<String, Object> variables;
+    // Fixed frame slots - must match SlotResolver in the native parser
+    private static final int EVENT_SLOT = 1;
+
+    // Executors kept per thread; a handler whose effects fire another event nests one more
+    private static final int POOL_LIMIT = 8;
+    private static final ThreadLocal<ArrayDeque<ASTExecutor>> POOL = ThreadLocal.withInitial(ArrayDeque::new);
+
+    // Blocks run on the linked statement tree unless -Dswoftlang.executor opts in to one
+    // that runs compiled blocks: bytecode runs them in BytecodeInterpreter, native in the
+    // native VM, jvm as classes generated by the native JvmBackend
+    private static final String EXECUTOR = System.getProperty("swoftlang.executor", "tree");
+    private static volatile boolean nativeAvailable = true; // cleared if the library lacks the VM
+
+    private boolean runBytecode;
+    private boolean runJvm;
+    private boolean runNative;
+
+    private CommandSender sender;
+    private Object[] frame = new Object[0];
     private boolean halted = false;
+    private ExecutorHost host;
+
+    // Variables by name, searched linearly; a handler binds only a handful
+    private String[] variableNames = new String[8];
+    private Object[] variableValues = new Object[8];
+    private int variableCount;
 
     // Static initializer to ensure property mappers are initialized
     static {
@@ -42,46 +65,154 @@ public class ASTExecutor {
     }
 
     public ASTExecutor(CommandSender sender, Map<String, Object> variables) {
+        useExecutor(EXECUTOR);
         this.sender = sender;
-        this.variables = variables != null ? variables : new HashMap<>();
-        
+        if (variables != null) {
+            variables.forEach(this::bind);
+        }
+
         // Add sender to variables if not already present
-        if (!this.variables.containsKey("sender")) {
-            this.variables.put("sender", sender);
+        if (lookup("sender") == null) {
+            bind("sender", sender);
         }
     }
 
+    private ASTExecutor() {
+        useExecutor(EXECUTOR);
+    }
+
+    /**
+     * Run compiled blocks with the given executor instead of the one -Dswoftlang.executor
+     * chose, until this executor is released
+     * @param name bytecode, tree, jvm or native
+     */
+    void useExecutor(String name) {
+        runBytecode = !"tree".equals(name);
+        runJvm = "jvm".equals(name);
+        runNative = "native".equals(name);
+    }
+
+    /**
+     * Take an executor from this thread's pool, with no variables but "sender"
+     * @param sender The sender of the command or event
+     * @return The executor; pass it to release() when the run is over
+     */
+    public static ASTExecutor acquire(CommandSender sender) {
+        ASTExecutor executor = POOL.get().poll();
+        if (executor == null) {
+            executor = new ASTExecutor();
+        }
+        executor.sender = sender;
+        executor.bind("sender", sender);
+        return executor;
+    }
+
+    /**
+     * Reset this executor and return it to this thread's pool. It must not be used after.
+     */
+    public void release() {
+        // Drop references into the run so the pool does not keep them alive
+        Arrays.fill(variableNames, 0, variableCount, null);
+        Arrays.fill(variableValues, 0, variableCount, null);
+        Arrays.fill(frame, null);
+        variableCount = 0;
+        sender = null;
+        halted = false;
+        useExecutor(EXECUTOR);
+
+        ArrayDeque<ASTExecutor> pool = POOL.get();
+        if (pool.size() < POOL_LIMIT) {
+            pool.push(this);
+        }
+    }
+
+    /**
+     * Set a variable before execution, replacing any value it already has
+     * @param name The variable name
+     * @param value The value
+     */
+    public void bind(String name, Object value) {
+        for (int i = 0; i < variableCount; i++) {
+            if (variableNames[i].equals(name)) {
+                variableValues[i] = value;
+                return;
+            }
+        }
+
+        if (variableCount == variableNames.length) {
+            variableNames = Arrays.copyOf(variableNames, variableCount * 2);
+            variableValues = Arrays.copyOf(variableValues, variableCount * 2);
+        }
+        variableNames[variableCount] = name;
+        variableValues[variableCount] = value;
+        variableCount++;
+    }
+
+    private Object lookup(String name) {
+        for (int i = 0; i < variableCount; i++) {
+            if (variableNames[i].equals(name)) {
+                return variableValues[i];
+            }
+        }
+        return null;
+    }
+
     /**
      * Execute an execute block
      */
     public void execute(ExecuteBlock block) {
-        for (Statement statement : block.getStatements()) {
-            if (halted) {
-                break;
+        // A halt ends the block it runs in, not the next one run by this executor
+        halted = false;
+
+        Program program = block.getProgram();
+        if (program != null && runJvm) {
+            CompiledHandler handler = HandlerClasses.get(program, block.getSlotNames().length);
+            if (handler != null) {
+                frame = createFrame(block.getSlotNames(), block.getSlotNames().length);
+                handler.run(this, frame);
+                return;
             }
-            executeStatement(statement);
         }
+
+        if (program != null && runNative && nativeAvailable) {
+            frame = createFrame(block.getSlotNames(), block.getSlotNames().length);
+            try {
+                if (host == null) {
+                    host = new ExecutorHost(this);
+                }
+                if (NativeEngine.run(program.getNativeHandle(), frame, host) == NativeEngine.HALTED) {
+                    halt();
+                }
+                return;
+            } catch (UnsatisfiedLinkError e) {
+                System.err.println("Native VM unavailable, using the bytecode interpreter: " + e.getMessage());
+                nativeAvailable = false;
+            }
+        }
+
+        if (program != null && runBytecode) {
+            frame = createFrame(block.getSlotNames(), program.getRegisterCount());
+            BytecodeInterpreter.run(this, program, frame);
+            return;
+        }
+
+        frame = createFrame(block.getSlotNames(), block.getSlotNames().length);
+        TreeLinker.get(block).run(this, frame);
     }
 
     /**
-     * Execute a single statement
+     * Fill each slot of the block's frame from the variable of the same name. This is
+     * the only name lookup per run; variable accesses after it index the frame.
+     * Bytecode uses the registers past the slots as temporaries. The previous frame is
+     * reused when it is large enough; the code of a block never reads past its size.
      */
-    protected void executeStatement(Statement statement) {
-        if (statement instanceof SendCommand) {
-            executeSendCommand((SendCommand) statement);
-        } else if (statement instanceof TeleportCommand) {
-            executeTeleportCommand((TeleportCommand) statement);
-        } else if (statement instanceof HaltCommand) {
-            halted = true;
-        } else if (statement instanceof IfStatement) {
-            executeIfStatement((IfStatement) statement);
-        } else if (statement instanceof BlockStatement) {
-            executeBlockStatement((BlockStatement) statement);
-        } else if (statement instanceof VariableAssignment) {
-            executeVariableAssignment((VariableAssignment) statement);
-        } else if (statement instanceof CancelEventStatement) {
-            executeCancelEventStatement();
+    private Object[] createFrame(String[] slotNames, int size) {
+        Object[] values = frame.length >= size ? frame : new Object[size];
+        for (int i = 0; i < slotNames.length; i++) {
+            values[i] = lookup(slotNames[i]);
         }
+        Arrays.fill(values, slotNames.length, values.length, null);
+        return values;
     }
 
     /**
@@ -89,31 +220,29 @@ public class ASTExecutor {
      */
     protected void executeCancelEventStatement() {
         // Get the event object
-        Object event = getVariable("event");
+        Object event = frame.length > EVENT_SLOT ? frame[EVENT_SLOT] : getVariable("event");
         if (event == null) {
             System.err.println("Error: Cannot cancel event - no event object found");
             return;
         }
 
         // Try to call cancel method on the event object
+        Function<Object, Object> cancel = Accessors.method(event.getClass(), "cancel");
+        if (cancel == null) {
+            System.err.println("Error: Cannot cancel event - " + event.getClass().getName() + ".cancel()");
+            return;
+        }
         try {
-            Method cancelMethod = event.getClass().getMethod("cancel");
-            cancelMethod.invoke(event);
+            cancel.apply(event);
         } catch (Exception e) {
             System.err.println("Error: Cannot cancel event - " + e.getMessage());
         }
     }
 
     /**
-     * Execute a send command
+     * Deliver a rendered message to the sender, every player, or one player
      */
-    private void executeSendCommand(SendCommand command) {
-        String message = evaluateStringExpression(command.getMessage());
-        Object target = command.getTarget() != null ? evaluateExpression(command.getTarget()) : sender;
-
-        // Format color codes
-        message = formatColorCodes(message);
-
+    void sendMessage(String message, Object target) {
         if (target == null || target == sender || target.equals("sender")) {
             sender.sendMessage(message);
         } else if (target.equals("all")) {
@@ -129,12 +258,9 @@ public class ASTExecutor {
     }
 
     /**
-     * Execute a teleport command
+     * Teleport a player to another player or a position
      */
-    private void executeTeleportCommand(TeleportCommand command) {
-        Object entity = evaluateExpression(command.getEntity());
-        Object target = evaluateExpression(command.getTarget());
-
+    void teleport(Object entity, Object target) {
         if (!(entity instanceof Player)) {
             sender.sendMessage("Error: Cannot teleport non-player entity");
             return;
@@ -165,37 +291,9 @@ public class ASTExecutor {
     }
 
     /**
-     * Execute an if statement
-     */
-    private void executeIfStatement(IfStatement statement) {
-        boolean conditionResult = evaluateBooleanExpression(statement.getCondition());
-
-        if (conditionResult) {
-            executeStatement(statement.getThenStatement());
-        } else if (statement.getElseStatement() != null) {
-            executeStatement(statement.getElseStatement());
-        }
-    }
-
-    /**
-     * Execute a block statement
-     */
-    private void executeBlockStatement(BlockStatement statement) {
-        for (Statement stmt : statement.getStatements()) {
-            if (halted) {
-                break;
-            }
-            executeStatement(stmt);
-        }
-    }
-
-    /**
-     * Execute a variable assignment
+     * Assign to a variable the parser could not bind to a frame slot
      */
-    private void executeVariableAssignment(VariableAssignment assignment) {
-        String variableName = assignment.getVariableName();
-        Object value = evaluateExpression(assignment.getValue());
-        
+    void assignVariable(String variableName, Object value) {
         // Check if this is a property assignment (contains a dot)
         if (variableName.contains(".")) {
             String[] parts = variableName.split("\\.", 2);
@@ -206,41 +304,40 @@ public class ASTExecutor {
             if (obj != null) {
                 setNestedProperty(obj, propPath, value);
             } else {
-                System.err.println("Error: Cannot set property on non-existent object: " + objName);
+                reportMissingObject(objName);
             }
         } else {
             // Simple variable assignment
-            variables.put(variableName, value);
+            bind(variableName, value);
         }
     }
 
+    void reportMissingObject(String variableName) {
+        System.err.println("Error: Cannot set property on non-existent object: " + variableName);
+    }
+
     /**
-     * Evaluate an expression and get its value
+     * Store a value at the end of a property path starting at a frame value
      */
-    protected Object evaluateExpression(Expression expression) {
-        if (expression instanceof StringLiteral) {
-            String value = ((StringLiteral) expression).getValue();
-            return interpolateString(value);
-        } else if (expression instanceof VariableReference) {
-            String name = ((VariableReference) expression).getName();
-            return getVariable(name);
-        } else if (expression instanceof BinaryExpression) {
-            return evaluateBinaryExpression((BinaryExpression) expression);
-        } else if (expression instanceof TypeLiteral) {
-            return ((TypeLiteral) expression).getTypeName();
+    void assignPath(Object obj, String[] path, Object value, String variableName) {
+        if (obj == null) {
+            reportMissingObject(variableName);
+            return;
+        }
+        
+        // Walk to the object that owns the last segment
+        for (int i = 0; i < path.length - 1 && obj != null; i++) {
+            obj = getObjectProperty(obj, path[i]);
+        }
+        if (obj != null) {
+            setObjectProperty(obj, path[path.length - 1], value);
         }
-
-        throw new RuntimeException("Unknown expression type: " + expression.getClass().getSimpleName());
     }
 
     /**
-     * Evaluate a binary expression
+     * Apply any operator but the short-circuiting AND/OR to evaluated operands
      */
-    protected Object evaluateBinaryExpression(BinaryExpression expression) {
-        Object left = evaluateExpression(expression.getLeft());
-        Object right = evaluateExpression(expression.getRight());
-        BinaryExpression.Operator operator = expression.getOperator();
-
+    Object applyOperator(BinaryExpression.Operator operator, Object left, Object right) {
         switch (operator) {
             case EQUALS:
                 return objectsEqual(left, right);
@@ -254,32 +351,33 @@ public class ASTExecutor {
                 return compareObjects(left, right) <= 0;
             case GREATER_EQUALS:
                 return compareObjects(left, right) >= 0;
-            case AND:
-                return toBoolean(left) && toBoolean(right);
-            case OR:
-                return toBoolean(left) || toBoolean(right);
+            case STRING_EQUALS:
+                return Objects.equals(left, right);
+            case STRING_NOT_EQUALS:
+                return !Objects.equals(left, right);
+            case NUMBER_EQUALS:
+                return numbersEqual(left, right);
+            case NUMBER_NOT_EQUALS:
+                return !numbersEqual(left, right);
+            case NUMBER_LESS_THAN:
+                return compareNumbers(left, right) < 0;
+            case NUMBER_GREATER_THAN:
+                return compareNumbers(left, right) > 0;
+            case NUMBER_LESS_EQUALS:
+                return compareNumbers(left, right) <= 0;
+            case NUMBER_GREATER_EQUALS:
+                return compareNumbers(left, right) >= 0;
+            case IDENTITY_EQUALS:
+                return left == right;
+            case IDENTITY_NOT_EQUALS:
+                return left != right;
             case IS_TYPE:
                 return isType(left, (String) right);
             case IS_NOT_TYPE:
                 return !isType(left, (String) right);
             case CONTAINS:
-            {
-                // Debug logging to inspect operands
-                System.out.println("CONTAINS check - Left: '" + left + "' (" +
-                        (left != null ? left.getClass().getName() : "null") +
-                        "), Right: '" + right + "' (" +
-                        (right != null ? right.getClass().getName() : "null") + ")");
-
-                // Convert both operands to lowercase strings for case-insensitive comparison
-                String leftStr = left != null ? getDisplayString(left).toLowerCase() : "";
-                String rightStr = right != null ? getDisplayString(right).toLowerCase() : "";
-
-                // Check if leftStr contains rightStr
-                boolean result = leftStr.contains(rightStr);
-                System.out.println("CONTAINS result: " + result + " (checking if '" +
-                        leftStr + "' contains '" + rightStr + "')");
-                return result;
-            }
+                // Case-insensitive, without lowered copies of either operand
+                return FoldedNeedle.contains(searchText(left), searchText(right));
             
             case CONCATENATE:
                 {
@@ -302,11 +400,11 @@ public class ASTExecutor {
         String[] parts = path.split("\\.");
         
         // Get the root object
-        Object current = variables.get(parts[0]);
+        Object current = lookup(parts[0]);
         if (current == null) {
             // Special case for "args" prefix
             if (parts[0].equals("args") && parts.length > 1) {
-                return variables.get(parts[1]);
+                return lookup(parts[1]);
             }
             return null;
         }
@@ -326,61 +424,14 @@ public class ASTExecutor {
 
     /**
      * Get a property value from an object
-     * Uses the PropertyMapperRegistry first, then falls back to reflection
+     * Uses the PropertyMapperRegistry first, then falls back to reflection; the
+     * accessor is resolved once per class (see PropertyAccess)
      */
     protected Object getObjectProperty(Object obj, String property) {
         if (obj == null) {
             return null;
         }
-
-        // Try the property mapper registry first
-        Object value = PropertyMapperRegistry.getProperty(obj, property);
-        if (value != null) {
-            return value;
-        }
-
-        // Fall back to reflection
-        try {
-            // Try to find a getter method first
-            String getterName = "get" + Character.toUpperCase(property.charAt(0)) + property.substring(1);
-            Method getter = null;
-            
-            try {
-                getter = obj.getClass().getMethod(getterName);
-            } catch (NoSuchMethodException e) {
-                // Try alternative getter for boolean properties
-                if (property.length() > 2 && property.startsWith("is")) {
-                    try {
-                        getter = obj.getClass().getMethod(property);
-                    } catch (NoSuchMethodException e2) {
-                        // No getter found
-                    }
-                }
-            }
-            
-            if (getter != null) {
-                return getter.invoke(obj);
-            }
-            
-            // If no getter, try direct field access
-            try {
-                Field field = obj.getClass().getField(property);
-                return field.get(obj);
-            } catch (NoSuchFieldException e) {
-                // No public field found
-            }
-            
-            // Try declared fields (including private ones)
-            Field field = obj.getClass().getDeclaredField(property);
-            field.setAccessible(true);
-            return field.get(obj);
-            
-        } catch (Exception e) {
-            // Debug log when a property is not found
-            System.out.println("Error accessing property '" + property + "' on object of type " + 
-                              obj.getClass().getName() + ": " + e.getMessage());
-            return null;
-        }
+        return PropertyAccess.getter(obj.getClass(), property).get(obj);
     }
 
     /**
@@ -409,65 +460,20 @@ public class ASTExecutor {
 
     /**
      * Set a property value on an object
-     * Uses the PropertyMapperRegistry first, then falls back to reflection
+     * Uses the PropertyMapperRegistry first, then falls back to reflection; the
+     * accessor is resolved once per class (see PropertyAccess)
      */
     protected void setObjectProperty(Object obj, String property, Object value) {
         if (obj == null) {
             return;
         }
-
-        // Try the property mapper registry first
-        if (PropertyMapperRegistry.setProperty(obj, property, value)) {
-            return;
-        }
-
-        // Fall back to reflection
-        try {
-            // Try to find a setter method first
-            String setterName = "set" + Character.toUpperCase(property.charAt(0)) + property.substring(1);
-            
-            // Find all methods that match the setter name
-            for (Method method : obj.getClass().getMethods()) {
-                if (method.getName().equals(setterName) && method.getParameterCount() == 1) {
-                    // Convert the value to the expected type if needed
-                    Class<?> paramType = method.getParameterTypes()[0];
-                    Object convertedValue = convertValue(value, paramType);
-                    
-                    if (convertedValue != null || paramType.isPrimitive()) {
-                        method.invoke(obj, convertedValue);
-                        return;
-                    }
-                }
-            }
-            
-            // If no setter, try direct field access
-            try {
-                Field field = obj.getClass().getField(property);
-                Class<?> fieldType = field.getType();
-                Object convertedValue = convertValue(value, fieldType);
-                field.set(obj, convertedValue);
-                return;
-            } catch (NoSuchFieldException e) {
-                // No public field found
-            }
-            
-            // Try declared fields (including private ones)
-            Field field = obj.getClass().getDeclaredField(property);
-            field.setAccessible(true);
-            Class<?> fieldType = field.getType();
-            Object convertedValue = convertValue(value, fieldType);
-            field.set(obj, convertedValue);
-            
-        } catch (Exception e) {
-            System.err.println("Error setting property '" + property + "' on object of type " + 
-                              obj.getClass().getName() + ": " + e.getMessage());
-        }
+        PropertyAccess.setter(obj.getClass(), property).set(this, obj, value);
     }
 
     /**
      * Convert a value to the specified type if possible
      */
-    private Object convertValue(Object value, Class<?> targetType) {
+    Object convertValue(Object value, Class<?> targetType) {
         if (value == null) {
             return null;
         }
@@ -545,33 +551,6 @@ public class ASTExecutor {
         return null;
     }
 
-    /**
-     * Interpolate variables in a string
-     */
-    private String interpolateString(String text) {
-        // Simple variable interpolation
-        StringBuilder result = new StringBuilder();
-        int i = 0;
-
-        while (i < text.length()) {
-            if (text.charAt(i) == '$' && i + 1 < text.length() && text.charAt(i + 1) == '{') {
-                // Find the closing brace
-                int closeIndex = text.indexOf('}', i + 2);
-                if (closeIndex != -1) {
-                    String varName = text.substring(i + 2, closeIndex);
-                    Object value = getVariable(varName);
-                    result.append(value != null ? getDisplayString(value) : "");
-                    i = closeIndex + 1;
-                    continue;
-                }
-            }
-            result.append(text.charAt(i));
-            i++;
-        }
-
-        return result.toString();
-    }
-
     protected String getDisplayString(Object value) {
         if (value instanceof Player) {
             return ((Player) value).getUsername();
@@ -588,26 +567,10 @@ public class ASTExecutor {
         }
     }
 
-    /**
-     * Evaluate an expression as a string
-     */
-    protected String evaluateStringExpression(Expression expression) {
-        Object value = evaluateExpression(expression);
-        return value != null ? value.toString() : "";
-    }
-
-    /**
-     * Evaluate an expression as a boolean
-     */
-    protected boolean evaluateBooleanExpression(Expression expression) {
-        Object value = evaluateExpression(expression);
-        return toBoolean(value);
-    }
-
     /**
      * Convert an object to a boolean
      */
-    private boolean toBoolean(Object obj) {
+    boolean toBoolean(Object obj) {
         if (obj instanceof Boolean) {
             return (Boolean) obj;
         }
@@ -620,10 +583,24 @@ public class ASTExecutor {
         return obj != null;
     }
 
+    /**
+     * Check if a value contains a needle lowered in advance, as CONTAINS does
+     */
+    boolean contains(Object value, FoldedNeedle needle) {
+        return needle.foundIn(searchText(value));
+    }
+
+    /**
+     * Get the text CONTAINS searches for or in
+     */
+    String searchText(Object value) {
+        return value != null ? getDisplayString(value) : "";
+    }
+
     /**
      * Check if two objects are equal
      */
-    private boolean objectsEqual(Object left, Object right) {
+    boolean objectsEqual(Object left, Object right) {
         if (left == null && right == null) return true;
         if (left == null || right == null) return false;
 
@@ -635,10 +612,31 @@ public class ASTExecutor {
         return left.equals(right);
     }
 
+    /**
+     * Equality for operands the parser typed as numbers; they can still be null
+     */
+    boolean numbersEqual(Object left, Object right) {
+        if (left == null || right == null) {
+            return left == right;
+        }
+        return ((Number) left).doubleValue() == ((Number) right).doubleValue();
+    }
+
+    /**
+     * Ordering for operands the parser typed as numbers. A null operand takes the
+     * generic path so it fails the same way.
+     */
+    int compareNumbers(Object left, Object right) {
+        if (left == null || right == null) {
+            return compareObjects(left, right);
+        }
+        return Double.compare(((Number) left).doubleValue(), ((Number) right).doubleValue());
+    }
+
     /**
      * Compare two objects
      */
-    private int compareObjects(Object left, Object right) {
+    int compareObjects(Object left, Object right) {
         if (left instanceof Number && right instanceof Number) {
             double l = ((Number) left).doubleValue();
             double r = ((Number) right).doubleValue();
@@ -656,7 +654,7 @@ public class ASTExecutor {
     /**
      * Check if an object is of a certain type
      */
-    private boolean isType(Object obj, String typeName) {
+    boolean isType(Object obj, String typeName) {
         switch (typeName) {
             case "Player":
                 return obj instanceof Player;
@@ -673,30 +671,15 @@ public class ASTExecutor {
         }
     }
 
-    /**
-     * Format color codes in a string
-     */
-    private String formatColorCodes(String text) {
-        return text.replace("<red>", "§c")
-                .replace("<green>", "§a")
-                .replace("<lime>", "§a")
-                .replace("<blue>", "§9")
-                .replace("<yellow>", "§e")
-                .replace("<gold>", "§6")
-                .replace("<white>", "§f")
-                .replace("<black>", "§0")
-                .replace("<reset>", "§r");
-    }
-
     protected void halt() {
         this.halted = true;
     }
 
-    protected CommandSender getSender() {
-        return sender;
+    boolean isHalted() {
+        return halted;
     }
 
-    protected Map<String, Object> getVariables() {
-        return variables;
+    protected CommandSender getSender() {
+        return sender;
     }
 }
\ No newline at end of file
@@ -0,0 +1,230 @@
+package net.swofty;
+
+import net.swofty.nativebridge.execution.expressions.BinaryExpression;
+import net.swofty.nativebridge.representation.MatchTable;
+import net.swofty.nativebridge.representation.Program;
+import net.swofty.nativebridge.representation.SwitchTable;
+
+/**
+ * Runs the register bytecode the native Compiler produces for an execute block (see
+ * Bytecode.h for the instruction set). One switch per instruction replaces the
+ * instanceof chains of the tree walker; the semantics of each operation are those of
+ * ASTExecutor, which this class calls into.
+ */
+final class BytecodeInterpreter {
+    // Opcodes - must match Opcode in Bytecode.h
+    private static final int LOAD_CONST = 0;
+    private static final int LOAD_BOOL = 1;
+    private static final int MOVE = 2;
+    private static final int GET_PATH = 3;
+    private static final int SET_PATH = 4;
+    private static final int BINARY = 5;
+    private static final int CONCAT = 6;
+    private static final int TO_MESSAGE = 7;
+    private static final int JUMP = 8;
+    private static final int JUMP_IF_FALSE = 9;
+    private static final int JUMP_IF_TRUE = 10;
+    private static final int SWITCH = 11;
+    private static final int SEND = 12;
+    private static final int TELEPORT = 13;
+    private static final int CANCEL = 14;
+    private static final int HALT = 15;
+    private static final int RETURN = 16;
+    private static final int MATCH = 17;
+
+    // CONCAT flags - must match Bytecode.h
+    private static final int CONCAT_TRANSLATE = 1;
+    private static final int CONCAT_SKIP_NULL = 2;
+
+    private static final BinaryExpression.Operator[] OPERATORS = BinaryExpression.Operator.values();
+    private static final int CONTAINS = BinaryExpression.Operator.CONTAINS.ordinal();
+
+    private BytecodeInterpreter() {
+    }
+
+    /**
+     * Run a program to completion
+     * @param executor Supplies the sender, property access and operator semantics
+     * @param program The compiled block
+     * @param frame The block's slots followed by room for its temporaries
+     */
+    static void run(ASTExecutor executor, Program program, Object[] frame) {
+        int[] code = program.getCode();
+        Object[] constants = program.getConstants();
+        Object[] sites = program.getPropertySites();
+        if (sites == null) {
+            // Programs racing here create equivalent sites; either may be kept
+            sites = sites(code, constants);
+            program.setPropertySites(sites);
+        }
+        int pc = 0;
+        int start = 0;
+
+        try {
+            while (true) {
+                start = pc;
+                switch (code[pc]) {
+                    case LOAD_CONST -> {
+                        frame[code[pc + 1]] = constants[code[pc + 2]];
+                        pc += 3;
+                    }
+                    case LOAD_BOOL -> {
+                        frame[code[pc + 1]] = code[pc + 2] != 0;
+                        pc += 3;
+                    }
+                    case MOVE -> {
+                        frame[code[pc + 1]] = frame[code[pc + 2]];
+                        pc += 3;
+                    }
+                    case GET_PATH -> {
+                        frame[code[pc + 1]] = ((PropertyAccess.PathSite) sites[code[pc + 3]]).read(frame[code[pc + 2]]);
+                        pc += 4;
+                    }
+                    case SET_PATH -> {
+                        ((PropertyAccess.PathSite) sites[code[pc + 2]]).write(executor, frame[code[pc + 1]],
+                                frame[code[pc + 3]], (String) constants[code[pc + 4]]);
+                        pc += 5;
+                    }
+                    case BINARY -> {
+                        Object left = operand(code[pc + 3], frame, constants);
+                        int right = code[pc + 4];
+                        if (code[pc + 2] == CONTAINS && right < 0) {
+                            frame[code[pc + 1]] = executor.contains(left, (FoldedNeedle) sites[-(right + 1)]);
+                        } else {
+                            frame[code[pc + 1]] = executor.applyOperator(OPERATORS[code[pc + 2]], left,
+                                    operand(right, frame, constants));
+                        }
+                        pc += 5;
+                    }
+                    case CONCAT -> {
+                        frame[code[pc + 1]] = concat(executor, code, pc, frame, constants);
+                        pc += 5 + code[pc + 4];
+                    }
+                    case TO_MESSAGE -> {
+                        frame[code[pc + 1]] = toMessage(frame[code[pc + 2]]);
+                        pc += 3;
+                    }
+                    case JUMP -> pc = code[pc + 1];
+                    case JUMP_IF_FALSE -> pc = executor.toBoolean(frame[code[pc + 1]]) ? pc + 3 : code[pc + 2];
+                    case JUMP_IF_TRUE -> pc = executor.toBoolean(frame[code[pc + 1]]) ? code[pc + 2] : pc + 3;
+                    case SWITCH -> pc = ((SwitchTable) constants[code[pc + 2]]).target(frame[code[pc + 1]], code[pc + 3]);
+                    case MATCH -> pc = ((MatchTable) constants[code[pc + 2]]).target(
+                            matchText(executor, frame[code[pc + 1]]), code[pc + 3]);
+                    case SEND -> {
+                        int target = code[pc + 2];
+                        executor.sendMessage((String) operand(code[pc + 1], frame, constants),
+                                target >= 0 ? frame[target] : executor.getSender());
+                        pc += 3;
+                    }
+                    case TELEPORT -> {
+                        executor.teleport(frame[code[pc + 1]], frame[code[pc + 2]]);
+                        pc += 3;
+                    }
+                    case CANCEL -> {
+                        executor.executeCancelEventStatement();
+                        pc += 1;
+                    }
+                    case HALT -> {
+                        executor.halt();
+                        return;
+                    }
+                    case RETURN -> {
+                        return;
+                    }
+                    default -> throw new IllegalStateException("Unknown opcode " + code[pc] + " at " + pc);
+                }
+            }
+        } catch (RuntimeException e) {
+            throw failure(e, program.lineAt(start));
+        }
+    }
+
+    // Helpers shared with the classes JvmBackend generates, which call them by name
+
+    /**
+     * Wrap a failure with the source line it happened on
+     * @param line The line, or 0 if unknown
+     */
+    static RuntimeException failure(RuntimeException cause, int line) {
+        return new RuntimeException((line > 0 ? "Line " + line + ": " : "") + cause.getMessage(), cause);
+    }
+
+    /**
+     * Get the text a CONCAT appends for a register part
+     */
+    static String concatPart(ASTExecutor executor, Object value, int flags) {
+        if (value == null && (flags & CONCAT_SKIP_NULL) != 0) {
+            return "";
+        }
+        String text = executor.getDisplayString(value);
+        return (flags & CONCAT_TRANSLATE) != 0 ? ColorCodes.translate(text) : text;
+    }
+
+    /**
+     * Get the text a MATCH scans, as CONTAINS renders its left operand
+     */
+    static String matchText(ASTExecutor executor, Object value) {
+        return executor.searchText(value);
+    }
+
+    /**
+     * Create what run() keeps per constant: a PathSite for each property path and a
+     * FoldedNeedle for each string literal a CONTAINS searches for
+     */
+    private static Object[] sites(int[] code, Object[] constants) {
+        Object[] sites = PropertyAccess.pathSites(constants);
+        for (int pc = 0; pc < code.length; pc += length(code, pc)) {
+            if (code[pc] == BINARY && code[pc + 2] == CONTAINS && code[pc + 4] < 0) {
+                int index = -(code[pc + 4] + 1);
+                if (sites[index] == null) {
+                    sites[index] = new FoldedNeedle((String) constants[index]);
+                }
+            }
+        }
+        return sites;
+    }
+
+    /**
+     * Get the length of an instruction, opcode included
+     */
+    private static int length(int[] code, int pc) {
+        return switch (code[pc]) {
+            case CANCEL, HALT, RETURN -> 1;
+            case JUMP -> 2;
+            case LOAD_CONST, LOAD_BOOL, MOVE, TO_MESSAGE, JUMP_IF_FALSE, JUMP_IF_TRUE, SEND, TELEPORT -> 3;
+            case GET_PATH, SWITCH, MATCH -> 4;
+            case SET_PATH, BINARY -> 5;
+            case CONCAT -> 5 + code[pc + 4];
+            default -> throw new IllegalStateException("Unknown opcode " + code[pc] + " at " + pc);
+        };
+    }
+
+    static String toMessage(Object value) {
+        return ColorCodes.translate(value != null ? value.toString() : "");
+    }
+
+    /**
+     * Read a register, or a string constant if the operand is negative
+     */
+    private static Object operand(int operand, Object[] frame, Object[] constants) {
+        return operand >= 0 ? frame[operand] : constants[-operand - 1];
+    }
+
+    private static String concat(ASTExecutor executor, int[] code, int pc, Object[] frame, Object[] constants) {
+        int flags = code[pc + 2];
+        int count = code[pc + 4];
+        StringBuilder result = new StringBuilder(code[pc + 3]);
+
+        for (int i = 0; i < count; i++) {
+            int part = code[pc + 5 + i];
+            if (part < 0) {
+                result.append((String) constants[-part - 1]);
+                continue;
+            }
+
+            result.append(concatPart(executor, frame[part], flags));
+        }
+
+        return result.toString();
+    }
+}
@@ -0,0 +1,68 @@
+package net.swofty;
+
+/**
+ * Translates color tags such as {@code <red>} into section-sign codes in a single pass.
+ * Literal message text is already translated by the native parser (ColorTags.cpp holds
+ * the same table), so this only sees values inserted into a message at runtime.
+ */
+public final class ColorCodes {
+    // Tag name and code pairs - must match COLOR_TAGS in ColorTags.cpp
+    private static final String[][] TAGS = {
+            {"red", "§c"},
+            {"green", "§a"},
+            {"lime", "§a"},
+            {"blue", "§9"},
+            {"yellow", "§e"},
+            {"gold", "§6"},
+            {"white", "§f"},
+            {"black", "§0"},
+            {"reset", "§r"},
+    };
+
+    private ColorCodes() {
+    }
+
+    public static String translate(String text) {
+        int open = text.indexOf('<');
+        if (open < 0) {
+            return text;
+        }
+
+        StringBuilder result = null;
+        int copied = 0;
+
+        while (open >= 0) {
+            int close = text.indexOf('>', open + 1);
+            if (close < 0) {
+                break;
+            }
+
+            // Only the last '<' before the '>' can start a tag
+            int start = text.lastIndexOf('<', close);
+            String code = codeFor(text, start + 1, close);
+            if (code != null) {
+                if (result == null) {
+                    result = new StringBuilder(text.length());
+                }
+                result.append(text, copied, start).append(code);
+                copied = close + 1;
+            }
+            open = text.indexOf('<', close + 1);
+        }
+
+        if (result == null) {
+            return text;
+        }
+        return result.append(text, copied, text.length()).toString();
+    }
+
+    private static String codeFor(String text, int nameStart, int nameEnd) {
+        int length = nameEnd - nameStart;
+        for (String[] tag : TAGS) {
+            if (tag[0].length() == length && text.regionMatches(nameStart, tag[0], 0, length)) {
+                return tag[1];
+            }
+        }
+        return null;
+    }
+}
@@ -0,0 +1,53 @@
+package net.swofty;
+
+import java.util.Collection;
+
+/**
+ * The properties of an event wrapper as they were at one moment, for handlers that run
+ * after the event's listener has returned. It is read on the event thread and stands in
+ * for the wrapper as "event": scripts read its properties as they would the wrapper's,
+ * and it has no others. Property values are kept as they were read, so an object among
+ * them, such as the player, is still the live object.
+ */
+public final class EventSnapshot {
+    private final String[] names;
+    private final Object[] values;
+    private final String display;
+
+    private EventSnapshot(String[] names, Object[] values, String display) {
+        this.names = names;
+        this.values = values;
+        this.display = display;
+    }
+
+    /**
+     * Read properties of an event wrapper, as scripts would read them
+     * @param event The wrapper
+     * @param properties The property names handlers read from it
+     */
+    public static EventSnapshot of(Object event, Collection<String> properties) {
+        String[] names = properties.toArray(new String[0]);
+        Object[] values = new Object[names.length];
+        for (int i = 0; i < names.length; i++) {
+            values[i] = PropertyAccess.getter(event.getClass(), names[i]).get(event);
+        }
+        return new EventSnapshot(names, values, String.valueOf(event));
+    }
+
+    /**
+     * @return The value read for a property, or null if it was not read
+     */
+    Object get(String property) {
+        for (int i = 0; i < names.length; i++) {
+            if (names[i].equals(property)) {
+                return values[i];
+            }
+        }
+        return null;
+    }
+
+    @Override
+    public String toString() {
+        return display;
+    }
+}
@@ -0,0 +1,50 @@
+package net.swofty;
+
+import net.minestom.server.coordinate.Pos;
+import net.minestom.server.entity.Player;
+import net.swofty.nativebridge.NativeHost;
+
+/**
+ * Serves the native VM's upcalls from an ASTExecutor, so a program run natively reads
+ * properties and performs effects exactly as the interpreters do
+ */
+final class ExecutorHost implements NativeHost {
+    private final ASTExecutor executor;
+
+    ExecutorHost(ASTExecutor executor) {
+        this.executor = executor;
+    }
+
+    @Override
+    public Object getProperty(Object object, String property) {
+        return executor.getObjectProperty(object, property);
+    }
+
+    @Override
+    public String text(Object value, boolean display) {
+        return display ? executor.getDisplayString(value) : String.valueOf(value);
+    }
+
+    @Override
+    public int typeOf(Object object) {
+        if (object instanceof Player) {
+            return PLAYER;
+        }
+        return object instanceof Pos ? LOCATION : OTHER;
+    }
+
+    @Override
+    public void apply(int[] kinds, Object[] operands) {
+        for (int i = 0; i < kinds.length; i++) {
+            Object first = operands[i * 3];
+            Object second = operands[i * 3 + 1];
+            switch (kinds[i]) {
+                case SEND -> executor.sendMessage((String) first, second != null ? second : executor.getSender());
+                case TELEPORT -> executor.teleport(first, second);
+                case CANCEL -> executor.executeCancelEventStatement();
+                case SET_PROPERTY -> executor.setObjectProperty(first, (String) operands[i * 3 + 2], second);
+                default -> throw new IllegalStateException("Unknown effect " + kinds[i]);
+            }
+        }
+    }
+}
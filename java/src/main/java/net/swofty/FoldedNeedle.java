@@ -0,0 +1,76 @@
+package net.swofty;
+
+/**
+ * Case-insensitive substring search for CONTAINS that folds each character as it
+ * compares it, so neither string is copied in lower case. A position is only compared in
+ * full once the needle's first and last characters agree with it.
+ *
+ * Characters are folded one at a time with Character.toLowerCase, with a shortcut for
+ * ASCII. A FoldedNeedle keeps the needle lowered once, for needles known before the
+ * search - CONTAINS against a string literal.
+ */
+final class FoldedNeedle {
+    private final char[] folded;
+
+    FoldedNeedle(String needle) {
+        folded = new char[needle.length()];
+        for (int i = 0; i < folded.length; i++) {
+            folded[i] = fold(needle.charAt(i));
+        }
+    }
+
+    boolean foundIn(String text) {
+        char[] needle = folded;
+        int m = needle.length;
+        if (m == 0) {
+            return true;
+        }
+
+        char first = needle[0];
+        char last = needle[m - 1];
+        for (int i = 0, end = text.length() - m; i <= end; i++) {
+            if (fold(text.charAt(i)) == first && fold(text.charAt(i + m - 1)) == last) {
+                int j = 1;
+                while (j < m - 1 && fold(text.charAt(i + j)) == needle[j]) {
+                    j++;
+                }
+                if (j >= m - 1) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Search for a needle only known at runtime
+     */
+    static boolean contains(String text, String needle) {
+        int m = needle.length();
+        if (m == 0) {
+            return true;
+        }
+
+        char first = fold(needle.charAt(0));
+        char last = fold(needle.charAt(m - 1));
+        for (int i = 0, end = text.length() - m; i <= end; i++) {
+            if (fold(text.charAt(i)) == first && fold(text.charAt(i + m - 1)) == last) {
+                int j = 1;
+                while (j < m - 1 && fold(text.charAt(i + j)) == fold(needle.charAt(j))) {
+                    j++;
+                }
+                if (j >= m - 1) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    static char fold(char c) {
+        if (c < 128) {
+            return c >= 'A' && c <= 'Z' ? (char) (c + ('a' - 'A')) : c;
+        }
+        return Character.toLowerCase(c);
+    }
+}
@@ -0,0 +1,66 @@
+package net.swofty;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+
+import net.swofty.nativebridge.CompiledHandler;
+import net.swofty.nativebridge.NativeEngine;
+import net.swofty.nativebridge.representation.Program;
+
+/**
+ * Defines the JVM classes the native JvmBackend generates for compiled programs. Each
+ * is a hidden class of this package, so it can call ASTExecutor's package-private
+ * methods, and becomes unreachable along with its Program.
+ */
+final class HandlerClasses {
+    private static final MethodHandles.Lookup LOOKUP = MethodHandles.lookup();
+
+    // Hidden classes get a unique suffix, so every handler can share the name
+    private static final String CLASS_NAME = "net/swofty/GeneratedHandler";
+
+    // Stands in for a program that could not be compiled, so it is only tried once
+    private static final CompiledHandler UNAVAILABLE = (executor, frame) -> {
+        throw new IllegalStateException("No handler class");
+    };
+
+    private static volatile boolean enabled = true; // cleared if the library lacks the backend
+
+    private HandlerClasses() {
+    }
+
+    /**
+     * Get the handler class for a program, generating it on first use
+     * @param slotCount How many slots the program's block has
+     * @return The handler, or null if the program has to be interpreted
+     */
+    static CompiledHandler get(Program program, int slotCount) {
+        CompiledHandler handler = program.getHandler();
+        if (handler == null && enabled) {
+            synchronized (program) {
+                handler = program.getHandler();
+                if (handler == null) {
+                    handler = define(program, slotCount);
+                    program.setHandler(handler);
+                }
+            }
+        }
+        return handler != UNAVAILABLE ? handler : null;
+    }
+
+    private static CompiledHandler define(Program program, int slotCount) {
+        try {
+            byte[] bytes = NativeEngine.generateClass(program.getCode(), program.getConstants(), program.getLines(),
+                    program.getRegisterCount(), slotCount, CLASS_NAME);
+            MethodHandles.Lookup lookup = LOOKUP.defineHiddenClass(bytes, true);
+            return (CompiledHandler) lookup.findConstructor(lookup.lookupClass(),
+                    MethodType.methodType(void.class, Object[].class)).invoke(program.getConstants());
+        } catch (UnsatisfiedLinkError e) {
+            System.err.println("Handler classes unavailable, using the bytecode interpreter: " + e.getMessage());
+            enabled = false;
+            return null;
+        } catch (Throwable e) {
+            System.err.println("Error: Cannot define a handler class - " + e.getMessage());
+            return UNAVAILABLE;
+        }
+    }
+}
@@ -0,0 +1,385 @@
+package net.swofty;
+
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.function.BiConsumer;
+import java.util.function.Function;
+
+import net.swofty.mapper.Accessors;
+import net.swofty.mapper.PropertyMapperRegistry;
+
+/**
+ * Property reads and writes, resolved once per receiver class and property name
+ * instead of on every access. Resolution follows the rules getObjectProperty and
+ * setObjectProperty have always had: a registered mapper first, then a getter or
+ * setter method, then a public field, then a declared field. The result is a mapper
+ * function or a direct caller from Accessors. An EventSnapshot answers with the values
+ * it holds.
+ *
+ * Resolved accessors are shared per class. On top of that, every property access in a
+ * linked tree or a program gets a Site: an inline cache of the last few receiver
+ * classes seen there, so a warm access is a class compare and a call. Everything is
+ * resolved again after the registered mappers change.
+ */
+final class PropertyAccess {
+    interface Getter {
+        Object get(Object obj);
+    }
+
+    interface Setter {
+        void set(ASTExecutor executor, Object obj, Object value);
+    }
+
+    /**
+     * The accessors resolved while one set of mappers was registered
+     */
+    private static final class Tables {
+        final int generation;
+
+        final ClassValue<Map<String, Getter>> getters = new ClassValue<>() {
+            @Override
+            protected Map<String, Getter> computeValue(Class<?> type) {
+                return new ConcurrentHashMap<>();
+            }
+        };
+
+        final ClassValue<Map<String, Setter>> setters = new ClassValue<>() {
+            @Override
+            protected Map<String, Setter> computeValue(Class<?> type) {
+                return new ConcurrentHashMap<>();
+            }
+        };
+
+        Tables(int generation) {
+            this.generation = generation;
+        }
+    }
+
+    private static volatile Tables tables = new Tables(PropertyMapperRegistry.getGeneration());
+
+    private PropertyAccess() {
+    }
+
+    private static Tables tables() {
+        Tables current = tables;
+        int generation = PropertyMapperRegistry.getGeneration();
+        if (current.generation != generation) {
+            // Mappers changed since these were resolved
+            current = new Tables(generation);
+            tables = current;
+        }
+        return current;
+    }
+
+    static Getter getter(Class<?> type, String property) {
+        Map<String, Getter> getters = tables().getters.get(type);
+        Getter getter = getters.get(property);
+        return getter != null ? getter : getters.computeIfAbsent(property, name -> resolveGetter(type, name));
+    }
+
+    static Setter setter(Class<?> type, String property) {
+        Map<String, Setter> setters = tables().setters.get(type);
+        Setter setter = setters.get(property);
+        return setter != null ? setter : setters.computeIfAbsent(property, name -> resolveSetter(type, name));
+    }
+
+    /**
+     * The inline cache of one property access. Entries are immutable and prepended, so
+     * threads that race on a miss at worst drop an entry and miss again later. Past
+     * POLYMORPHIC_LIMIT classes the site stops caching and uses the per-class tables.
+     * Entries resolved before the registered mappers last changed are dropped.
+     */
+    static final class Site {
+        private static final int POLYMORPHIC_LIMIT = 4;
+
+        private static final class Entry {
+            final Class<?> type;
+            final Getter getter;
+            final Setter setter;
+            final int generation;
+            final Entry next;
+
+            Entry(Class<?> type, Getter getter, Setter setter, int generation, Entry next) {
+                this.type = type;
+                this.getter = getter;
+                this.setter = setter;
+                this.generation = generation;
+                this.next = next;
+            }
+        }
+
+        private final String property;
+        private Entry entries;
+        private int size;
+
+        Site(String property) {
+            this.property = property;
+        }
+
+        Object get(Object obj) {
+            if (obj == null) {
+                return null;
+            }
+            Class<?> type = obj.getClass();
+            for (Entry entry = current(); entry != null; entry = entry.next) {
+                if (entry.type == type) {
+                    return entry.getter.get(obj);
+                }
+            }
+            return miss(type).getter.get(obj);
+        }
+
+        void set(ASTExecutor executor, Object obj, Object value) {
+            if (obj == null) {
+                return;
+            }
+            Class<?> type = obj.getClass();
+            for (Entry entry = current(); entry != null; entry = entry.next) {
+                if (entry.type == type) {
+                    entry.setter.set(executor, obj, value);
+                    return;
+                }
+            }
+            miss(type).setter.set(executor, obj, value);
+        }
+
+        // All entries share the generation of the first
+        private Entry current() {
+            Entry first = entries;
+            return first != null && first.generation == PropertyMapperRegistry.getGeneration() ? first : null;
+        }
+
+        // A path's last segment is both read and written, so an entry has both accessors
+        private Entry miss(Class<?> type) {
+            Entry first = current();
+            int count = first != null ? size : 0;
+            int generation = PropertyMapperRegistry.getGeneration();
+            Entry entry = new Entry(type, getter(type, property), setter(type, property), generation, first);
+            if (count < POLYMORPHIC_LIMIT) {
+                entries = entry;
+                size = count + 1;
+            }
+            return entry;
+        }
+    }
+
+    /**
+     * The sites of a property path, one per segment: reads follow every segment,
+     * writes follow all but the last and then set it
+     */
+    static final class PathSite {
+        private final Site[] segments;
+
+        PathSite(String[] path) {
+            segments = new Site[path.length];
+            for (int i = 0; i < path.length; i++) {
+                segments[i] = new Site(path[i]);
+            }
+        }
+
+        Object read(Object root) {
+            Object current = root;
+            for (int i = 0; i < segments.length && current != null; i++) {
+                current = segments[i].get(current);
+            }
+            return current;
+        }
+
+        void write(ASTExecutor executor, Object root, Object value, String variableName) {
+            if (root == null) {
+                executor.reportMissingObject(variableName);
+                return;
+            }
+
+            // Walk to the object that owns the last segment
+            Object obj = root;
+            for (int i = 0; i < segments.length - 1 && obj != null; i++) {
+                obj = segments[i].get(obj);
+            }
+            segments[segments.length - 1].set(executor, obj, value);
+        }
+    }
+
+    /**
+     * Create the sites for a program's property paths
+     * @return A PathSite at the index of every String[] constant
+     */
+    static Object[] pathSites(Object[] constants) {
+        Object[] sites = new Object[constants.length];
+        for (int i = 0; i < constants.length; i++) {
+            if (constants[i] instanceof String[]) {
+                sites[i] = new PathSite((String[]) constants[i]);
+            }
+        }
+        return sites;
+    }
+
+    private static Getter resolveGetter(Class<?> type, String property) {
+        // A snapshot answers with what was read from the event it stands in for
+        if (type == EventSnapshot.class) {
+            return obj -> ((EventSnapshot) obj).get(property);
+        }
+
+        Getter reflective = reflectiveGetter(type, property);
+        Function<Object, Object> mapped = PropertyMapperRegistry.findGetter(type, property);
+        if (mapped == null) {
+            return reflective;
+        }
+
+        // A mapper that yields null defers to reflection
+        return obj -> {
+            Object value = mapped.apply(obj);
+            return value != null ? value : reflective.get(obj);
+        };
+    }
+
+    private static Getter reflectiveGetter(Class<?> type, String property) {
+        try {
+            // Try to find a getter method first
+            String getterName = "get" + Character.toUpperCase(property.charAt(0)) + property.substring(1);
+            Method getter = null;
+
+            try {
+                getter = type.getMethod(getterName);
+            } catch (NoSuchMethodException e) {
+                // Try alternative getter for boolean properties
+                if (property.length() > 2 && property.startsWith("is")) {
+                    try {
+                        getter = type.getMethod(property);
+                    } catch (NoSuchMethodException e2) {
+                        // No getter found
+                    }
+                }
+            }
+
+            if (getter != null) {
+                return invoker(Accessors.getter(getter), property);
+            }
+
+            // If no getter, try direct field access
+            try {
+                return invoker(Accessors.getter(type.getField(property)), property);
+            } catch (NoSuchFieldException e) {
+                // No public field found
+            }
+
+            // Try declared fields (including private ones)
+            Field field = type.getDeclaredField(property);
+            field.setAccessible(true);
+            return invoker(Accessors.getter(field), property);
+
+        } catch (Exception e) {
+            String message = readError(property, type, e);
+            return obj -> {
+                System.out.println(message);
+                return null;
+            };
+        }
+    }
+
+    private static Getter invoker(Function<Object, Object> getter, String property) {
+        return obj -> {
+            try {
+                return getter.apply(obj);
+            } catch (Throwable e) {
+                System.out.println(readError(property, obj.getClass(), e));
+                return null;
+            }
+        };
+    }
+
+    private static String readError(String property, Class<?> type, Throwable e) {
+        return "Error accessing property '" + property + "' on object of type " + type.getName() + ": " + e.getMessage();
+    }
+
+    private static Setter resolveSetter(Class<?> type, String property) {
+        BiConsumer<Object, Object> mapped = PropertyMapperRegistry.findSetter(type, property);
+        if (mapped != null) {
+            return (executor, obj, value) -> mapped.accept(obj, value);
+        }
+
+        try {
+            // Setter methods are tried in order; each takes the value if it converts
+            String setterName = "set" + Character.toUpperCase(property.charAt(0)) + property.substring(1);
+            List<Class<?>> parameterTypes = new ArrayList<>();
+            List<BiConsumer<Object, Object>> setters = new ArrayList<>();
+            for (Method method : type.getMethods()) {
+                if (method.getName().equals(setterName) && method.getParameterCount() == 1) {
+                    parameterTypes.add(method.getParameterTypes()[0]);
+                    setters.add(setter(method));
+                }
+            }
+
+            // Then a public field, then a declared one
+            Class<?> fieldType = null;
+            BiConsumer<Object, Object> fieldSetter = null;
+            String fieldError = null;
+            try {
+                Field field;
+                try {
+                    field = type.getField(property);
+                } catch (NoSuchFieldException e) {
+                    field = type.getDeclaredField(property);
+                    field.setAccessible(true);
+                }
+                fieldType = field.getType();
+                fieldSetter = Accessors.setter(field);
+            } catch (Exception e) {
+                fieldError = e.getMessage();
+            }
+
+            @SuppressWarnings("unchecked")
+            BiConsumer<Object, Object>[] setterArray = setters.toArray(new BiConsumer[0]);
+            return reflectiveSetter(property, parameterTypes.toArray(new Class<?>[0]), setterArray,
+                    fieldType, fieldSetter, fieldError);
+        } catch (Exception e) {
+            String message = e.getMessage();
+            return (executor, obj, value) -> System.err.println(writeError(property, obj, message));
+        }
+    }
+
+    private static Setter reflectiveSetter(String property, Class<?>[] parameterTypes, BiConsumer<Object, Object>[] setters,
+                                           Class<?> fieldType, BiConsumer<Object, Object> fieldSetter, String fieldError) {
+        return (executor, obj, value) -> {
+            try {
+                for (int i = 0; i < setters.length; i++) {
+                    // Convert the value to the expected type if needed
+                    Object convertedValue = executor.convertValue(value, parameterTypes[i]);
+                    if (convertedValue != null || parameterTypes[i].isPrimitive()) {
+                        setters[i].accept(obj, convertedValue);
+                        return;
+                    }
+                }
+
+                if (fieldSetter == null) {
+                    System.err.println(writeError(property, obj, fieldError));
+                    return;
+                }
+                fieldSetter.accept(obj, executor.convertValue(value, fieldType));
+            } catch (Throwable e) {
+                System.err.println(writeError(property, obj, e.getMessage()));
+            }
+        };
+    }
+
+    /**
+     * A caller for a setter, or one that throws why it cannot be called
+     */
+    private static BiConsumer<Object, Object> setter(Method method) {
+        try {
+            return Accessors.setter(method);
+        } catch (IllegalAccessException e) {
+            return (obj, value) -> {
+                throw new IllegalStateException(e.getMessage(), e);
+            };
+        }
+    }
+
+    private static String writeError(String property, Object obj, String message) {
+        return "Error setting property '" + property + "' on object of type " + obj.getClass().getName() + ": " + message;
+    }
+}
@@ -0,0 +1,413 @@
+package net.swofty;
+
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Objects;
+
+import net.swofty.nativebridge.CompiledHandler;
+import net.swofty.nativebridge.execution.BlockStatement;
+import net.swofty.nativebridge.execution.Expression;
+import net.swofty.nativebridge.execution.Statement;
+import net.swofty.nativebridge.execution.commands.CancelEventStatement;
+import net.swofty.nativebridge.execution.commands.HaltCommand;
+import net.swofty.nativebridge.execution.commands.IfStatement;
+import net.swofty.nativebridge.execution.commands.SendCommand;
+import net.swofty.nativebridge.execution.commands.SwitchStatement;
+import net.swofty.nativebridge.execution.commands.TeleportCommand;
+import net.swofty.nativebridge.execution.commands.VariableAssignment;
+import net.swofty.nativebridge.execution.expressions.BinaryExpression;
+import net.swofty.nativebridge.execution.expressions.BooleanLiteral;
+import net.swofty.nativebridge.execution.expressions.Concat;
+import net.swofty.nativebridge.execution.expressions.InterpolatedString;
+import net.swofty.nativebridge.execution.expressions.StringLiteral;
+import net.swofty.nativebridge.execution.expressions.TypeLiteral;
+import net.swofty.nativebridge.execution.expressions.VariableReference;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+
+/**
+ * Links the statement tree of an execute block into a tree of closures, once per
+ * block. Each closure holds its linked children and the operation its operator
+ * resolved to, so running a block does no instanceof or operator dispatch. Every block
+ * runs this way unless -Dswoftlang.executor selects a compiled executor, and blocks the
+ * native compiler cannot express always do. The semantics are those of the ASTExecutor methods the
+ * closures call; property accesses go through their own PropertyAccess sites.
+ */
+final class TreeLinker {
+    @FunctionalInterface
+    interface Action {
+        void run(ASTExecutor executor, Object[] frame);
+    }
+
+    @FunctionalInterface
+    interface Node {
+        Object eval(ASTExecutor executor, Object[] frame);
+    }
+
+    @FunctionalInterface
+    interface Condition {
+        boolean test(ASTExecutor executor, Object[] frame);
+    }
+
+    @FunctionalInterface
+    private interface Comparison {
+        boolean test(ASTExecutor executor, Object left, Object right);
+    }
+
+    private static final Action NOTHING = (executor, frame) -> {
+    };
+
+    private final boolean haltable; // false when the parser proved the block never halts
+
+    private TreeLinker(boolean haltable) {
+        this.haltable = haltable;
+    }
+
+    /**
+     * Get the linked form of a block, linking it on first use
+     */
+    static CompiledHandler get(ExecuteBlock block) {
+        CompiledHandler handler = block.getTreeHandler();
+        if (handler == null) {
+            // Threads that race here link equivalent trees; either may be kept
+            Action body = new TreeLinker(block.canHalt()).sequence(block.getStatements());
+            handler = (executor, frame) -> body.run((ASTExecutor) executor, frame);
+            block.setTreeHandler(handler);
+        }
+        return handler;
+    }
+
+    /**
+     * Run statements in order, stopping after a halt
+     */
+    private Action sequence(List<Statement> statements) {
+        Action[] actions = new Action[statements.size()];
+        for (int i = 0; i < actions.length; i++) {
+            actions[i] = statement(statements.get(i));
+        }
+
+        if (!haltable) {
+            if (actions.length == 1) {
+                return actions[0];
+            }
+            return (executor, frame) -> {
+                for (Action action : actions) {
+                    action.run(executor, frame);
+                }
+            };
+        }
+
+        return (executor, frame) -> {
+            for (Action action : actions) {
+                if (executor.isHalted()) {
+                    return;
+                }
+                action.run(executor, frame);
+            }
+        };
+    }
+
+    private Action statement(Statement statement) {
+        if (statement instanceof SendCommand) {
+            return send((SendCommand) statement);
+        } else if (statement instanceof TeleportCommand) {
+            TeleportCommand command = (TeleportCommand) statement;
+            Node entity = expression(command.getEntity());
+            Node target = expression(command.getTarget());
+            return (executor, frame) -> executor.teleport(entity.eval(executor, frame), target.eval(executor, frame));
+        } else if (statement instanceof HaltCommand) {
+            return (executor, frame) -> executor.halt();
+        } else if (statement instanceof IfStatement) {
+            return ifStatement((IfStatement) statement);
+        } else if (statement instanceof SwitchStatement) {
+            return switchStatement((SwitchStatement) statement);
+        } else if (statement instanceof BlockStatement) {
+            return sequence(((BlockStatement) statement).getStatements());
+        } else if (statement instanceof VariableAssignment) {
+            return assignment((VariableAssignment) statement);
+        } else if (statement instanceof CancelEventStatement) {
+            return (executor, frame) -> executor.executeCancelEventStatement();
+        }
+        return NOTHING;
+    }
+
+    private Action send(SendCommand command) {
+        Node message = message(command.getMessage());
+        if (command.getTarget() == null) {
+            return (executor, frame) -> executor.sendMessage((String) message.eval(executor, frame), executor.getSender());
+        }
+
+        Node target = expression(command.getTarget());
+        return (executor, frame) -> {
+            String text = (String) message.eval(executor, frame);
+            executor.sendMessage(text, target.eval(executor, frame));
+        };
+    }
+
+    private Action ifStatement(IfStatement statement) {
+        Condition condition = condition(statement.getCondition());
+        Action then = statement(statement.getThenStatement());
+        if (statement.getElseStatement() == null) {
+            return (executor, frame) -> {
+                if (condition.test(executor, frame)) {
+                    then.run(executor, frame);
+                }
+            };
+        }
+
+        Action otherwise = statement(statement.getElseStatement());
+        return (executor, frame) -> {
+            if (condition.test(executor, frame)) {
+                then.run(executor, frame);
+            } else {
+                otherwise.run(executor, frame);
+            }
+        };
+    }
+
+    /**
+     * One lookup in place of a test per else-if link
+     */
+    private Action switchStatement(SwitchStatement statement) {
+        Node subject = expression(statement.getSubject());
+        Map<String, Action> cases = new HashMap<>(statement.getCases().size() * 2);
+        statement.getCases().forEach((label, branch) -> {
+            if (branch != null) {
+                cases.put(label, statement(branch));
+            }
+        });
+        Action defaultAction = statement(statement.getDefaultStatement());
+
+        return (executor, frame) -> {
+            Object value = subject.eval(executor, frame);
+            Action branch = value instanceof String ? cases.get(value) : null;
+            (branch != null ? branch : defaultAction).run(executor, frame);
+        };
+    }
+
+    private Action assignment(VariableAssignment assignment) {
+        Node value = expression(assignment.getValue());
+        String variableName = assignment.getVariableName();
+        int slot = assignment.getSlot();
+
+        if (slot < 0) {
+            return (executor, frame) -> executor.assignVariable(variableName, value.eval(executor, frame));
+        }
+
+        String[] path = assignment.getPath();
+        if (path.length == 0) {
+            return (executor, frame) -> frame[slot] = value.eval(executor, frame);
+        }
+        PropertyAccess.PathSite site = new PropertyAccess.PathSite(path);
+        return (executor, frame) -> {
+            Object result = value.eval(executor, frame);
+            site.write(executor, frame[slot], result, variableName);
+        };
+    }
+
+    private Node expression(Expression expression) {
+        if (expression instanceof StringLiteral) {
+            String value = ((StringLiteral) expression).getValue();
+            return (executor, frame) -> value;
+        } else if (expression instanceof InterpolatedString) {
+            InterpolatedString string = (InterpolatedString) expression;
+            return render(string.getParts(), string.getLiteralLength(), false, true);
+        } else if (expression instanceof Concat) {
+            Concat concat = (Concat) expression;
+            return render(concat.getParts(), concat.getLiteralLength(), false, false);
+        } else if (expression instanceof BooleanLiteral) {
+            Boolean value = ((BooleanLiteral) expression).getValue();
+            return (executor, frame) -> value;
+        } else if (expression instanceof VariableReference) {
+            return variable((VariableReference) expression);
+        } else if (expression instanceof BinaryExpression) {
+            return binary((BinaryExpression) expression);
+        } else if (expression instanceof TypeLiteral) {
+            String typeName = ((TypeLiteral) expression).getTypeName();
+            return (executor, frame) -> typeName;
+        }
+
+        // Fails when evaluated, not when linked, as the tree walker did
+        String message = "Unknown expression type: " + expression.getClass().getSimpleName();
+        return (executor, frame) -> {
+            throw new RuntimeException(message);
+        };
+    }
+
+    private Node variable(VariableReference reference) {
+        int slot = reference.getSlot();
+        if (slot < 0) {
+            String name = reference.getName();
+            return (executor, frame) -> executor.getVariable(name);
+        }
+
+        String[] path = reference.getPath();
+        if (path.length == 0) {
+            return (executor, frame) -> frame[slot];
+        }
+        if (path.length == 1) {
+            PropertyAccess.Site site = new PropertyAccess.Site(path[0]);
+            return (executor, frame) -> site.get(frame[slot]);
+        }
+        PropertyAccess.PathSite site = new PropertyAccess.PathSite(path);
+        return (executor, frame) -> site.read(frame[slot]);
+    }
+
+    private Node binary(BinaryExpression expression) {
+        if (expression.getOperator() == BinaryExpression.Operator.CONCATENATE) {
+            Node left = expression(expression.getLeft());
+            Node right = expression(expression.getRight());
+            return (executor, frame) -> executor.applyOperator(BinaryExpression.Operator.CONCATENATE,
+                    left.eval(executor, frame), right.eval(executor, frame));
+        }
+
+        Condition condition = condition(expression);
+        return (executor, frame) -> condition.test(executor, frame);
+    }
+
+    /**
+     * Link an expression used for its truth value, without boxing comparison results
+     */
+    private Condition condition(Expression expression) {
+        if (expression instanceof BinaryExpression) {
+            BinaryExpression binary = (BinaryExpression) expression;
+            BinaryExpression.Operator operator = binary.getOperator();
+
+            // Short-circuit: the right operand only runs if the left one does not decide
+            if (operator == BinaryExpression.Operator.AND) {
+                Condition left = condition(binary.getLeft());
+                Condition right = condition(binary.getRight());
+                return (executor, frame) -> left.test(executor, frame) && right.test(executor, frame);
+            }
+            if (operator == BinaryExpression.Operator.OR) {
+                Condition left = condition(binary.getLeft());
+                Condition right = condition(binary.getRight());
+                return (executor, frame) -> left.test(executor, frame) || right.test(executor, frame);
+            }
+
+            // A literal needle is lowered once, here
+            if (operator == BinaryExpression.Operator.CONTAINS && binary.getRight() instanceof StringLiteral) {
+                Node left = expression(binary.getLeft());
+                FoldedNeedle needle = new FoldedNeedle(((StringLiteral) binary.getRight()).getValue());
+                return (executor, frame) -> executor.contains(left.eval(executor, frame), needle);
+            }
+
+            Comparison comparison = comparison(operator);
+            if (comparison != null) {
+                Node left = expression(binary.getLeft());
+                Node right = expression(binary.getRight());
+                return (executor, frame) -> comparison.test(executor, left.eval(executor, frame), right.eval(executor, frame));
+            }
+        } else if (expression instanceof BooleanLiteral) {
+            boolean value = ((BooleanLiteral) expression).getValue();
+            return (executor, frame) -> value;
+        }
+
+        Node node = expression(expression);
+        return (executor, frame) -> executor.toBoolean(node.eval(executor, frame));
+    }
+
+    /**
+     * Resolve a boolean operator to its implementation (see ASTExecutor.applyOperator)
+     * @return The comparison, or null for AND, OR and CONCATENATE
+     */
+    private static Comparison comparison(BinaryExpression.Operator operator) {
+        switch (operator) {
+            case EQUALS:
+                return (executor, left, right) -> executor.objectsEqual(left, right);
+            case NOT_EQUALS:
+                return (executor, left, right) -> !executor.objectsEqual(left, right);
+            case LESS_THAN:
+                return (executor, left, right) -> executor.compareObjects(left, right) < 0;
+            case GREATER_THAN:
+                return (executor, left, right) -> executor.compareObjects(left, right) > 0;
+            case LESS_EQUALS:
+                return (executor, left, right) -> executor.compareObjects(left, right) <= 0;
+            case GREATER_EQUALS:
+                return (executor, left, right) -> executor.compareObjects(left, right) >= 0;
+            case STRING_EQUALS:
+                return (executor, left, right) -> Objects.equals(left, right);
+            case STRING_NOT_EQUALS:
+                return (executor, left, right) -> !Objects.equals(left, right);
+            case NUMBER_EQUALS:
+                return (executor, left, right) -> executor.numbersEqual(left, right);
+            case NUMBER_NOT_EQUALS:
+                return (executor, left, right) -> !executor.numbersEqual(left, right);
+            case NUMBER_LESS_THAN:
+                return (executor, left, right) -> executor.compareNumbers(left, right) < 0;
+            case NUMBER_GREATER_THAN:
+                return (executor, left, right) -> executor.compareNumbers(left, right) > 0;
+            case NUMBER_LESS_EQUALS:
+                return (executor, left, right) -> executor.compareNumbers(left, right) <= 0;
+            case NUMBER_GREATER_EQUALS:
+                return (executor, left, right) -> executor.compareNumbers(left, right) >= 0;
+            case IDENTITY_EQUALS:
+                return (executor, left, right) -> left == right;
+            case IDENTITY_NOT_EQUALS:
+                return (executor, left, right) -> left != right;
+            case IS_TYPE:
+                return (executor, left, right) -> executor.isType(left, (String) right);
+            case IS_NOT_TYPE:
+                return (executor, left, right) -> !executor.isType(left, (String) right);
+            case CONTAINS:
+                return (executor, left, right) -> (Boolean) executor.applyOperator(BinaryExpression.Operator.CONTAINS, left, right);
+            default:
+                return null;
+        }
+    }
+
+    /**
+     * Render the message of a send. The native parser has already translated color tags
+     * in its literal text, so only values inserted at runtime are translated here.
+     */
+    private Node message(Expression message) {
+        if (message instanceof StringLiteral) {
+            return expression(message);
+        } else if (message instanceof InterpolatedString) {
+            InterpolatedString string = (InterpolatedString) message;
+            return render(string.getParts(), string.getLiteralLength(), true, true);
+        } else if (message instanceof Concat) {
+            Concat concat = (Concat) message;
+            return render(concat.getParts(), concat.getLiteralLength(), true, false);
+        }
+
+        Node value = expression(message);
+        return (executor, frame) -> BytecodeInterpreter.toMessage(value.eval(executor, frame));
+    }
+
+    /**
+     * Render string parts: an interpolated string leaves out null values, a
+     * concatenation chain prints them as "null", as with a single '+'
+     */
+    private Node render(Expression[] parts, int literalLength, boolean translateValues, boolean skipNull) {
+        String[] literals = new String[parts.length];
+        Node[] values = new Node[parts.length];
+        for (int i = 0; i < parts.length; i++) {
+            if (parts[i] instanceof StringLiteral) {
+                literals[i] = ((StringLiteral) parts[i]).getValue();
+            } else {
+                values[i] = expression(parts[i]);
+            }
+        }
+        // Leave some room for the substituted values on top of the literal text
+        int capacity = literalLength + 16 * parts.length;
+
+        return (executor, frame) -> {
+            StringBuilder result = new StringBuilder(capacity);
+            for (int i = 0; i < values.length; i++) {
+                if (values[i] == null) {
+                    result.append(literals[i]);
+                    continue;
+                }
+
+                Object value = values[i].eval(executor, frame);
+                if (value == null && skipNull) {
+                    continue;
+                }
+                String text = executor.getDisplayString(value);
+                result.append(translateValues ? ColorCodes.translate(text) : text);
+            }
+            return result.toString();
+        };
+    }
+}
@@ -1,7 +1,6 @@
 package net.swofty.command;
 
 import net.minestom.server.MinecraftServer;
-import net.minestom.server.command.CommandSender;
 import net.minestom.server.command.builder.Command;
 import net.minestom.server.command.builder.arguments.Argument;
 import net.minestom.server.command.builder.arguments.ArgumentBoolean;
@@ -18,7 +17,6 @@ import net.swofty.ASTExecutor;
 import net.swofty.nativebridge.representation.*;
 
 import java.util.ArrayList;
-import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 
@@ -411,7 +409,7 @@ public class MinestomCommandRegistrar {
                                 net.minestom.server.command.CommandSender sender,
                                 CommandContext context) {
 
-        Map<String, Object> argValues = new HashMap<>();
+        ASTExecutor executor = ASTExecutor.acquire(MinestomSenderAdapter.of(sender));
 
         // Process each argument
         for (Variable arg : swoftCommand.getArguments()) {
@@ -425,12 +423,18 @@ public class MinestomCommandRegistrar {
 
                 if (x != null && y != null && z != null) {
                     Pos position = new Pos(x, y, z);
-                    argValues.put(arg.getName(), position);
+                    executor.bind(arg.getName(), position);
                 }
             } else {
                 // Standard argument
                 Object value = context.get(arg.getName());
 
+                // Player arguments arrive as entity selectors; scripts see the player, as
+                // with either<Player|...> arguments and the native type checker assumes
+                if (value instanceof EntityFinder && type == BaseType.PLAYER) {
+                    value = ((EntityFinder) value).findFirstPlayer(sender);
+                }
+
                 // Special handling for player "sender" default
                 if (value == null && arg.hasDefault() && arg.getDefaultValue().equals("sender") &&
                         type == BaseType.PLAYER && sender instanceof Player) {
@@ -438,12 +442,12 @@ public class MinestomCommandRegistrar {
                     value = sender;
                 }
 
-                argValues.put(arg.getName(), value);
+                executor.bind(arg.getName(), value);
             }
         }
 
         // Execute the command using our new architecture
-        executeSwoftCommand(swoftCommand, sender, argValues);
+        executeSwoftCommand(swoftCommand, sender, executor);
     }
 
     /**
@@ -454,7 +458,7 @@ public class MinestomCommandRegistrar {
                                             CommandContext context,
                                             List<ArgumentVariant> variants) {
 
-        Map<String, Object> argValues = new HashMap<>();
+        ASTExecutor executor = ASTExecutor.acquire(MinestomSenderAdapter.of(sender));
 
         // Process each argument variant
         for (ArgumentVariant variant : variants) {
@@ -469,7 +473,7 @@ public class MinestomCommandRegistrar {
 
                 if (x != null && y != null && z != null) {
                     Pos position = new Pos(x, y, z);
-                    argValues.put(name, position);
+                    executor.bind(name, position);
                 }
             } else if (type == BaseType.PLAYER) {
                 // Handle player entity
@@ -477,40 +481,39 @@ public class MinestomCommandRegistrar {
                 if (finder != null) {
                     Player player = finder.findFirstPlayer(sender);
                     if (player != null) {
-                        argValues.put(name, player);
+                        executor.bind(name, player);
                     }
                 }
             } else {
                 // Standard argument
                 Object value = context.get(name);
-                argValues.put(name, value);
+                executor.bind(name, value);
             }
         }
 
         // Execute the command using our new architecture
-        executeSwoftCommand(swoftCommand, sender, argValues);
+        executeSwoftCommand(swoftCommand, sender, executor);
     }
 
     /**
      * Execute the SwoftLang command using the pre-parsed AST
+     * @param executor A pooled executor with the arguments bound; it is released here
      */
     private void executeSwoftCommand(net.swofty.nativebridge.representation.Command swoftCommand,
                                      net.minestom.server.command.CommandSender minestomSender,
-                                     Map<String, Object> argValues) {
+                                     ASTExecutor executor) {
         try {
             // Get the execute block (now pre-parsed AST)
             ExecuteBlock executeBlock = swoftCommand.getExecuteBlock();
 
-            // Adapt the Minestom sender to our CommandSender interface
-            CommandSender sender = new MinestomSenderAdapter(minestomSender);
-
-            // Create and run the AST executor
-            ASTExecutor executor = new ASTExecutor(sender, argValues);
+            // Run the AST executor
             executor.execute(executeBlock);
 
         } catch (Exception e) {
             minestomSender.sendMessage("Error executing command: " + e.getMessage());
             e.printStackTrace();
+        } finally {
+            executor.release();
         }
     }
 }
\ No newline at end of file
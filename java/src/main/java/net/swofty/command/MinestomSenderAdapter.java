@@ -3,6 +3,7 @@ package net.swofty.command;
 import net.kyori.adventure.identity.Identity;
 import net.minestom.server.command.CommandSender;
 import net.minestom.server.entity.Player;
+import net.minestom.server.tag.Tag;
 import net.minestom.server.tag.TagHandler;
 import org.jetbrains.annotations.NotNull;
 
@@ -10,12 +11,29 @@ import org.jetbrains.annotations.NotNull;
  * Adapter that wraps a Minestom CommandSender for use with SwoftLang
  */
 public class MinestomSenderAdapter implements CommandSender {
+    // The adapter of a sender is kept on the sender, so each command does not create one
+    private static final Tag<MinestomSenderAdapter> ADAPTER = Tag.Transient("swoftlang:sender-adapter");
+
     private final net.minestom.server.command.CommandSender minestomSender;
 
     public MinestomSenderAdapter(net.minestom.server.command.CommandSender minestomSender) {
         this.minestomSender = minestomSender;
     }
 
+    /**
+     * Get the adapter of a Minestom sender, creating it on first use
+     * @param minestomSender The sender to wrap
+     * @return The same adapter every time for the same sender
+     */
+    public static MinestomSenderAdapter of(net.minestom.server.command.CommandSender minestomSender) {
+        MinestomSenderAdapter adapter = minestomSender.getTag(ADAPTER);
+        if (adapter == null) {
+            adapter = new MinestomSenderAdapter(minestomSender);
+            minestomSender.setTag(ADAPTER, adapter);
+        }
+        return adapter;
+    }
+
     @Override
     public void sendMessage(String message) {
         minestomSender.sendMessage(message);
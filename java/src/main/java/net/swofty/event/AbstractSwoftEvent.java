@@ -1,11 +1,14 @@
 package net.swofty.event;
 
-import java.util.HashMap;
-import java.util.Map;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.Set;
 
+import net.minestom.server.MinecraftServer;
 import net.minestom.server.command.CommandSender;
 import net.minestom.server.event.trait.CancellableEvent;
 import net.swofty.ASTExecutor;
+import net.swofty.EventSnapshot;
 import net.swofty.nativebridge.representation.Event;
 import net.swofty.nativebridge.representation.ExecuteBlock;
 
@@ -16,6 +19,7 @@ public abstract class AbstractSwoftEvent<T extends net.minestom.server.event.Eve
     protected final T minestomEvent;
     protected final Event swoftEvent;
     protected boolean cancelled = false;
+    private Set<String> accessed = Collections.emptySet();
 
     public AbstractSwoftEvent(T minestomEvent, Event swoftEvent) {
         this.minestomEvent = minestomEvent;
@@ -26,44 +30,143 @@ public abstract class AbstractSwoftEvent<T extends net.minestom.server.event.Eve
      * Execute the SwoftLang event code
      */
     public boolean execute() {
-        ExecuteBlock executeBlock = swoftEvent.getExecuteBlock();
-        if (executeBlock == null) {
+        if (swoftEvent.getExecuteBlock() == null) {
             return false;
         }
+        Event[] handlers = {swoftEvent};
+        return execute(handlers, accessedNames(handlers), false);
+    }
+
+    /**
+     * Execute the code of several handlers of this event in order. They share this
+     * wrapper and one executor, so the variables are bound once.
+     * @param handlers The script events to run
+     * @param accessed The names the handlers use, from accessedNames
+     * @param stopWhenCancelled Whether to skip the remaining handlers once the event is cancelled
+     * @return Whether the event was cancelled
+     */
+    public boolean execute(Event[] handlers, Set<String> accessed, boolean stopWhenCancelled) {
+        this.accessed = accessed;
 
-        // Create the variables map for the executor
-        Map<String, Object> variables = createVariablesMap();
-        
-        // Execute the code with the enhanced ASTExecutor
-        ASTExecutor executor = new ASTExecutor(getSender(), variables);
-        executor.execute(executeBlock);
+        // Execute the code with a pooled executor
+        ASTExecutor executor = ASTExecutor.acquire(getSender());
+        try {
+            bindVariables(executor);
+            for (Event handler : handlers) {
+                ExecuteBlock executeBlock = handler.getExecuteBlock();
+                if (executeBlock == null) {
+                    continue;
+                }
+
+                try {
+                    executor.execute(executeBlock);
+                } catch (Exception e) {
+                    // A failing handler does not keep the others from running
+                    MinecraftServer.getExceptionManager().handleException(e);
+                }
+
+                if (stopWhenCancelled && isCancelled()) {
+                    break;
+                }
+            }
+        } finally {
+            executor.release();
+        }
 
         return cancelled;
     }
 
     /**
-     * Create the variables map for the executor
+     * Prepare read-only handlers to run on another thread once this event's listener has
+     * returned. What they take from the event - the variables and the event properties
+     * they read - is read now, on the event thread, so they see the event as it was here
+     * and not as later listeners or the server leave it. They cannot cancel the event or
+     * change it, so the run does not look at it again.
+     * @param handlers The script events to run; none may change anything
+     * @param accessed The names the handlers use, from accessedNames
+     * @param eventReads The event properties the handlers read, from eventReads
+     * @return The run, to pass to the other thread
+     */
+    public Runnable detach(Event[] handlers, Set<String> accessed, Set<String> eventReads) {
+        this.accessed = accessed;
+
+        // Not pooled: it is filled here and used by the thread the run is handed to
+        ASTExecutor executor = new ASTExecutor(getSender(), null);
+        executor.bind("event", EventSnapshot.of(this, eventReads));
+        addCustomVariables(executor);
+
+        return () -> {
+            for (Event handler : handlers) {
+                ExecuteBlock executeBlock = handler.getExecuteBlock();
+                if (executeBlock == null) {
+                    continue;
+                }
+                try {
+                    executor.execute(executeBlock);
+                } catch (Exception e) {
+                    MinecraftServer.getExceptionManager().handleException(e);
+                }
+            }
+        };
+    }
+
+    /**
+     * Get the event properties some handler reads
+     */
+    public static Set<String> eventReads(Event[] handlers) {
+        Set<String> names = new HashSet<>();
+        for (Event handler : handlers) {
+            ExecuteBlock executeBlock = handler.getExecuteBlock();
+            if (executeBlock != null) {
+                Collections.addAll(names, executeBlock.getEventReads());
+            }
+        }
+        return names;
+    }
+
+    /**
+     * Get every name some handler takes from its host: the variables its frame is filled
+     * from and the event properties it reads or writes, as the native resolver found them.
+     * A wrapper only has to provide these.
+     */
+    public static Set<String> accessedNames(Event[] handlers) {
+        Set<String> names = new HashSet<>();
+        for (Event handler : handlers) {
+            ExecuteBlock executeBlock = handler.getExecuteBlock();
+            if (executeBlock != null) {
+                Collections.addAll(names, executeBlock.getSlotNames());
+                Collections.addAll(names, executeBlock.getEventReads());
+                Collections.addAll(names, executeBlock.getEventWrites());
+            }
+        }
+        return names;
+    }
+
+    /**
+     * Check if a handler being run uses a variable or event property. Wrappers only
+     * compute what is used.
+     */
+    protected boolean isAccessed(String name) {
+        return accessed.contains(name);
+    }
+
+    /**
+     * Set the variables the executor starts with
      */
-    protected Map<String, Object> createVariablesMap() {
-        Map<String, Object> variables = new HashMap<>();
-        
-        // Add the event object itself
-        variables.put("event", this);
-        
-        // Add sender
-        variables.put("sender", getSender());
-        
+    protected void bindVariables(ASTExecutor executor) {
+        // Add the event object itself; the sender is already bound
+        executor.bind("event", this);
+
         // Add any custom variables
-        addCustomVariables(variables);
-        
-        return variables;
+        addCustomVariables(executor);
     }
     
     /**
-     * Add custom variables to the map
-     * Override in subclasses to add event-specific variables
+     * Add custom variables to the executor
+     * Override in subclasses to add event-specific variables; skip those that are not
+     * accessed
      */
-    protected void addCustomVariables(Map<String, Object> variables) {
+    protected void addCustomVariables(ASTExecutor executor) {
         // Default implementation does nothing
         // Subclasses can override to add custom variables
     }
@@ -83,6 +186,13 @@ public abstract class AbstractSwoftEvent<T extends net.minestom.server.event.Eve
         }
     }
 
+    /**
+     * Check if a handler or another listener cancelled the event
+     */
+    public boolean isCancelled() {
+        return cancelled || (minestomEvent instanceof CancellableEvent && ((CancellableEvent) minestomEvent).isCancelled());
+    }
+
     /**
      * Get the Minestom event
      */
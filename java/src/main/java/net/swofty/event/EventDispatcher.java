@@ -0,0 +1,141 @@
+package net.swofty.event;
+
+import java.util.Arrays;
+import java.util.Set;
+
+import net.minestom.server.event.EventListener;
+import net.swofty.nativebridge.representation.Event;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+
+/**
+ * Runs every script handler of one event type from a single Minestom listener. Handlers
+ * are kept in priority order (lower numbers first, then in registration order) and run
+ * back to back against one wrapper and one executor, so the cost of an event does not
+ * grow with the number of listeners.
+ *
+ * With -Dswoftlang.events.async=true, the handlers after the last one that can change
+ * anything - those the native effect analysis found only read state and send messages -
+ * run on an OffTickExecutor lane instead of the event thread, once the others are done.
+ * The variables and event properties they use are read on the event thread before they
+ * are queued (AbstractSwoftEvent.detach), so they see the event as the handlers before
+ * them left it, whatever later listeners do to it.
+ *
+ * Objects among those values are not copied: a handler that reads through one, as in
+ * "event.player.position", reads the live object from the lane while the tick may be
+ * changing it, and can see a newer value than the event had. Handlers that need such
+ * values exactly as they were at the event should not be left read-only at the end.
+ *
+ * The async lane is unverified: OffTickSnapshotTest and EventDispatchBenchmark have not
+ * yet been run against it, so it stays off by default and its cost on the event thread
+ * is unmeasured.
+ */
+public class EventDispatcher {
+    // -Dswoftlang.events.ignoreCancelled=false keeps running handlers once the event is cancelled
+    private static final boolean IGNORE_CANCELLED =
+            !"false".equals(System.getProperty("swoftlang.events.ignoreCancelled"));
+    private static final boolean ASYNC = Boolean.getBoolean("swoftlang.events.async");
+
+    private final EventType.EventWrapperFactory factory;
+    private final boolean async;
+    // Both replaced together, never modified, so events can run during registration
+    private volatile Handlers handlers;
+
+    private static final class Handlers {
+        final Event[] events;
+        final Event[] onTick;         // run on the event thread
+        final Event[] offTick;        // the read-only handlers that follow them
+        final Set<String> accessed;   // what any of onTick uses, see AbstractSwoftEvent.accessedNames
+        final Set<String> offTickAccessed;
+        final Set<String> offTickReads; // the event properties offTick reads
+
+        Handlers(Event[] events, boolean async) {
+            int split = events.length;
+            while (async && split > 0 && isReadOnly(events[split - 1])) {
+                split--;
+            }
+            this.events = events;
+            this.onTick = Arrays.copyOfRange(events, 0, split);
+            this.offTick = Arrays.copyOfRange(events, split, events.length);
+            this.accessed = AbstractSwoftEvent.accessedNames(onTick);
+            this.offTickAccessed = AbstractSwoftEvent.accessedNames(offTick);
+            this.offTickReads = AbstractSwoftEvent.eventReads(offTick);
+        }
+
+        private static boolean isReadOnly(Event event) {
+            ExecuteBlock executeBlock = event.getExecuteBlock();
+            return executeBlock == null || executeBlock.isReadOnly();
+        }
+    }
+
+    public EventDispatcher(EventType eventType) {
+        this(eventType.getFactory(), ASYNC);
+    }
+
+    /**
+     * @param factory Creates the wrapper for each event
+     * @param async Whether trailing read-only handlers run off the event thread
+     */
+    EventDispatcher(EventType.EventWrapperFactory factory, boolean async) {
+        this.factory = factory;
+        this.async = async;
+        this.handlers = new Handlers(new Event[0], async);
+    }
+
+    /**
+     * Add a handler after every handler whose priority is not higher
+     * @param handler The script event to run
+     */
+    public synchronized void addHandler(Event handler) {
+        Event[] current = handlers.events;
+        int index = current.length;
+        while (index > 0 && current[index - 1].getPriority() > handler.getPriority()) {
+            index--;
+        }
+
+        Event[] updated = new Event[current.length + 1];
+        System.arraycopy(current, 0, updated, 0, index);
+        updated[index] = handler;
+        System.arraycopy(current, index, updated, index + 1, current.length - index);
+        handlers = new Handlers(updated, async);
+    }
+
+    /**
+     * Get the handlers in the order they run
+     */
+    public Event[] getHandlers() {
+        return handlers.events.clone();
+    }
+
+    /**
+     * Create the one listener this dispatcher needs
+     * @param eventClass The Minestom event class of this event type
+     */
+    public EventListener<net.minestom.server.event.Event> createListener(
+            Class<net.minestom.server.event.Event> eventClass) {
+        return EventListener.builder(eventClass)
+                .ignoreCancelled(IGNORE_CANCELLED)
+                .handler(this::dispatch)
+                .build();
+    }
+
+    /**
+     * Run every handler for one Minestom event
+     */
+    public void dispatch(net.minestom.server.event.Event minestomEvent) {
+        Handlers current = handlers;
+        if (current.events.length == 0) {
+            return;
+        }
+
+        // Use the event type factory to create the one wrapper all handlers share
+        AbstractSwoftEvent<?> wrapper = factory.create(minestomEvent, current.events[0]);
+        if (current.onTick.length > 0) {
+            wrapper.execute(current.onTick, current.accessed, IGNORE_CANCELLED);
+        }
+
+        if (current.offTick.length > 0 && !(IGNORE_CANCELLED && wrapper.isCancelled())) {
+            OffTickExecutor.submit(wrapper.getSender(),
+                    wrapper.detach(current.offTick, current.offTickAccessed, current.offTickReads));
+        }
+    }
+}
@@ -4,18 +4,20 @@ import java.util.Map;
 import java.util.concurrent.ConcurrentHashMap;
 
 import net.minestom.server.MinecraftServer;
-import net.minestom.server.event.EventListener;
 import net.minestom.server.event.EventNode;
 import net.swofty.nativebridge.representation.Event;
 public class EventRegistrar {
     private final EventNode<net.minestom.server.event.Event> rootNode;
-    private final Map<String, EventNode<?>> eventNodes = new ConcurrentHashMap<>();
+    private final Map<String, EventDispatcher> dispatchers = new ConcurrentHashMap<>();
 
     public EventRegistrar() {
         this.rootNode = MinecraftServer.getGlobalEventHandler();
     }
 
-    @SuppressWarnings("unchecked")
+    /**
+     * Add a script event to the dispatcher of its event type. The first script event of
+     * a type registers the one Minestom listener every later one shares.
+     */
     public void registerEvent(Event event) {
         String eventName = event.getName();
 
@@ -26,63 +28,43 @@ public class EventRegistrar {
             return;
         }
 
-        // Get the Minestom class name for this event
-        String minestomClassName = EventType.getMinestomClassName(eventName);
-        
-        // Get or create event node for this event type
-        EventNode<?> node = eventNodes.computeIfAbsent(eventName, name -> {
-            try {
-                // Load the Minestom event class
-                Class<?> minestomEventClass = Class.forName(minestomClassName);
-                System.out.println("Found Minestom event class: " + minestomEventClass.getName());
-                
-                // Create a node for this event type
-                EventNode<net.minestom.server.event.Event> eventNode = EventNode.all("swoftlang-" + name);
-                rootNode.addChild(eventNode);
-                return eventNode;
-            } catch (ClassNotFoundException e) {
-                System.err.println("Could not find Minestom event class: " + minestomClassName);
-                e.printStackTrace();
-                return null;
-            }
-        });
+        // Get or create the dispatcher for this event type
+        EventDispatcher dispatcher = dispatchers.computeIfAbsent(eventName, name -> createDispatcher(name, eventType));
+        if (dispatcher == null) return;
+
+        dispatcher.addHandler(event);
+        System.out.println("Successfully registered handler for event: " + eventName);
+    }
 
+    /**
+     * Get the dispatcher of an event type
+     * @return The dispatcher, or null if no script handles the event
+     */
+    public EventDispatcher getDispatcher(String eventName) {
+        return dispatchers.get(eventName);
+    }
 
-        if (node == null) return;
+    @SuppressWarnings("unchecked")
+    private EventDispatcher createDispatcher(String eventName, EventType eventType) {
+        // Get the Minestom class name for this event
+        String minestomClassName = EventType.getMinestomClassName(eventName);
 
         try {
             // Load the Minestom event class
-            Class<net.minestom.server.event.Event> eventClass = 
+            Class<net.minestom.server.event.Event> eventClass =
                 (Class<net.minestom.server.event.Event>) Class.forName(minestomClassName);
-                
-            // Create the listener
-            EventListener<net.minestom.server.event.Event> listener = 
-                EventListener.of(eventClass, minestomEvent -> {
-                    // Use the event type factory to create the appropriate wrapper
-                    AbstractSwoftEvent<?> wrapper = eventType.getFactory().create(minestomEvent, event);
-                    
-                    // Execute the SwoftLang event handler
-                    wrapper.execute();
-                });
-                
-            // Register the listener
-            ((EventNode<net.minestom.server.event.Event>) node).addListener(listener);
-            System.out.println("Successfully registered listener for event: " + eventName);
-        } catch (ClassNotFoundException e) {
-            System.err.println("Failed to create listener for event: " + eventName);
-            e.printStackTrace();
-        }
-    }
-
-    private Class<? extends net.minestom.server.event.Event> getEventClass(String eventName) {
-        try {
-            String className = eventName.startsWith("Player") ?
-                    "net.minestom.server.event.player." + eventName :
-                    "net.minestom.server.event.entity." + eventName;
+            System.out.println("Found Minestom event class: " + eventClass.getName());
 
-            return (Class<? extends net.minestom.server.event.Event>) Class.forName(className);
+            // Create a node for this event type, holding its one listener
+            EventDispatcher dispatcher = new EventDispatcher(eventType);
+            EventNode<net.minestom.server.event.Event> eventNode = EventNode.all("swoftlang-" + eventName);
+            eventNode.addListener(dispatcher.createListener(eventClass));
+            rootNode.addChild(eventNode);
+            return dispatcher;
         } catch (ClassNotFoundException e) {
-            throw new RuntimeException("Event class not found: " + eventName, e);
+            System.err.println("Could not find Minestom event class: " + minestomClassName);
+            e.printStackTrace();
+            return null;
         }
     }
-}
\ No newline at end of file
+}
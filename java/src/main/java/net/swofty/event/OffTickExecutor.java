@@ -0,0 +1,41 @@
+package net.swofty.event;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Runs read-only script handlers away from the event thread. Work is spread over a fixed
+ * set of single-thread lanes by a key, normally the player the event is about, so one
+ * player's handlers run one after the other in the order their events happened and the
+ * messages they send arrive in that order.
+ */
+final class OffTickExecutor {
+    private static final ExecutorService[] LANES = createLanes(Math.max(1, Runtime.getRuntime().availableProcessors() / 2));
+
+    private OffTickExecutor() {
+    }
+
+    private static ExecutorService[] createLanes(int count) {
+        AtomicInteger threads = new AtomicInteger();
+        ExecutorService[] lanes = new ExecutorService[count];
+        for (int i = 0; i < count; i++) {
+            lanes[i] = Executors.newSingleThreadExecutor(task -> {
+                Thread thread = new Thread(task, "swoftlang-handlers-" + threads.incrementAndGet());
+                thread.setDaemon(true);
+                return thread;
+            });
+        }
+        return lanes;
+    }
+
+    /**
+     * Queue a task behind every earlier task with the same key
+     * @param key Decides the lane; null shares one lane
+     * @param task The work to run
+     */
+    static void submit(Object key, Runnable task) {
+        int lane = key != null ? Math.floorMod(key.hashCode(), LANES.length) : 0;
+        LANES[lane].execute(task);
+    }
+}
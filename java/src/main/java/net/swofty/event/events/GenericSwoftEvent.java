@@ -1,13 +1,14 @@
 package net.swofty.event.events;
 
-import java.lang.reflect.Method;
-import java.util.Map;
+import java.util.function.Function;
 
 import net.minestom.server.MinecraftServer;
 import net.minestom.server.command.CommandSender;
 import net.minestom.server.entity.Player;
 import net.minestom.server.event.trait.PlayerEvent;
+import net.swofty.ASTExecutor;
 import net.swofty.event.AbstractSwoftEvent;
+import net.swofty.mapper.Accessors;
 import net.swofty.nativebridge.representation.Event;
 
 public class GenericSwoftEvent extends AbstractSwoftEvent<net.minestom.server.event.Event> {
@@ -19,15 +20,9 @@ public class GenericSwoftEvent extends AbstractSwoftEvent<net.minestom.server.ev
     public CommandSender getSender() {
         // Try to find a player associated with this event
         if (minestomEvent instanceof PlayerEvent) {
-            try {
-                // Use reflection to get the player
-                Method getPlayerMethod = minestomEvent.getClass().getMethod("getPlayer");
-                Object result = getPlayerMethod.invoke(minestomEvent);
-                if (result instanceof Player) {
-                    return (Player) result;
-                }
-            } catch (Exception e) {
-                // Ignore reflection errors
+            Object result = callGetter("getPlayer");
+            if (result instanceof Player) {
+                return (Player) result;
             }
         }
         
@@ -36,41 +31,58 @@ public class GenericSwoftEvent extends AbstractSwoftEvent<net.minestom.server.ev
     }
     
     @Override
-    protected void addCustomVariables(Map<String, Object> variables) {
+    protected void addCustomVariables(ASTExecutor executor) {
         // Add basic event information
-        variables.put("eventClass", minestomEvent.getClass().getSimpleName());
+        if (isAccessed("eventClass")) {
+            executor.bind("eventClass", minestomEvent.getClass().getSimpleName());
+        }
         
         // Try to extract common properties via reflection
-        extractPropertiesViaReflection(variables);
+        extractPropertiesViaReflection(executor);
     }
     
     /**
      * Extract properties from the Minestom event via reflection
      */
-    private void extractPropertiesViaReflection(Map<String, Object> variables) {
+    private void extractPropertiesViaReflection(ASTExecutor executor) {
         // Try common getter methods
-        tryGetterMethod(variables, "getPlayer", "player");
-        tryGetterMethod(variables, "getMessage", "message");
-        tryGetterMethod(variables, "getUsername", "username");
-        tryGetterMethod(variables, "getName", "name");
-        tryGetterMethod(variables, "getPosition", "position");
-        tryGetterMethod(variables, "getEntity", "entity");
-        tryGetterMethod(variables, "getBlock", "block");
-        tryGetterMethod(variables, "getItem", "item");
+        tryGetterMethod(executor, "getPlayer", "player");
+        tryGetterMethod(executor, "getMessage", "message");
+        tryGetterMethod(executor, "getUsername", "username");
+        tryGetterMethod(executor, "getName", "name");
+        tryGetterMethod(executor, "getPosition", "position");
+        tryGetterMethod(executor, "getEntity", "entity");
+        tryGetterMethod(executor, "getBlock", "block");
+        tryGetterMethod(executor, "getItem", "item");
     }
     
     /**
-     * Try to call a getter method and add the result to the variables map
+     * Try to call a getter method and bind the result as a variable, if a handler uses it
      */
-    private void tryGetterMethod(Map<String, Object> variables, String methodName, String variableName) {
+    private void tryGetterMethod(ASTExecutor executor, String methodName, String variableName) {
+        if (!isAccessed(variableName)) {
+            return;
+        }
+        Object result = callGetter(methodName);
+        if (result != null) {
+            executor.bind(variableName, result);
+        }
+    }
+
+    /**
+     * Call a getter of the Minestom event through a caller cached per event class
+     * @return The result, or null if the event has no such getter or it failed
+     */
+    private Object callGetter(String methodName) {
+        Function<Object, Object> getter = Accessors.method(minestomEvent.getClass(), methodName);
+        if (getter == null) {
+            return null;
+        }
         try {
-            Method method = minestomEvent.getClass().getMethod(methodName);
-            Object result = method.invoke(minestomEvent);
-            if (result != null) {
-                variables.put(variableName, result);
-            }
+            return getter.apply(minestomEvent);
         } catch (Exception e) {
             // Ignore reflection errors - this just means the event doesn't have this property
+            return null;
         }
     }
 }
\ No newline at end of file
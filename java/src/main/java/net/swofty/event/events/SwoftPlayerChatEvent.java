@@ -1,20 +1,18 @@
 package net.swofty.event.events;
 
-import java.util.Map;
-
 import net.kyori.adventure.text.Component;
 import net.minestom.server.command.CommandSender;
 import net.minestom.server.entity.Player;
 import net.minestom.server.event.player.PlayerChatEvent;
+import net.swofty.ASTExecutor;
 import net.swofty.event.AbstractSwoftEvent;
 import net.swofty.nativebridge.representation.Event;
 
 public class SwoftPlayerChatEvent extends AbstractSwoftEvent<PlayerChatEvent> {
-    private String message;
+    private String message; // read from the Minestom event on first use
 
     public SwoftPlayerChatEvent(PlayerChatEvent minestomEvent, Event swoftEvent) {
         super(minestomEvent, swoftEvent);
-        this.message = minestomEvent.getRawMessage();
     }
 
     @Override
@@ -23,9 +21,13 @@ public class SwoftPlayerChatEvent extends AbstractSwoftEvent<PlayerChatEvent> {
     }
     
     @Override
-    protected void addCustomVariables(Map<String, Object> variables) {
-        variables.put("player", minestomEvent.getPlayer());
-        variables.put("message", getMessage());
+    protected void addCustomVariables(ASTExecutor executor) {
+        if (isAccessed("player")) {
+            executor.bind("player", minestomEvent.getPlayer());
+        }
+        if (isAccessed("message")) {
+            executor.bind("message", getMessage());
+        }
     }
     
     // Getters and setters that will be accessed via reflection
@@ -35,6 +37,9 @@ public class SwoftPlayerChatEvent extends AbstractSwoftEvent<PlayerChatEvent> {
     }
     
     public String getMessage() {
+        if (message == null) {
+            message = minestomEvent.getRawMessage();
+        }
         return message;
     }
     
@@ -1,10 +1,9 @@
 package net.swofty.event.events;
 
-import java.util.Map;
-
 import net.minestom.server.command.CommandSender;
 import net.minestom.server.entity.Player;
 import net.minestom.server.event.player.PlayerSpawnEvent;
+import net.swofty.ASTExecutor;
 import net.swofty.event.AbstractSwoftEvent;
 import net.swofty.nativebridge.representation.Event;
 
@@ -19,9 +18,13 @@ public class SwoftPlayerJoinEvent extends AbstractSwoftEvent<PlayerSpawnEvent> {
     }
 
     @Override
-    protected void addCustomVariables(Map<String, Object> variables) {
-        variables.put("player", getPlayer());
-        variables.put("name", getPlayer().getUsername());
+    protected void addCustomVariables(ASTExecutor executor) {
+        if (isAccessed("player")) {
+            executor.bind("player", getPlayer());
+        }
+        if (isAccessed("name")) {
+            executor.bind("name", getName());
+        }
     }
     
     
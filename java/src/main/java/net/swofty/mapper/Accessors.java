@@ -0,0 +1,173 @@
+package net.swofty.mapper;
+
+import java.lang.invoke.LambdaMetafactory;
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.lang.reflect.Modifier;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.function.BiConsumer;
+import java.util.function.Consumer;
+import java.util.function.Function;
+
+/**
+ * Turns reflected getters, setters and fields into Function and BiConsumer instances
+ * that call them directly, in place of Method.invoke and Field.get. Instance methods
+ * get a class spun by LambdaMetafactory, which the JIT inlines through like any lambda.
+ * Fields and static methods, which LambdaMetafactory cannot bind with the receiver
+ * argument, go through a MethodHandle instead.
+ *
+ * Exceptions thrown by the member propagate unwrapped, checked ones included.
+ */
+public final class Accessors {
+    private static final MethodHandles.Lookup LOOKUP = MethodHandles.lookup();
+    private static final MethodType GETTER_TYPE = MethodType.methodType(Object.class, Object.class);
+    private static final MethodType SETTER_TYPE = MethodType.methodType(void.class, Object.class, Object.class);
+
+    // Stands in for a method a class does not have
+    private static final Function<Object, Object> MISSING = obj -> null;
+
+    private static final ClassValue<Map<String, Function<Object, Object>>> METHODS = new ClassValue<>() {
+        @Override
+        protected Map<String, Function<Object, Object>> computeValue(Class<?> type) {
+            return new ConcurrentHashMap<>();
+        }
+    };
+
+    private Accessors() {
+    }
+
+    /**
+     * Get a caller for a public no-argument method, cached per class and name. A void
+     * method's caller returns null.
+     * @param type The class to look the method up on, as Class.getMethod does
+     * @param name The method name
+     * @return The caller, or null if the class has no such method
+     */
+    public static Function<Object, Object> method(Class<?> type, String name) {
+        Map<String, Function<Object, Object>> methods = METHODS.get(type);
+        Function<Object, Object> caller = methods.get(name);
+        if (caller == null) {
+            caller = methods.computeIfAbsent(name, methodName -> {
+                try {
+                    return getter(type.getMethod(methodName));
+                } catch (NoSuchMethodException e) {
+                    return MISSING;
+                } catch (IllegalAccessException e) {
+                    // Fails like Method.invoke would, on each call
+                    return obj -> {
+                        throw Accessors.<RuntimeException>rethrow(e);
+                    };
+                }
+            });
+        }
+        return caller != MISSING ? caller : null;
+    }
+
+    /**
+     * Get a caller for a no-argument method
+     * @throws IllegalAccessException If this class cannot call the method
+     */
+    public static Function<Object, Object> getter(Method method) throws IllegalAccessException {
+        MethodHandle handle = LOOKUP.unreflect(method);
+        if (!Modifier.isStatic(method.getModifiers())) {
+            try {
+                if (method.getReturnType() == void.class) {
+                    Consumer<Object> consumer = (Consumer<Object>) LambdaMetafactory.metafactory(LOOKUP, "accept",
+                            MethodType.methodType(Consumer.class), MethodType.methodType(void.class, Object.class),
+                            handle, MethodType.methodType(void.class, method.getDeclaringClass()))
+                            .getTarget().invokeExact();
+                    return obj -> {
+                        consumer.accept(obj);
+                        return null;
+                    };
+                }
+
+                return (Function<Object, Object>) LambdaMetafactory.metafactory(LOOKUP, "apply",
+                        MethodType.methodType(Function.class), GETTER_TYPE, handle,
+                        MethodType.methodType(boxed(method.getReturnType()), method.getDeclaringClass()))
+                        .getTarget().invokeExact();
+            } catch (Throwable e) {
+                // Not expressible as a lambda; the handle still works
+            }
+        }
+        return getter(handle);
+    }
+
+    /**
+     * Get a caller for a one-argument method
+     * @throws IllegalAccessException If this class cannot call the method
+     */
+    public static BiConsumer<Object, Object> setter(Method method) throws IllegalAccessException {
+        MethodHandle handle = LOOKUP.unreflect(method);
+        if (!Modifier.isStatic(method.getModifiers())) {
+            try {
+                return (BiConsumer<Object, Object>) LambdaMetafactory.metafactory(LOOKUP, "accept",
+                        MethodType.methodType(BiConsumer.class), SETTER_TYPE, handle,
+                        MethodType.methodType(void.class, method.getDeclaringClass(), boxed(method.getParameterTypes()[0])))
+                        .getTarget().invokeExact();
+            } catch (Throwable e) {
+                // Not expressible as a lambda; the handle still works
+            }
+        }
+        return setter(handle);
+    }
+
+    /**
+     * Get a reader for a field; a field that is not public must have been made accessible
+     * @throws IllegalAccessException If this class cannot read the field
+     */
+    public static Function<Object, Object> getter(Field field) throws IllegalAccessException {
+        return getter(LOOKUP.unreflectGetter(field));
+    }
+
+    /**
+     * Get a writer for a field; a field that is not public must have been made accessible
+     * @throws IllegalAccessException If this class cannot write the field
+     */
+    public static BiConsumer<Object, Object> setter(Field field) throws IllegalAccessException {
+        return setter(LOOKUP.unreflectSetter(field));
+    }
+
+    private static Function<Object, Object> getter(MethodHandle handle) {
+        MethodHandle getter = receiverFirst(handle, 1).asType(GETTER_TYPE);
+        return obj -> {
+            try {
+                return (Object) getter.invokeExact(obj);
+            } catch (Throwable e) {
+                throw Accessors.<RuntimeException>rethrow(e);
+            }
+        };
+    }
+
+    private static BiConsumer<Object, Object> setter(MethodHandle handle) {
+        MethodHandle setter = receiverFirst(handle, 2).asType(SETTER_TYPE);
+        return (obj, value) -> {
+            try {
+                setter.invokeExact(obj, value);
+            } catch (Throwable e) {
+                throw Accessors.<RuntimeException>rethrow(e);
+            }
+        };
+    }
+
+    /**
+     * Give a static accessor the receiver argument an instance one takes; reflection
+     * ignores the receiver for statics as well
+     */
+    private static MethodHandle receiverFirst(MethodHandle handle, int arity) {
+        return handle.type().parameterCount() < arity ? MethodHandles.dropArguments(handle, 0, Object.class) : handle;
+    }
+
+    private static Class<?> boxed(Class<?> type) {
+        return type.isPrimitive() ? MethodType.methodType(type).wrap().returnType() : type;
+    }
+
+    @SuppressWarnings("unchecked")
+    private static <E extends Throwable> E rethrow(Throwable e) throws E {
+        throw (E) e;
+    }
+}
@@ -1,7 +1,8 @@
 package net.swofty.mapper;
 
-import java.util.HashMap;
+import java.util.Locale;
 import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.function.BiConsumer;
 import java.util.function.Function;
 
@@ -12,8 +13,9 @@ import java.util.function.Function;
  */
 public class PropertyMapper<T> {
     private final Class<T> targetClass;
-    private final Map<String, Function<T, Object>> getters = new HashMap<>();
-    private final Map<String, BiConsumer<T, Object>> setters = new HashMap<>();
+    // Keyed by normalized (lower-case) property name
+    private final Map<String, Function<T, Object>> getters = new ConcurrentHashMap<>();
+    private final Map<String, BiConsumer<T, Object>> setters = new ConcurrentHashMap<>();
 
     public PropertyMapper(Class<T> targetClass) {
         this.targetClass = targetClass;
@@ -26,7 +28,8 @@ public class PropertyMapper<T> {
      * @return This mapper for chaining
      */
     public PropertyMapper<T> registerGetter(String propertyName, Function<T, Object> getter) {
-        getters.put(propertyName.toLowerCase(), getter);
+        getters.put(normalize(propertyName), getter);
+        PropertyMapperRegistry.invalidate();
         return this;
     }
 
@@ -37,7 +40,8 @@ public class PropertyMapper<T> {
      * @return This mapper for chaining
      */
     public PropertyMapper<T> registerSetter(String propertyName, BiConsumer<T, Object> setter) {
-        setters.put(propertyName.toLowerCase(), setter);
+        setters.put(normalize(propertyName), setter);
+        PropertyMapperRegistry.invalidate();
         return this;
     }
 
@@ -62,7 +66,7 @@ public class PropertyMapper<T> {
      * @return True if a custom getter is registered
      */
     public boolean hasGetter(String propertyName) {
-        return getters.containsKey(propertyName.toLowerCase());
+        return getters.containsKey(normalize(propertyName));
     }
 
     /**
@@ -71,7 +75,41 @@ public class PropertyMapper<T> {
      * @return True if a custom setter is registered
      */
     public boolean hasSetter(String propertyName) {
-        return setters.containsKey(propertyName.toLowerCase());
+        return setters.containsKey(normalize(propertyName));
+    }
+
+    /**
+     * Get the custom getter for a property, to call without a lookup per access
+     * @param propertyName The name of the property
+     * @return The getter, or null if none is registered
+     */
+    public Function<T, Object> getGetter(String propertyName) {
+        return getters.get(normalize(propertyName));
+    }
+
+    /**
+     * Get the custom setter for a property, to call without a lookup per access
+     * @param propertyName The name of the property
+     * @return The setter, or null if none is registered
+     */
+    public BiConsumer<T, Object> getSetter(String propertyName) {
+        return setters.get(normalize(propertyName));
+    }
+
+    Function<T, Object> getNormalizedGetter(String normalizedName) {
+        return getters.get(normalizedName);
+    }
+
+    BiConsumer<T, Object> getNormalizedSetter(String normalizedName) {
+        return setters.get(normalizedName);
+    }
+
+    /**
+     * Normalize a property name the way mappers store it; property names match
+     * case-insensitively
+     */
+    static String normalize(String propertyName) {
+        return propertyName.toLowerCase(Locale.ROOT);
     }
 
     /**
@@ -82,13 +120,8 @@ public class PropertyMapper<T> {
      */
     @SuppressWarnings("unchecked")
     public Object getProperty(Object obj, String propertyName) {
-        if (!targetClass.isInstance(obj) || !hasGetter(propertyName)) {
-            return null;
-        }
-
-        T typedObj = (T) obj;
-        Function<T, Object> getter = getters.get(propertyName.toLowerCase());
-        return getter.apply(typedObj);
+        Function<T, Object> getter = targetClass.isInstance(obj) ? getGetter(propertyName) : null;
+        return getter != null ? getter.apply((T) obj) : null;
     }
 
     /**
@@ -100,13 +133,11 @@ public class PropertyMapper<T> {
      */
     @SuppressWarnings("unchecked")
     public boolean setProperty(Object obj, String propertyName, Object value) {
-        if (!targetClass.isInstance(obj) || !hasSetter(propertyName)) {
+        BiConsumer<T, Object> setter = targetClass.isInstance(obj) ? getSetter(propertyName) : null;
+        if (setter == null) {
             return false;
         }
-
-        T typedObj = (T) obj;
-        BiConsumer<T, Object> setter = setters.get(propertyName.toLowerCase());
-        setter.accept(typedObj, value);
+        setter.accept((T) obj, value);
         return true;
     }
 
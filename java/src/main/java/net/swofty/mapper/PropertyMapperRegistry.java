@@ -1,16 +1,53 @@
 package net.swofty.mapper;
 
-import java.util.ArrayList;
-import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.function.BiConsumer;
+import java.util.function.Function;
 
 /**
  * Registry for property mappers that provides custom property resolution
+ *
+ * Which mapper handles a property of a class is resolved once and cached per class
+ * and property name, including when no mapper does, so a lookup after the first is
+ * two table reads. Registering a mapper, or a property on one, clears the cache.
  */
 public class PropertyMapperRegistry {
-    private static final Map<Class<?>, PropertyMapper<?>> mappers = new HashMap<>();
-    private static final List<PropertyMapper<?>> wildcardMappers = new ArrayList<>();
+    private static final Map<Class<?>, PropertyMapper<?>> mappers = new ConcurrentHashMap<>();
+    private static final List<PropertyMapper<?>> wildcardMappers = new CopyOnWriteArrayList<>();
+
+    /**
+     * The mapper functions for one property of one class; null where no mapper applies
+     */
+    private static final class Resolution {
+        final Function<Object, Object> getter;
+        final BiConsumer<Object, Object> setter;
+
+        Resolution(Function<Object, Object> getter, BiConsumer<Object, Object> setter) {
+            this.getter = getter;
+            this.setter = setter;
+        }
+    }
+
+    /**
+     * The cache for one set of registered mappers: property name as written -> resolution
+     */
+    private static final class Resolutions extends ClassValue<Map<String, Resolution>> {
+        final int generation;
+
+        Resolutions(int generation) {
+            this.generation = generation;
+        }
+
+        @Override
+        protected Map<String, Resolution> computeValue(Class<?> type) {
+            return new ConcurrentHashMap<>();
+        }
+    }
+
+    private static volatile Resolutions resolutions = new Resolutions(0);
 
     /**
      * Register a property mapper
@@ -18,6 +55,7 @@ public class PropertyMapperRegistry {
      */
     public static <T> void registerMapper(PropertyMapper<T> mapper) {
         mappers.put(mapper.getTargetClass(), mapper);
+        invalidate();
     }
 
     /**
@@ -27,6 +65,23 @@ public class PropertyMapperRegistry {
      */
     public static <T> void registerWildcardMapper(PropertyMapper<T> mapper) {
         wildcardMappers.add(mapper);
+        invalidate();
+    }
+
+    /**
+     * Get the number of times the registered mappers have changed. Callers that keep
+     * what findGetter or findSetter returned must resolve again when this changes.
+     */
+    public static int getGeneration() {
+        return resolutions.generation;
+    }
+
+    /**
+     * Drop every cached resolution; called whenever a mapper or one of its properties
+     * is registered
+     */
+    static synchronized void invalidate() {
+        resolutions = new Resolutions(resolutions.generation + 1);
     }
 
     /**
@@ -35,46 +90,13 @@ public class PropertyMapperRegistry {
      * @param propertyName The name of the property
      * @return The property value, or null if no mapper can handle it
      */
-    @SuppressWarnings("unchecked")
     public static Object getProperty(Object obj, String propertyName) {
         if (obj == null) {
             return null;
         }
 
-        // Try exact class mapper
-        PropertyMapper<?> mapper = mappers.get(obj.getClass());
-        if (mapper != null && mapper.hasGetter(propertyName)) {
-            return mapper.getProperty(obj, propertyName);
-        }
-
-        // Try superclass mappers
-        Class<?> currentClass = obj.getClass().getSuperclass();
-        while (currentClass != null) {
-            mapper = mappers.get(currentClass);
-            if (mapper != null && mapper.hasGetter(propertyName)) {
-                return mapper.getProperty(obj, propertyName);
-            }
-            currentClass = currentClass.getSuperclass();
-        }
-
-        // Try interface mappers
-        for (Class<?> iface : obj.getClass().getInterfaces()) {
-            mapper = mappers.get(iface);
-            if (mapper != null && mapper.hasGetter(propertyName)) {
-                return mapper.getProperty(obj, propertyName);
-            }
-        }
-
-        // Try wildcard mappers
-        for (PropertyMapper<?> wildcardMapper : wildcardMappers) {
-            if (wildcardMapper.getTargetClass().isInstance(obj) &&
-                    wildcardMapper.hasGetter(propertyName)) {
-                return wildcardMapper.getProperty(obj, propertyName);
-            }
-        }
-
-        // No mapper found
-        return null;
+        Function<Object, Object> getter = resolve(obj.getClass(), propertyName).getter;
+        return getter != null ? getter.apply(obj) : null;
     }
 
     /**
@@ -84,45 +106,107 @@ public class PropertyMapperRegistry {
      * @param value The value to set
      * @return True if the property was set, false if no mapper can handle it
      */
-    @SuppressWarnings("unchecked")
     public static boolean setProperty(Object obj, String propertyName, Object value) {
         if (obj == null) {
             return false;
         }
 
+        BiConsumer<Object, Object> setter = resolve(obj.getClass(), propertyName).setter;
+        if (setter == null) {
+            return false;
+        }
+        setter.accept(obj, value);
+        return true;
+    }
+
+    /**
+     * Find the getter a mapper provides for a property of a class, so callers can
+     * resolve it once and keep it
+     * @param type The class of the target objects
+     * @param propertyName The name of the property
+     * @return The getter, or null if no mapper can handle it
+     */
+    public static Function<Object, Object> findGetter(Class<?> type, String propertyName) {
+        return resolve(type, propertyName).getter;
+    }
+
+    /**
+     * Find the setter a mapper provides for a property of a class
+     * @param type The class of the target objects
+     * @param propertyName The name of the property
+     * @return The setter, or null if no mapper can handle it
+     */
+    public static BiConsumer<Object, Object> findSetter(Class<?> type, String propertyName) {
+        return resolve(type, propertyName).setter;
+    }
+
+    private static Resolution resolve(Class<?> type, String propertyName) {
+        Map<String, Resolution> cache = resolutions.get(type);
+        Resolution resolution = cache.get(propertyName);
+        if (resolution != null) {
+            return resolution;
+        }
+        return cache.computeIfAbsent(propertyName, name -> {
+            // The name is normalized once here, not per access
+            String normalized = PropertyMapper.normalize(name);
+            return new Resolution(getterOf(findMapper(type, normalized, false), normalized),
+                    setterOf(findMapper(type, normalized, true), normalized));
+        });
+    }
+
+    @SuppressWarnings("unchecked")
+    private static Function<Object, Object> getterOf(PropertyMapper<?> mapper, String normalizedName) {
+        return mapper != null ? ((PropertyMapper<Object>) mapper).getNormalizedGetter(normalizedName) : null;
+    }
+
+    @SuppressWarnings("unchecked")
+    private static BiConsumer<Object, Object> setterOf(PropertyMapper<?> mapper, String normalizedName) {
+        return mapper != null ? ((PropertyMapper<Object>) mapper).getNormalizedSetter(normalizedName) : null;
+    }
+
+    /**
+     * Find the mapper that handles a property of a class: the class's own mapper, then
+     * its superclasses', then its interfaces', then the wildcard mappers
+     */
+    private static PropertyMapper<?> findMapper(Class<?> type, String normalizedName, boolean setter) {
         // Try exact class mapper
-        PropertyMapper<?> mapper = mappers.get(obj.getClass());
-        if (mapper != null && mapper.hasSetter(propertyName)) {
-            return mapper.setProperty(obj, propertyName, value);
+        PropertyMapper<?> mapper = mappers.get(type);
+        if (handles(mapper, normalizedName, setter)) {
+            return mapper;
         }
 
         // Try superclass mappers
-        Class<?> currentClass = obj.getClass().getSuperclass();
+        Class<?> currentClass = type.getSuperclass();
         while (currentClass != null) {
             mapper = mappers.get(currentClass);
-            if (mapper != null && mapper.hasSetter(propertyName)) {
-                return mapper.setProperty(obj, propertyName, value);
+            if (handles(mapper, normalizedName, setter)) {
+                return mapper;
             }
             currentClass = currentClass.getSuperclass();
         }
 
         // Try interface mappers
-        for (Class<?> iface : obj.getClass().getInterfaces()) {
+        for (Class<?> iface : type.getInterfaces()) {
             mapper = mappers.get(iface);
-            if (mapper != null && mapper.hasSetter(propertyName)) {
-                return mapper.setProperty(obj, propertyName, value);
+            if (handles(mapper, normalizedName, setter)) {
+                return mapper;
             }
         }
 
         // Try wildcard mappers
         for (PropertyMapper<?> wildcardMapper : wildcardMappers) {
-            if (wildcardMapper.getTargetClass().isInstance(obj) &&
-                    wildcardMapper.hasSetter(propertyName)) {
-                return wildcardMapper.setProperty(obj, propertyName, value);
+            if (wildcardMapper.getTargetClass().isAssignableFrom(type) &&
+                    handles(wildcardMapper, normalizedName, setter)) {
+                return wildcardMapper;
             }
         }
 
         // No mapper found
-        return false;
+        return null;
+    }
+
+    private static boolean handles(PropertyMapper<?> mapper, String normalizedName, boolean setter) {
+        return mapper != null && (setter ? mapper.getNormalizedSetter(normalizedName) != null
+                                         : mapper.getNormalizedGetter(normalizedName) != null);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,14 @@
+package net.swofty.nativebridge;
+
+/**
+ * An execute block translated to a JVM class by the native JvmBackend (see
+ * NativeEngine.generateClass). Instances are created by net.swofty.HandlerClasses.
+ */
+public interface CompiledHandler {
+    /**
+     * Run the block
+     * @param executor The net.swofty.ASTExecutor running it
+     * @param frame The block's slot values
+     */
+    void run(Object executor, Object[] frame);
+}
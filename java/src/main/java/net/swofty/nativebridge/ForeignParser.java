@@ -0,0 +1,99 @@
+package net.swofty.nativebridge;
+
+import net.swofty.nativebridge.representation.ParsedScript;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.FunctionDescriptor;
+import java.lang.foreign.Linker;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.SymbolLookup;
+import java.lang.foreign.ValueLayout;
+import java.lang.invoke.MethodHandle;
+
+/**
+ * Parses through the C ABI (native/src/ffi/SwoftLangCApi.h) with java.lang.foreign. That
+ * API is a preview in Java 21, so this class and ScriptDecoder are compiled as depending
+ * on preview features and only load with --enable-preview; they are kept apart from
+ * NativeParser so the JNI path loads without it.
+ */
+public final class ForeignParser {
+    private ForeignParser() {
+    }
+
+    /**
+     * Parse SwoftLang code through the C ABI (swoft_parse) instead of JNI.
+     * The native side builds no Java objects; the result buffer is decoded here and
+     * freed before returning. Requires the native library to be loaded already.
+     * @param code The SwoftLang code to parse
+     * @return The commands and events declared in the script
+     */
+    public static ParsedScript parseScript(String code) {
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment source = arena.allocateUtf8String(code);
+            MemorySegment resultOut = arena.allocate(ValueLayout.ADDRESS);
+
+            int status = (int) ForeignApi.PARSE.invokeExact(source, source.byteSize() - 1, resultOut);
+            MemorySegment result = resultOut.get(ValueLayout.ADDRESS, 0);
+            if (result.equals(MemorySegment.NULL)) {
+                throw new RuntimeException("Native parser failed with status " + status);
+            }
+
+            try {
+                if (status != ForeignApi.SWOFT_OK) {
+                    MemorySegment error = (MemorySegment) ForeignApi.RESULT_ERROR.invokeExact(result);
+                    throw new RuntimeException(error.reinterpret(Long.MAX_VALUE).getUtf8String(0));
+                }
+
+                long size = (long) ForeignApi.RESULT_SIZE.invokeExact(result);
+                MemorySegment data = ((MemorySegment) ForeignApi.RESULT_DATA.invokeExact(result)).reinterpret(size);
+                MemorySegment notes = (MemorySegment) ForeignApi.RESULT_DIAGNOSTICS.invokeExact(result);
+                String diagnostics = notes.reinterpret(Long.MAX_VALUE).getUtf8String(0);
+                return ScriptDecoder.decode(data, diagnostics.isEmpty() ? new String[0] : diagnostics.split("\n"));
+            } finally {
+                ForeignApi.FREE.invokeExact(result);
+            }
+        } catch (RuntimeException e) {
+            throw e;
+        } catch (Throwable t) {
+            throw new RuntimeException("Failed to call native parser", t);
+        }
+    }
+
+    /**
+     * Downcall handles for the C ABI declared in native/src/ffi/SwoftLangCApi.h,
+     * resolved on first use against the library loaded by LibraryLoader.
+     */
+    private static final class ForeignApi {
+        static final int SWOFT_OK = 0;
+
+        static final MethodHandle PARSE;
+        static final MethodHandle RESULT_DATA;
+        static final MethodHandle RESULT_SIZE;
+        static final MethodHandle RESULT_ERROR;
+        static final MethodHandle RESULT_DIAGNOSTICS;
+        static final MethodHandle FREE;
+
+        static {
+            Linker linker = Linker.nativeLinker();
+            SymbolLookup lookup = SymbolLookup.loaderLookup();
+
+            PARSE = linker.downcallHandle(find(lookup, "swoft_parse"), FunctionDescriptor.of(
+                    ValueLayout.JAVA_INT, ValueLayout.ADDRESS, ValueLayout.JAVA_LONG, ValueLayout.ADDRESS));
+            RESULT_DATA = linker.downcallHandle(find(lookup, "swoft_result_data"),
+                    FunctionDescriptor.of(ValueLayout.ADDRESS, ValueLayout.ADDRESS));
+            RESULT_SIZE = linker.downcallHandle(find(lookup, "swoft_result_size"),
+                    FunctionDescriptor.of(ValueLayout.JAVA_LONG, ValueLayout.ADDRESS));
+            RESULT_ERROR = linker.downcallHandle(find(lookup, "swoft_result_error"),
+                    FunctionDescriptor.of(ValueLayout.ADDRESS, ValueLayout.ADDRESS));
+            RESULT_DIAGNOSTICS = linker.downcallHandle(find(lookup, "swoft_result_diagnostics"),
+                    FunctionDescriptor.of(ValueLayout.ADDRESS, ValueLayout.ADDRESS));
+            FREE = linker.downcallHandle(find(lookup, "swoft_free"),
+                    FunctionDescriptor.ofVoid(ValueLayout.ADDRESS));
+        }
+
+        private static MemorySegment find(SymbolLookup lookup, String name) {
+            return lookup.find(name)
+                    .orElseThrow(() -> new UnsatisfiedLinkError("Native symbol not found: " + name));
+        }
+    }
+}
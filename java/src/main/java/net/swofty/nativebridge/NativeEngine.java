@@ -0,0 +1,40 @@
+package net.swofty.nativebridge;
+
+/**
+ * Runs compiled programs in the native VM (VirtualMachine.h). A program is loaded once
+ * into a native handle, which representation.Program keeps and frees.
+ */
+public final class NativeEngine {
+    // Results of run
+    public static final int FINISHED = 0;
+    public static final int HALTED = 1;
+
+    private NativeEngine() {
+    } // no instances
+
+    /**
+     * Load a program into the native VM
+     * @return A handle for run and free
+     */
+    public static native long load(int[] code, Object[] constants, int[] lines, int registerCount);
+
+    public static native void free(long handle);
+
+    /**
+     * Run a loaded program
+     * @param handle From load
+     * @param frame The block's slot values
+     * @param host Receives property reads and effects
+     * @return FINISHED or HALTED; failures are thrown as RuntimeException with the source line
+     */
+    public static native int run(long handle, Object[] frame, NativeHost host);
+
+    /**
+     * Translate a program into a class implementing CompiledHandler (JvmBackend.h)
+     * @param slotCount How many of the registers are the block's slots
+     * @param className Internal name of the class, in the net/swofty package
+     * @return The class file, to be defined as a hidden class of net.swofty
+     */
+    public static native byte[] generateClass(int[] code, Object[] constants, int[] lines, int registerCount,
+                                              int slotCount, String className);
+}
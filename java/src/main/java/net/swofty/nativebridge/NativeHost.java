@@ -0,0 +1,47 @@
+package net.swofty.nativebridge;
+
+/**
+ * What the native VM (see NativeEngine) calls back into while it runs a program.
+ * Control flow, strings and comparisons stay native; only property reads, the text of
+ * Java objects and the handler's effects cross over, and effects arrive in batches.
+ */
+public interface NativeHost {
+    // Object types for typeOf - must match JniHost.cpp
+    int OTHER = 0;
+    int PLAYER = 1;
+    int LOCATION = 2;
+
+    // Effect kinds for apply - must match Effect::Kind in Host.h
+    int SEND = 0;
+    int TELEPORT = 1;
+    int CANCEL = 2;
+    int SET_PROPERTY = 3;
+
+    /**
+     * Read one property of an object
+     * @return The value, or null if the object has no such property
+     */
+    Object getProperty(Object object, String property);
+
+    /**
+     * Get the text of a value that is not a String or Boolean
+     * @param display true for the form used when building strings, false for toString()
+     */
+    String text(Object value, boolean display);
+
+    /**
+     * Classify an object for `is a` checks
+     * @return OTHER, PLAYER or LOCATION
+     */
+    int typeOf(Object object);
+
+    /**
+     * Perform queued effects in order. Effect i is kinds[i], with its operands at
+     * operands[3i..3i+2]:
+     * SEND (message, target or null for the sender, unused),
+     * TELEPORT (entity, target, unused),
+     * CANCEL (unused),
+     * SET_PROPERTY (object, value, property name).
+     */
+    void apply(int[] kinds, Object[] operands);
+}
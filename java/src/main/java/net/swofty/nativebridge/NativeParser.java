@@ -3,6 +3,10 @@ package net.swofty.nativebridge;
 import net.swofty.nativebridge.representation.Command;
 import net.swofty.nativebridge.representation.Event;
 
+/**
+ * The JNI parse entry points. The C ABI binding lives in ForeignParser, so loading this
+ * class never needs preview features.
+ */
 public class NativeParser {
     /**
      * Parse SwoftLang code and return a JSON representation.
@@ -10,7 +14,7 @@ public class NativeParser {
      * @return A JSON string representing the parsed commands
      */
     public static native String parseSwoftLang(String code);
-    
+
     /**
      * Parse SwoftLang code and return an array of Command objects.
      * @param code The SwoftLang code to parse
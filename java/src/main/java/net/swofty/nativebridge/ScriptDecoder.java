@@ -0,0 +1,339 @@
+package net.swofty.nativebridge;
+
+import net.swofty.nativebridge.execution.BlockStatement;
+import net.swofty.nativebridge.execution.Expression;
+import net.swofty.nativebridge.execution.Statement;
+import net.swofty.nativebridge.execution.commands.CancelEventStatement;
+import net.swofty.nativebridge.execution.commands.HaltCommand;
+import net.swofty.nativebridge.execution.commands.IfStatement;
+import net.swofty.nativebridge.execution.commands.SendCommand;
+import net.swofty.nativebridge.execution.commands.SwitchStatement;
+import net.swofty.nativebridge.execution.commands.TeleportCommand;
+import net.swofty.nativebridge.execution.commands.VariableAssignment;
+import net.swofty.nativebridge.execution.expressions.BinaryExpression;
+import net.swofty.nativebridge.execution.expressions.BooleanLiteral;
+import net.swofty.nativebridge.execution.expressions.Concat;
+import net.swofty.nativebridge.execution.expressions.EventAccessExpression;
+import net.swofty.nativebridge.execution.expressions.InterpolatedString;
+import net.swofty.nativebridge.execution.expressions.StringLiteral;
+import net.swofty.nativebridge.execution.expressions.TypeLiteral;
+import net.swofty.nativebridge.execution.expressions.VariableReference;
+import net.swofty.nativebridge.representation.BaseType;
+import net.swofty.nativebridge.representation.Command;
+import net.swofty.nativebridge.representation.DataType;
+import net.swofty.nativebridge.representation.Event;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+import net.swofty.nativebridge.representation.MatchTable;
+import net.swofty.nativebridge.representation.ParsedScript;
+import net.swofty.nativebridge.representation.Program;
+import net.swofty.nativebridge.representation.SwitchTable;
+import net.swofty.nativebridge.representation.Variable;
+
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * Reads the buffer written by the native ScriptSerializer (see ScriptSerializer.h for
+ * the layout) straight out of native memory.
+ */
+final class ScriptDecoder {
+    private static final int MAGIC = 0x54465753;
+    private static final int VERSION = 10;
+
+    // Node tags - must match ScriptSerializer::WireTag
+    private static final int NONE = 0;
+    private static final int SEND = 1;
+    private static final int TELEPORT = 2;
+    private static final int HALT = 3;
+    private static final int IF = 4;
+    private static final int BLOCK = 5;
+    private static final int ASSIGN = 6;
+    private static final int CANCEL_EVENT = 7;
+    private static final int SWITCH = 8;
+    private static final int STRING_LITERAL = 16;
+    private static final int VARIABLE_REFERENCE = 17;
+    private static final int BINARY = 18;
+    private static final int TYPE_LITERAL = 19;
+    private static final int EVENT_ACCESS = 20;
+    private static final int INTERPOLATED_STRING = 21;
+    private static final int BOOLEAN_LITERAL = 22;
+    private static final int CONCAT = 23;
+    private static final int EXECUTE_BLOCK = 32;
+
+    // Constant pool entry kinds - must match Constant::Kind in Bytecode.h
+    private static final int CONSTANT_STRING = 0;
+    private static final int CONSTANT_PATH = 1;
+    private static final int CONSTANT_SWITCH = 2;
+    private static final int CONSTANT_MATCH = 3;
+
+    private static final BinaryExpression.Operator[] OPERATORS = BinaryExpression.Operator.values();
+    private static final BaseType[] BASE_TYPES = BaseType.values();
+
+    private final MemorySegment data;
+    private long offset;
+    private final String[] diagnostics;
+    private String[] strings;
+
+    private ScriptDecoder(MemorySegment data, String[] diagnostics) {
+        this.data = data;
+        this.diagnostics = diagnostics;
+    }
+
+    static ParsedScript decode(MemorySegment data, String[] diagnostics) {
+        return new ScriptDecoder(data, diagnostics).readScript();
+    }
+
+    private ParsedScript readScript() {
+        if (readInt() != MAGIC) {
+            throw new IllegalStateException("Native parser returned an unrecognised buffer");
+        }
+        int version = readInt();
+        if (version != VERSION) {
+            throw new IllegalStateException("Unsupported native wire format version " + version);
+        }
+
+        strings = new String[readInt()];
+        int commandCount = readInt();
+        int eventCount = readInt();
+
+        for (int i = 0; i < strings.length; i++) {
+            int length = readInt();
+            byte[] bytes = data.asSlice(offset, length).toArray(ValueLayout.JAVA_BYTE);
+            strings[i] = new String(bytes, StandardCharsets.UTF_8);
+            offset += length;
+        }
+
+        Command[] commands = new Command[commandCount];
+        for (int i = 0; i < commandCount; i++) {
+            commands[i] = readCommand();
+        }
+
+        Event[] events = new Event[eventCount];
+        for (int i = 0; i < eventCount; i++) {
+            events[i] = readEvent();
+        }
+
+        return new ParsedScript(commands, events, diagnostics);
+    }
+
+    private Command readCommand() {
+        Command command = new Command(readString());
+        command.setPermission(readString());
+        command.setDescription(readString());
+
+        int argCount = readInt();
+        for (int i = 0; i < argCount; i++) {
+            String name = readString();
+            String defaultValue = readString();
+            Variable argument = new Variable(name, readDataType());
+            if (defaultValue != null) {
+                argument.setDefault(defaultValue);
+            }
+            command.addArgument(argument);
+        }
+
+        ExecuteBlock block = readBlock();
+        if (block != null) {
+            command.setExecuteBlock(block);
+        }
+        return command;
+    }
+
+    private Event readEvent() {
+        Event event = new Event(readString());
+        event.setPriority(readInt());
+
+        ExecuteBlock block = readBlock();
+        if (block != null) {
+            event.setExecuteBlock(block);
+        }
+        return event;
+    }
+
+    private DataType readDataType() {
+        DataType type = new DataType(BASE_TYPES[readInt()]);
+        int subTypeCount = readInt();
+        for (int i = 0; i < subTypeCount; i++) {
+            type.addSubType(readDataType());
+        }
+        return type;
+    }
+
+    /**
+     * Rebuild a post-order node stream. Children are always on the stack by the time
+     * their parent is read, so no recursion is needed however deep the script nests.
+     */
+    private ExecuteBlock readBlock() {
+        int nodeCount = readInt();
+        if (nodeCount == 0) {
+            return null;
+        }
+        boolean canHalt = readInt() != 0;
+        int effects = readInt();
+
+        String[] slotNames = readStrings();
+        String[] eventReads = readStrings();
+        String[] eventWrites = readStrings();
+
+        Object[] stack = new Object[nodeCount];
+        int top = 0;
+
+        for (int i = 0; i < nodeCount; i++) {
+            int tag = readInt();
+            switch (tag) {
+                case NONE -> stack[top++] = null;
+                case STRING_LITERAL -> stack[top++] = new StringLiteral(readString());
+                case VARIABLE_REFERENCE -> stack[top++] = new VariableReference(readString(), readInt(), readPath());
+                case TYPE_LITERAL -> stack[top++] = new TypeLiteral(readString());
+                case EVENT_ACCESS -> stack[top++] = new EventAccessExpression(readString());
+                case BINARY -> {
+                    Expression right = (Expression) stack[--top];
+                    Expression left = (Expression) stack[--top];
+                    stack[top++] = new BinaryExpression(left, OPERATORS[readInt()], right);
+                }
+                case INTERPOLATED_STRING -> {
+                    Expression[] parts = new Expression[readInt()];
+                    top -= parts.length;
+                    System.arraycopy(stack, top, parts, 0, parts.length);
+                    stack[top++] = new InterpolatedString(parts, readInt());
+                }
+                case CONCAT -> {
+                    Expression[] parts = new Expression[readInt()];
+                    top -= parts.length;
+                    System.arraycopy(stack, top, parts, 0, parts.length);
+                    stack[top++] = new Concat(parts, readInt());
+                }
+                case BOOLEAN_LITERAL -> stack[top++] = new BooleanLiteral(readInt() != 0);
+                case SEND -> {
+                    Expression target = (Expression) stack[--top];
+                    Expression message = (Expression) stack[--top];
+                    stack[top++] = new SendCommand(message, target);
+                }
+                case TELEPORT -> {
+                    Expression target = (Expression) stack[--top];
+                    Expression entity = (Expression) stack[--top];
+                    stack[top++] = new TeleportCommand(entity, target);
+                }
+                case HALT -> stack[top++] = new HaltCommand();
+                case CANCEL_EVENT -> stack[top++] = new CancelEventStatement();
+                case IF -> {
+                    Statement elseStatement = (Statement) stack[--top];
+                    Statement thenStatement = (Statement) stack[--top];
+                    Expression condition = (Expression) stack[--top];
+                    stack[top++] = new IfStatement(condition, thenStatement, elseStatement);
+                }
+                case SWITCH -> {
+                    String[] labels = new String[readInt()];
+                    for (int j = 0; j < labels.length; j++) {
+                        labels[j] = readString();
+                    }
+                    Statement defaultStatement = (Statement) stack[--top];
+                    Statement[] branches = new Statement[labels.length];
+                    top -= branches.length;
+                    System.arraycopy(stack, top, branches, 0, branches.length);
+                    Expression subject = (Expression) stack[--top];
+                    stack[top++] = new SwitchStatement(subject, labels, branches, defaultStatement);
+                }
+                case BLOCK -> {
+                    int count = readInt();
+                    BlockStatement block = new BlockStatement();
+                    for (int j = top - count; j < top; j++) {
+                        block.addStatement((Statement) stack[j]);
+                    }
+                    top -= count;
+                    stack[top++] = block;
+                }
+                case ASSIGN -> {
+                    Expression value = (Expression) stack[--top];
+                    stack[top++] = new VariableAssignment(readString(), readInt(), readPath(), value);
+                }
+                case EXECUTE_BLOCK -> {
+                    int count = readInt();
+                    ExecuteBlock block = new ExecuteBlock();
+                    for (int j = top - count; j < top; j++) {
+                        if (stack[j] != null) {
+                            block.addStatement((Statement) stack[j]);
+                        }
+                    }
+                    block.setCanHalt(canHalt);
+                    top -= count;
+                    stack[top++] = block;
+                }
+                default -> throw new IllegalStateException("Unknown node tag " + tag + " in native buffer");
+            }
+        }
+
+        ExecuteBlock block = (ExecuteBlock) stack[0];
+        block.setSlotNames(slotNames);
+        block.setEventAccesses(eventReads, eventWrites);
+        block.setEffects(effects);
+        block.setProgram(readProgram());
+        return block;
+    }
+
+    /**
+     * Read the block's bytecode, or null if the native compiler left it to the tree walker
+     */
+    private Program readProgram() {
+        int[] code = new int[readInt()];
+        if (code.length == 0) {
+            return null;
+        }
+        for (int i = 0; i < code.length; i++) {
+            code[i] = readInt();
+        }
+
+        Object[] constants = new Object[readInt()];
+        for (int i = 0; i < constants.length; i++) {
+            int kind = readInt();
+            constants[i] = switch (kind) {
+                case CONSTANT_STRING -> readString();
+                case CONSTANT_PATH -> readPath();
+                case CONSTANT_SWITCH, CONSTANT_MATCH -> {
+                    String[] labels = new String[readInt()];
+                    int[] targets = new int[labels.length];
+                    for (int j = 0; j < labels.length; j++) {
+                        labels[j] = readString();
+                        targets[j] = readInt();
+                    }
+                    yield kind == CONSTANT_SWITCH ? new SwitchTable(labels, targets) : new MatchTable(labels, targets);
+                }
+                default -> throw new IllegalStateException("Unknown constant kind " + kind + " in native buffer");
+            };
+        }
+
+        int[] lines = new int[readInt() * 2];
+        for (int i = 0; i < lines.length; i++) {
+            lines[i] = readInt();
+        }
+        return new Program(code, constants, lines, readInt());
+    }
+
+    private String[] readPath() {
+        String[] path = new String[readInt()];
+        for (int i = 0; i < path.length; i++) {
+            path[i] = readString();
+        }
+        return path;
+    }
+
+    private int readInt() {
+        int value = data.get(ValueLayout.JAVA_INT_UNALIGNED, offset);
+        offset += Integer.BYTES;
+        return value;
+    }
+
+    private String readString() {
+        int index = readInt();
+        return index < 0 ? null : strings[index];
+    }
+
+    private String[] readStrings() {
+        String[] values = new String[readInt()];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = readString();
+        }
+        return values;
+    }
+}
@@ -0,0 +1,57 @@
+package net.swofty.nativebridge.execution.commands;
+
+import net.swofty.nativebridge.execution.Expression;
+import net.swofty.nativebridge.execution.Statement;
+
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * An else-if chain over one value compared with string literals, turned into a
+ * lookup table by the native condition compiler
+ */
+public class SwitchStatement implements Statement {
+    private final Expression subject;
+    private final Map<String, Statement> cases;
+    private final Statement defaultStatement;
+
+    public SwitchStatement(Expression subject, String[] labels, Statement[] branches, Statement defaultStatement) {
+        this.subject = subject;
+        this.cases = new HashMap<>(labels.length * 2);
+        for (int i = 0; i < labels.length; i++) {
+            cases.putIfAbsent(labels[i], branches[i]);
+        }
+        this.defaultStatement = defaultStatement;
+    }
+
+    public Expression getSubject() {
+        return subject;
+    }
+
+    /**
+     * Get the branch for a value
+     * @param value The evaluated subject
+     * @return The matching branch, or the default statement (possibly null) if no label equals the value
+     */
+    public Statement select(Object value) {
+        if (value instanceof String) {
+            Statement branch = cases.get(value);
+            if (branch != null) {
+                return branch;
+            }
+        }
+        return defaultStatement;
+    }
+
+    /**
+     * @return Each label with the branch it selects; the first branch wins for duplicate labels
+     */
+    public Map<String, Statement> getCases() {
+        return Collections.unmodifiableMap(cases);
+    }
+
+    public Statement getDefaultStatement() {
+        return defaultStatement;
+    }
+}
@@ -5,10 +5,18 @@ import net.swofty.nativebridge.execution.Statement;
 
 public class VariableAssignment implements Statement {
     private final String variableName;
+    private final int slot;
+    private final String[] path;
     private final Expression value;
 
-    public VariableAssignment(String variableName, Expression value) {
+    /**
+     * The target is bound the same way as a {@link net.swofty.nativebridge.execution.expressions.VariableReference}:
+     * an empty path assigns the slot itself, otherwise the last segment is set on the object the rest leads to.
+     */
+    public VariableAssignment(String variableName, int slot, String[] path, Expression value) {
         this.variableName = variableName;
+        this.slot = slot;
+        this.path = path;
         this.value = value;
     }
 
@@ -16,6 +24,14 @@ public class VariableAssignment implements Statement {
         return variableName;
     }
 
+    public int getSlot() {
+        return slot;
+    }
+
+    public String[] getPath() {
+        return path;
+    }
+
     public Expression getValue() {
         return value;
     }
@@ -2,6 +2,8 @@ package net.swofty.nativebridge.execution.expressions;
 
 import net.swofty.nativebridge.execution.Expression;
 
+import java.lang.annotation.Native;
+
 public class BinaryExpression implements Expression {
     public enum Operator {
         EQUALS("=="),
@@ -15,8 +17,31 @@ public class BinaryExpression implements Expression {
         IS_TYPE("is"),
         IS_NOT_TYPE("is not"),
         CONTAINS("contains"),
+
+        // Typed variants chosen by the native type checker when both operand types are known
+        STRING_EQUALS("=="),
+        STRING_NOT_EQUALS("!="),
+        NUMBER_EQUALS("=="),
+        NUMBER_NOT_EQUALS("!="),
+        NUMBER_LESS_THAN("<"),
+        NUMBER_GREATER_THAN(">"),
+        NUMBER_LESS_EQUALS("<="),
+        NUMBER_GREATER_EQUALS(">="),
+        IDENTITY_EQUALS("=="),
+        IDENTITY_NOT_EQUALS("!="),
+
         CONCATENATE("+");
 
+        /** Number of operators, checked against the C++ Operator enum at native compile time. */
+        @Native
+        public static final int COUNT = 22;
+
+        static {
+            if (values().length != COUNT) {
+                throw new AssertionError("Operator.COUNT is " + COUNT + " but there are " + values().length + " operators");
+            }
+        }
+
         private final String symbol;
 
         Operator(String symbol) {
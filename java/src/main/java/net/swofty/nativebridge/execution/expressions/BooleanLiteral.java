@@ -0,0 +1,18 @@
+package net.swofty.nativebridge.execution.expressions;
+
+import net.swofty.nativebridge.execution.Expression;
+
+/**
+ * A condition the native parser already evaluated, e.g. {@code "a" = "b"}.
+ */
+public class BooleanLiteral implements Expression {
+    private final boolean value;
+
+    public BooleanLiteral(boolean value) {
+        this.value = value;
+    }
+
+    public boolean getValue() {
+        return value;
+    }
+}
@@ -0,0 +1,28 @@
+package net.swofty.nativebridge.execution.expressions;
+
+import net.swofty.nativebridge.execution.Expression;
+
+/**
+ * A whole {@code a + b + c} chain. Adjacent constants were merged by the native parser,
+ * so every part is appended exactly once.
+ */
+public class Concat implements Expression {
+    private final Expression[] parts;
+    private final int literalLength;
+
+    public Concat(Expression[] parts, int literalLength) {
+        this.parts = parts;
+        this.literalLength = literalLength;
+    }
+
+    public Expression[] getParts() {
+        return parts;
+    }
+
+    /**
+     * @return the combined length of the constant parts
+     */
+    public int getLiteralLength() {
+        return literalLength;
+    }
+}
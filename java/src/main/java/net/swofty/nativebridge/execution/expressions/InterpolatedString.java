@@ -0,0 +1,28 @@
+package net.swofty.nativebridge.execution.expressions;
+
+import net.swofty.nativebridge.execution.Expression;
+
+/**
+ * A string literal with ${...} placeholders, split by the native parser into
+ * {@link StringLiteral} chunks and {@link VariableReference}s in source order.
+ */
+public class InterpolatedString implements Expression {
+    private final Expression[] parts;
+    private final int literalLength;
+
+    public InterpolatedString(Expression[] parts, int literalLength) {
+        this.parts = parts;
+        this.literalLength = literalLength;
+    }
+
+    public Expression[] getParts() {
+        return parts;
+    }
+
+    /**
+     * @return the combined length of the literal chunks
+     */
+    public int getLiteralLength() {
+        return literalLength;
+    }
+}
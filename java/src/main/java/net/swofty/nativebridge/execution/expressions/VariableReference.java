@@ -4,12 +4,29 @@ import net.swofty.nativebridge.execution.Expression;
 
 public class VariableReference implements Expression {
     private final String name;
+    private final int slot;
+    private final String[] path;
 
-    public VariableReference(String name) {
+    /**
+     * @param name the reference as written, e.g. "event.player.name"
+     * @param slot frame slot of the root name, or -1 if the native resolver did not run
+     * @param path property segments after the root, e.g. {"player", "name"}
+     */
+    public VariableReference(String name, int slot, String[] path) {
         this.name = name;
+        this.slot = slot;
+        this.path = path;
     }
 
     public String getName() {
         return name;
     }
+
+    public int getSlot() {
+        return slot;
+    }
+
+    public String[] getPath() {
+        return path;
+    }
 }
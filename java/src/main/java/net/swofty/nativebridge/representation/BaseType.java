@@ -1,5 +1,7 @@
 package net.swofty.nativebridge.representation;
 
+import java.lang.annotation.Native;
+
 public enum BaseType {
     STRING,
     INTEGER,
@@ -8,5 +10,18 @@ public enum BaseType {
     PLAYER,
     LOCATION,
     EITHER,
-    UNKNOWN
+    UNKNOWN;
+
+    /**
+     * Number of constants. Exported to the native headers so the C++ BaseType enum,
+     * which the bridge indexes by ordinal, fails to compile if the two drift apart.
+     */
+    @Native
+    public static final int COUNT = 8;
+
+    static {
+        if (values().length != COUNT) {
+            throw new AssertionError("BaseType.COUNT is " + COUNT + " but there are " + values().length + " constants");
+        }
+    }
 }
\ No newline at end of file
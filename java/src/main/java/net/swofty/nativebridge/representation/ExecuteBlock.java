@@ -1,5 +1,6 @@
 package net.swofty.nativebridge.representation;
 
+import net.swofty.nativebridge.CompiledHandler;
 import net.swofty.nativebridge.execution.Statement;
 
 import java.util.ArrayList;
@@ -9,7 +10,23 @@ import java.util.List;
  * Represents a block of executable statements in SwoftLang
  */
 public class ExecuteBlock {
+    // Effect flags - must match EffectAnalyzer::Effect
+    public static final int READS_STATE = 1;
+    public static final int SENDS = 2;
+    public static final int WRITES_EVENT = 4;
+    public static final int WRITES_STATE = 8;
+    public static final int CANCELS = 16;
+    public static final int TELEPORTS = 32;
+    private static final int MUTATES = WRITES_EVENT | WRITES_STATE | CANCELS | TELEPORTS;
+
     private final List<Statement> statements = new ArrayList<>();
+    private String[] slotNames = new String[0];
+    private String[] eventReads = new String[0];
+    private String[] eventWrites = new String[0];
+    private boolean canHalt = true;
+    private int effects = -1;
+    private Program program;
+    private volatile CompiledHandler treeHandler;
 
     /**
      * Add a statement to this execute block
@@ -27,6 +44,123 @@ public class ExecuteBlock {
         return statements;
     }
 
+    /**
+     * Set the frame layout chosen by the native resolver
+     * @param slotNames The variable name that fills each frame slot
+     */
+    public void setSlotNames(String[] slotNames) {
+        this.slotNames = slotNames;
+    }
+
+    /**
+     * Get the frame layout of this block
+     * @return The variable name that fills each frame slot
+     */
+    public String[] getSlotNames() {
+        return slotNames;
+    }
+
+    /**
+     * Set the event properties the native resolver found this block using
+     * @param eventReads The properties read from the event
+     * @param eventWrites The properties assigned on the event
+     */
+    public void setEventAccesses(String[] eventReads, String[] eventWrites) {
+        this.eventReads = eventReads;
+        this.eventWrites = eventWrites;
+    }
+
+    /**
+     * Get the event properties this block reads, as "player" for event.player.name
+     * @return The first segment of every event path the block reads
+     */
+    public String[] getEventReads() {
+        return eventReads;
+    }
+
+    /**
+     * Get the event properties this block assigns, as "message" for set event.message
+     * @return The properties the block stores into the event
+     */
+    public String[] getEventWrites() {
+        return eventWrites;
+    }
+
+    /**
+     * Record whether a halt statement survived dead-code elimination
+     * @param canHalt false if executing this block can never halt
+     */
+    public void setCanHalt(boolean canHalt) {
+        this.canHalt = canHalt;
+    }
+
+    /**
+     * Check whether executing this block can halt. When it cannot, the executor
+     * skips its per-statement halted checks.
+     * @return false if the block contains no reachable halt statement
+     */
+    public boolean canHalt() {
+        return canHalt;
+    }
+
+    /**
+     * Set what the native effect analysis found this block can do
+     * @param effects A combination of the effect flags, or -1 if not analysed
+     */
+    public void setEffects(int effects) {
+        this.effects = effects;
+    }
+
+    /**
+     * Get what executing this block can do outside its own frame (see EffectAnalyzer.h)
+     * @return A combination of READS_STATE, SENDS, WRITES_EVENT, WRITES_STATE, CANCELS and
+     * TELEPORTS; -1, every effect, if the block was not analysed
+     */
+    public int getEffects() {
+        return effects;
+    }
+
+    /**
+     * Check whether this block is known to leave the event and the world as they were:
+     * it may read state and send messages, but never assigns properties, cancels or
+     * teleports
+     */
+    public boolean isReadOnly() {
+        return (effects & MUTATES) == 0;
+    }
+
+    /**
+     * Attach the bytecode the native compiler produced for this block
+     * @param program The compiled block
+     */
+    public void setProgram(Program program) {
+        this.program = program;
+    }
+
+    /**
+     * Get the compiled form of this block
+     * @return The program, or null if the block could not be compiled and is run as a tree
+     */
+    public Program getProgram() {
+        return program;
+    }
+
+    /**
+     * Keep the statement tree linked into closures by the executor
+     * @param treeHandler The linked tree
+     */
+    public void setTreeHandler(CompiledHandler treeHandler) {
+        this.treeHandler = treeHandler;
+    }
+
+    /**
+     * Get the linked form of the statement tree
+     * @return The linked tree, or null if it has not been linked yet
+     */
+    public CompiledHandler getTreeHandler() {
+        return treeHandler;
+    }
+
     /**
      * Check if this execute block is empty
      * @return true if no statements, false otherwise
@@ -0,0 +1,150 @@
+package net.swofty.nativebridge.representation;
+
+import java.util.Arrays;
+
+/**
+ * The table of a MATCH instruction: patterns a value is tested to contain, ignoring case,
+ * and the code offset each one jumps to. The first pattern, in table order, that occurs in
+ * the text wins.
+ *
+ * The patterns are built into an Aho-Corasick automaton with a full transition table, so
+ * a text is scanned once whatever the number of patterns. Characters map to classes -
+ * one per distinct character the patterns use and one for every other character - through
+ * an array for ASCII and a sorted array for the rest.
+ */
+public class MatchTable {
+    private static final int NO_MATCH = -1;
+
+    private final String[] patterns;
+    private final int[] offsets;
+
+    private final int[] asciiClasses = new int[128];
+    private final char[] otherChars;
+    private final int[] otherClasses;
+    private final int classCount;
+    private final int[] next; // state * classCount + class -> state
+    private final int[] best; // lowest pattern index ending at a state or a suffix of it
+
+    public MatchTable(String[] patterns, int[] targets) {
+        this.patterns = patterns;
+        this.offsets = targets;
+
+        // Classes, with 0 for characters no pattern uses
+        StringBuilder others = new StringBuilder();
+        int classes = 1;
+        for (String pattern : patterns) {
+            for (int i = 0; i < pattern.length(); i++) {
+                char c = Character.toLowerCase(pattern.charAt(i));
+                if (c < 128) {
+                    if (asciiClasses[c] == 0) {
+                        asciiClasses[c] = classes++;
+                    }
+                } else if (others.indexOf(String.valueOf(c)) < 0) {
+                    others.append(c);
+                }
+            }
+        }
+        otherChars = others.toString().toCharArray();
+        Arrays.sort(otherChars);
+        otherClasses = new int[otherChars.length];
+        for (int i = 0; i < otherClasses.length; i++) {
+            otherClasses[i] = classes++;
+        }
+        classCount = classes;
+
+        // Trie of the folded patterns; -1 marks a missing edge until failure links fill it
+        int stateLimit = 1;
+        for (String pattern : patterns) {
+            stateLimit += pattern.length();
+        }
+        int[] edges = new int[stateLimit * classCount];
+        Arrays.fill(edges, -1);
+        int[] ends = new int[stateLimit];
+        Arrays.fill(ends, NO_MATCH);
+        int stateCount = 1;
+        for (int p = 0; p < patterns.length; p++) {
+            int state = 0;
+            for (int i = 0; i < patterns[p].length(); i++) {
+                int slot = state * classCount + classOf(patterns[p].charAt(i));
+                if (edges[slot] < 0) {
+                    edges[slot] = stateCount++;
+                }
+                state = edges[slot];
+            }
+            if (ends[state] == NO_MATCH) {
+                ends[state] = p;
+            }
+        }
+
+        // Breadth-first, so a state's failure target is complete before the state is
+        int[] failure = new int[stateCount];
+        int[] queue = new int[stateCount];
+        int tail = 0;
+        for (int c = 0; c < classCount; c++) {
+            if (edges[c] < 0) {
+                edges[c] = 0;
+            } else {
+                queue[tail++] = edges[c];
+            }
+        }
+        for (int head = 0; head < tail; head++) {
+            int state = queue[head];
+            int fallback = failure[state];
+            if (ends[fallback] != NO_MATCH && (ends[state] == NO_MATCH || ends[fallback] < ends[state])) {
+                ends[state] = ends[fallback];
+            }
+
+            for (int c = 0; c < classCount; c++) {
+                int slot = state * classCount + c;
+                if (edges[slot] < 0) {
+                    edges[slot] = edges[fallback * classCount + c];
+                } else {
+                    failure[edges[slot]] = edges[fallback * classCount + c];
+                    queue[tail++] = edges[slot];
+                }
+            }
+        }
+
+        next = Arrays.copyOf(edges, stateCount * classCount);
+        best = Arrays.copyOf(ends, stateCount);
+    }
+
+    public String[] getPatterns() {
+        return patterns;
+    }
+
+    /**
+     * @return The jump target of each pattern, in pattern order
+     */
+    public int[] getTargets() {
+        return offsets;
+    }
+
+    /**
+     * Get the jump target for a text
+     * @param text The display text of the value tested
+     * @param defaultTarget The offset to use if the text contains no pattern
+     * @return The code offset to continue at
+     */
+    public int target(String text, int defaultTarget) {
+        int found = best[0]; // an empty pattern occurs in every text
+        int state = 0;
+        for (int i = 0; i < text.length() && found != 0; i++) {
+            state = next[state * classCount + classOf(text.charAt(i))];
+            int match = best[state];
+            if (match != NO_MATCH && (found == NO_MATCH || match < found)) {
+                found = match;
+            }
+        }
+        return found != NO_MATCH ? offsets[found] : defaultTarget;
+    }
+
+    private int classOf(char c) {
+        char folded = Character.toLowerCase(c);
+        if (folded < 128) {
+            return asciiClasses[folded];
+        }
+        int index = Arrays.binarySearch(otherChars, folded);
+        return index >= 0 ? otherClasses[index] : 0;
+    }
+}
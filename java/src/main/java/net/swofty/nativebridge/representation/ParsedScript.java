@@ -0,0 +1,32 @@
+package net.swofty.nativebridge.representation;
+
+/**
+ * The commands and events produced by a single parse of a script
+ */
+public class ParsedScript {
+    private final Command[] commands;
+    private final Event[] events;
+    private final String[] diagnostics;
+
+    public ParsedScript(Command[] commands, Event[] events, String[] diagnostics) {
+        this.commands = commands;
+        this.events = events;
+        this.diagnostics = diagnostics;
+    }
+
+    public Command[] getCommands() {
+        return commands;
+    }
+
+    public Event[] getEvents() {
+        return events;
+    }
+
+    /**
+     * Notes from the native optimisation passes, such as how many unreachable
+     * statements were removed. Empty if the passes changed nothing.
+     */
+    public String[] getDiagnostics() {
+        return diagnostics;
+    }
+}
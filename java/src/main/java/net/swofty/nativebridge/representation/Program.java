@@ -0,0 +1,109 @@
+package net.swofty.nativebridge.representation;
+
+import net.swofty.nativebridge.CompiledHandler;
+import net.swofty.nativebridge.NativeEngine;
+
+import java.lang.ref.Cleaner;
+
+/**
+ * An execute block compiled to register bytecode by the native Compiler. The
+ * instruction set is documented in Bytecode.h; net.swofty.BytecodeInterpreter runs it.
+ */
+public class Program {
+    private static final Cleaner CLEANER = Cleaner.create();
+
+    private final int[] code;
+    private final Object[] constants;
+    private final int[] lines;
+    private final int registerCount;
+    private volatile long nativeHandle;
+    private volatile CompiledHandler handler;
+    private volatile Object[] propertySites;
+
+    /**
+     * @param code The instruction stream
+     * @param constants Constant pool entries: a String, a String[] property path, a SwitchTable
+     *                  or a MatchTable
+     * @param lines (code offset, source line) pairs, ordered by offset
+     * @param registerCount Frame size needed to run the code, slots included
+     */
+    public Program(int[] code, Object[] constants, int[] lines, int registerCount) {
+        this.code = code;
+        this.constants = constants;
+        this.lines = lines;
+        this.registerCount = registerCount;
+    }
+
+    public int[] getCode() {
+        return code;
+    }
+
+    public Object[] getConstants() {
+        return constants;
+    }
+
+    public int[] getLines() {
+        return lines;
+    }
+
+    public int getRegisterCount() {
+        return registerCount;
+    }
+
+    /**
+     * @return The JVM class generated for this program, or null if none has been defined
+     */
+    public CompiledHandler getHandler() {
+        return handler;
+    }
+
+    public void setHandler(CompiledHandler handler) {
+        this.handler = handler;
+    }
+
+    /**
+     * @return The interpreter's caches, one per path constant and per string a CONTAINS
+     * searches for, or null if not created yet
+     */
+    public Object[] getPropertySites() {
+        return propertySites;
+    }
+
+    public void setPropertySites(Object[] propertySites) {
+        this.propertySites = propertySites;
+    }
+
+    /**
+     * Get this program loaded into the native VM, loading it on first use. The native
+     * copy is freed once the program becomes unreachable.
+     * @return The handle to pass to NativeEngine.run
+     */
+    public long getNativeHandle() {
+        long handle = nativeHandle;
+        if (handle != 0) {
+            return handle;
+        }
+
+        synchronized (this) {
+            if (nativeHandle == 0) {
+                long loaded = NativeEngine.load(code, constants, lines, registerCount);
+                CLEANER.register(this, () -> NativeEngine.free(loaded));
+                nativeHandle = loaded;
+            }
+            return nativeHandle;
+        }
+    }
+
+    /**
+     * Find the source line an instruction was compiled from
+     * @param offset The code offset of the instruction
+     * @return The line, or 0 if unknown
+     */
+    public int lineAt(int offset) {
+        int line = 0;
+        for (int i = 0; i < lines.length && lines[i] <= offset; i += 2) {
+            line = lines[i + 1];
+        }
+        return line;
+    }
+}
@@ -0,0 +1,50 @@
+package net.swofty.nativebridge.representation;
+
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * The jump table of a SWITCH instruction: string labels and the code offset each one
+ * jumps to
+ */
+public class SwitchTable {
+    private final String[] labels;
+    private final int[] offsets;
+    private final Map<String, Integer> targets;
+
+    public SwitchTable(String[] labels, int[] targets) {
+        this.labels = labels;
+        this.offsets = targets;
+        this.targets = new HashMap<>(labels.length * 2);
+        for (int i = 0; i < labels.length; i++) {
+            this.targets.putIfAbsent(labels[i], targets[i]);
+        }
+    }
+
+    public String[] getLabels() {
+        return labels;
+    }
+
+    /**
+     * @return The jump target of each label, in label order
+     */
+    public int[] getTargets() {
+        return offsets;
+    }
+
+    /**
+     * Get the jump target for a value
+     * @param value The switch subject
+     * @param defaultTarget The offset to use if no label equals the value
+     * @return The code offset to continue at
+     */
+    public int target(Object value, int defaultTarget) {
+        if (value instanceof String) {
+            Integer target = targets.get(value);
+            if (target != null) {
+                return target;
+            }
+        }
+        return defaultTarget;
+    }
+}
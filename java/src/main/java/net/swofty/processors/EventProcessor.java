@@ -50,10 +50,8 @@ public class EventProcessor {
     }
 
     public void registerEvents() {
-        // Sort events by priority (lower numbers = higher priority)
-        events.sort((e1, e2) -> Integer.compare(e1.getPriority(), e2.getPriority()));
-        
-        // Register each event with the event system
+        // Register each event with the event system; each event type's dispatcher
+        // keeps its handlers in priority order (lower numbers = higher priority)
         for (Event event : events) {
             eventRegistrar.registerEvent(event);
         }
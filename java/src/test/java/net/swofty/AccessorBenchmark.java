@@ -0,0 +1,73 @@
+package net.swofty;
+
+import net.swofty.mapper.Accessors;
+
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.util.function.BiConsumer;
+import java.util.function.Function;
+
+/**
+ * Reads and writes one property of a script object every way the runtime has: a direct
+ * call, Method.invoke and Field.get as the reflection fallback used them, the callers
+ * Accessors generates in their place, and PropertyAccess, which resolves and caches
+ * those callers per class and name for the executors.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.AccessorBenchmark
+ */
+public final class AccessorBenchmark {
+    private static final int RUNS = 5_000_000;
+
+    /**
+     * An object with a public field, as some Minestom types expose their properties
+     */
+    public static class Point {
+        public double x = 1.5;
+    }
+
+    public static void main(String[] args) throws ReflectiveOperationException {
+        TestPlayer player = new TestPlayer("Steve");
+        Method username = TestPlayer.class.getMethod("getUsername");
+        Function<Object, Object> generated = Accessors.getter(username);
+        Timing.time("getter direct", RUNS, player::getUsername);
+        Timing.time("getter Method.invoke", RUNS, () -> invoke(username, player));
+        Timing.time("getter Accessors", RUNS, () -> generated.apply(player));
+        Timing.time("getter PropertyAccess", RUNS, () -> PropertyAccess.getter(TestPlayer.class, "username").get(player));
+
+        Point point = new Point();
+        Field x = Point.class.getField("x");
+        Function<Object, Object> generatedField = Accessors.getter(x);
+        Timing.time("field direct", RUNS, () -> point.x);
+        Timing.time("field Field.get", RUNS, () -> get(x, point));
+        Timing.time("field Accessors", RUNS, () -> generatedField.apply(point));
+
+        TestEvent event = new TestEvent(player, "hello");
+        Method setMessage = TestEvent.class.getMethod("setMessage", String.class);
+        BiConsumer<Object, Object> generatedSetter = Accessors.setter(setMessage);
+        Timing.time("setter direct", RUNS, () -> {
+            event.setMessage("hi");
+            return event;
+        });
+        Timing.time("setter Method.invoke", RUNS, () -> invoke(setMessage, event, "hi"));
+        Timing.time("setter Accessors", RUNS, () -> {
+            generatedSetter.accept(event, "hi");
+            return event;
+        });
+    }
+
+    private static Object invoke(Method method, Object target, Object... arguments) {
+        try {
+            return method.invoke(target, arguments);
+        } catch (ReflectiveOperationException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+
+    private static Object get(Field field, Object target) {
+        try {
+            return field.get(target);
+        } catch (IllegalAccessException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+}
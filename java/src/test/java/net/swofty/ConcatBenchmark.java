@@ -0,0 +1,57 @@
+package net.swofty;
+
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+
+/**
+ * Measures what a send of a concatenation chain allocates, for chains of more and more
+ * operands that build strings of nearly the same length. The native parser fuses a chain
+ * into one Concat node that is rendered into one presized StringBuilder, so the bytes per
+ * run should follow the length of the result, not the number of operands; left-nested
+ * concatenation would copy the growing prefix once per operand.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.ConcatBenchmark
+ */
+public final class ConcatBenchmark {
+    private static final int RUNS = 200_000;
+    private static final String[] EXECUTORS = {"bytecode", "tree", "jvm", "native"};
+    private static final String TEXT = "The quick brown fox jumps over the lazy dog, twice over.";
+
+    public static void main(String[] args) {
+        Scripts.loadLibrary();
+        for (int operands = 2; operands <= 32; operands *= 2) {
+            ExecuteBlock block = NativeParser.parseSwoftLangToEvents(
+                    "event PlayerChat {\n    execute {\n        send " + chain(operands) + "\n    }\n}\n")[0].getExecuteBlock();
+
+            RecordingSender sender = new RecordingSender("Steve");
+            for (String executorName : EXECUTORS) {
+                Timing.allocated(operands + " operands " + executorName, RUNS, () -> {
+                    sender.clear();
+                    ASTExecutor executor = ASTExecutor.acquire(sender);
+                    try {
+                        executor.useExecutor(executorName);
+                        executor.bind("message", "hi");
+                        executor.execute(block);
+                        return sender;
+                    } finally {
+                        executor.release();
+                    }
+                });
+            }
+        }
+    }
+
+    /**
+     * message + "piece" + message + "piece" ..., with TEXT split over the pieces so
+     * constants never sit next to each other and cannot be folded together
+     */
+    private static String chain(int operands) {
+        int pieces = operands / 2;
+        StringBuilder chain = new StringBuilder();
+        for (int i = 0; i < pieces; i++) {
+            String piece = TEXT.substring(i * TEXT.length() / pieces, (i + 1) * TEXT.length() / pieces);
+            chain.append(i == 0 ? "" : " + ").append("message + \"").append(piece).append('"');
+        }
+        return chain.toString();
+    }
+}
@@ -0,0 +1,142 @@
+package net.swofty;
+
+import net.minestom.server.MinecraftServer;
+import net.minestom.server.coordinate.Pos;
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.Command;
+import net.swofty.nativebridge.representation.Event;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+import net.swofty.nativebridge.representation.Program;
+import org.junit.jupiter.api.BeforeAll;
+import org.junit.jupiter.api.DynamicTest;
+import org.junit.jupiter.api.TestFactory;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.function.Consumer;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNotEquals;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+
+/**
+ * Runs every handler of the sample scripts with each executor - the bytecode interpreter,
+ * the linked tree, the generated JVM classes and the native VM - on a range of inputs,
+ * and checks they all send the same messages, cancel the same events, write the same
+ * properties and halt in the same places.
+ */
+class ExecutorDifferentialTest {
+    private static final String[] EXECUTORS = {"bytecode", "tree", "jvm", "native"};
+
+    private static final String[] MESSAGES = {
+        "", "hello", "a", "b", "c", "hers", "x marks y", "no badword here", "SPAM", "ItS SpAm",
+        "Évian", "STRASSE", "Straße", "σοφία", "ΣΟΦΊΑ", "\u212Aelvin HERS", "\u0130X Y", "1.5",
+    };
+
+    private static final Object[] ARGUMENTS = {null, "text", new Pos(1, 2, 3), new TestPlayer("Alex")};
+
+    /**
+     * What one run did, compared between executors
+     */
+    private record Outcome(List<String> messages, int cancels, String message, boolean halted, String failure) {
+    }
+
+    @BeforeAll
+    static void setUp() {
+        Scripts.loadLibrary();
+        MinecraftServer.init(); // "send to all" looks up the online players
+    }
+
+    @TestFactory
+    List<DynamicTest> executorsAgree() {
+        Map<String, String> scripts = new LinkedHashMap<>(Scripts.all());
+        scripts.put("differential.sw", Scripts.resource("differential.sw"));
+
+        List<DynamicTest> tests = new ArrayList<>();
+        for (Map.Entry<String, String> script : scripts.entrySet()) {
+            Event[] events = NativeParser.parseSwoftLangToEvents(script.getValue());
+            for (int i = 0; i < events.length; i++) {
+                Event event = events[i];
+                String name = script.getKey() + " event " + event.getName() + " #" + i;
+                tests.add(DynamicTest.dynamicTest(name, () -> {
+                    for (String message : MESSAGES) {
+                        compare(name + " \"" + message + "\"", event.getExecuteBlock(), executor -> {
+                            TestEvent fixture = new TestEvent(new TestPlayer("Steve"), message);
+                            executor.bind("event", fixture);
+                            executor.bind("player", fixture.getPlayer());
+                            executor.bind("message", message);
+                        });
+                    }
+                }));
+            }
+
+            for (Command command : NativeParser.parseSwoftLangToCommands(script.getValue())) {
+                String name = script.getKey() + " command " + command.getName();
+                tests.add(DynamicTest.dynamicTest(name, () -> {
+                    for (List<Object> values : argumentCombinations(command.getArguments().size())) {
+                        compare(name + " " + values, command.getExecuteBlock(), executor -> {
+                            for (int i = 0; i < values.size(); i++) {
+                                executor.bind(command.getArguments().get(i).getName(), values.get(i));
+                            }
+                        });
+                    }
+                }));
+            }
+        }
+        return tests;
+    }
+
+    private static void compare(String label, ExecuteBlock block, Consumer<ASTExecutor> bind) {
+        assertNotNull(block, label);
+        Program program = block.getProgram();
+        assertNotNull(program, label + ": not compiled");
+        // The executors fall back to the interpreter silently; make sure each really runs
+        assertNotNull(HandlerClasses.get(program, block.getSlotNames().length), label + ": no JVM class");
+        assertNotEquals(0L, program.getNativeHandle(), label + ": not loaded into the native VM");
+
+        Outcome expected = run(EXECUTORS[0], block, bind);
+        for (int i = 1; i < EXECUTORS.length; i++) {
+            assertEquals(expected, run(EXECUTORS[i], block, bind), label + ": " + EXECUTORS[i] + " against " + EXECUTORS[0]);
+        }
+    }
+
+    private static Outcome run(String executorName, ExecuteBlock block, Consumer<ASTExecutor> bind) {
+        RecordingSender sender = new RecordingSender("Steve");
+        ASTExecutor executor = ASTExecutor.acquire(sender);
+        try {
+            executor.useExecutor(executorName);
+            bind.accept(executor);
+            String failure = null;
+            try {
+                executor.execute(block);
+            } catch (RuntimeException e) {
+                failure = e.getClass().getName() + ": " + e.getMessage();
+            }
+            Object event = executor.getVariable("event");
+            TestEvent fixture = event instanceof TestEvent ? (TestEvent) event : null;
+            return new Outcome(List.copyOf(sender.getMessages()), fixture != null ? fixture.getCancels() : 0,
+                    fixture != null ? fixture.getMessage() : null, executor.isHalted(), failure);
+        } finally {
+            executor.release();
+        }
+    }
+
+    private static List<List<Object>> argumentCombinations(int count) {
+        List<List<Object>> combinations = new ArrayList<>();
+        combinations.add(new ArrayList<>());
+        for (int i = 0; i < count; i++) {
+            List<List<Object>> longer = new ArrayList<>();
+            for (List<Object> combination : combinations) {
+                for (Object value : ARGUMENTS) {
+                    List<Object> next = new ArrayList<>(combination);
+                    next.add(value);
+                    longer.add(next);
+                }
+            }
+            combinations = longer;
+        }
+        return combinations;
+    }
+}
@@ -0,0 +1,66 @@
+package net.swofty;
+
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+
+/**
+ * Times CONTAINS on a chat line and on a long book text, for a needle that is absent and
+ * so has to be searched for through the whole text. The search is timed on its own three
+ * ways - lowered copies of both strings, as CONTAINS used to do, FoldedNeedle with a
+ * needle known only at runtime, and FoldedNeedle with the needle lowered in advance as
+ * it is for a string literal - and then as a script with each executor, which includes
+ * the cost of the handler around it.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.FoldedNeedleBenchmark
+ */
+public final class FoldedNeedleBenchmark {
+    private static final int RUNS = 200_000;
+    private static final String[] EXECUTORS = {"bytecode", "tree", "jvm", "native"};
+    private static final String NEEDLE = "Discord Server";
+    private static final String CHAT = "Anyone Selling Diamond Pickaxes? Meet Me At Spawn In 5 Mins";
+    private static final String PAGE = book(4096);
+
+    public static void main(String[] args) {
+        Scripts.loadLibrary();
+        ExecuteBlock block = NativeParser.parseSwoftLangToEvents(
+                "event PlayerChat {\n    execute {\n        if message contains \"" + NEEDLE + "\" {\n"
+                        + "            send \"found\"\n        }\n    }\n}\n")[0].getExecuteBlock();
+        FoldedNeedle literal = new FoldedNeedle(NEEDLE);
+
+        for (String text : new String[] {CHAT, PAGE}) {
+            String size = text.length() + " chars, ";
+            Timing.time(size + "lowered copies", RUNS, () -> text.toLowerCase().contains(NEEDLE.toLowerCase()));
+            Timing.time(size + "FoldedNeedle.contains", RUNS, () -> FoldedNeedle.contains(text, NEEDLE));
+            Timing.time(size + "FoldedNeedle literal", RUNS, () -> literal.foundIn(text));
+            Timing.allocated(size + "lowered copies", RUNS, () -> text.toLowerCase().contains(NEEDLE.toLowerCase()));
+            Timing.allocated(size + "FoldedNeedle literal", RUNS, () -> literal.foundIn(text));
+
+            RecordingSender sender = new RecordingSender("Steve");
+            for (String executorName : EXECUTORS) {
+                Timing.time(size + executorName, RUNS, () -> {
+                    ASTExecutor executor = ASTExecutor.acquire(sender);
+                    try {
+                        executor.useExecutor(executorName);
+                        executor.bind("message", text);
+                        executor.execute(block);
+                        return sender;
+                    } finally {
+                        executor.release();
+                    }
+                });
+            }
+        }
+    }
+
+    /**
+     * Mixed-case prose of about the given length, as a written book holds
+     */
+    private static String book(int length) {
+        String sentence = "The Old Mill By The River Was Rebuilt After The Flood Of The Third Winter. ";
+        StringBuilder text = new StringBuilder(length + sentence.length());
+        while (text.length() < length) {
+            text.append(sentence);
+        }
+        return text.toString();
+    }
+}
@@ -0,0 +1,81 @@
+package net.swofty;
+
+import net.minestom.server.MinecraftServer;
+import net.minestom.server.coordinate.Pos;
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.Command;
+import net.swofty.nativebridge.representation.Event;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.function.Consumer;
+
+/**
+ * Runs every handler of the sample scripts with each executor and prints the time per
+ * run: the bytecode interpreter, the linked statement tree, the JVM classes generated
+ * from the bytecode and the native VM. The handlers of differential.sw are run as well;
+ * between them they use every statement and operator, so every kind of tree node is
+ * timed, not only those the samples happen to use. Events run against a chat message that is let
+ * through and one that is blocked; commands against a player and a location, which a
+ * TestPlayer is not, so "teleport" takes its early halt.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.HandlerBenchmark
+ */
+public final class HandlerBenchmark {
+    private static final int RUNS = 200_000;
+    private static final String[] EXECUTORS = {"bytecode", "tree", "jvm", "native"};
+    private static final String[] MESSAGES = {"hello", "this has a badword in it"};
+
+    public static void main(String[] args) {
+        Scripts.loadLibrary();
+        MinecraftServer.init(); // "send to all" looks up the online players
+
+        Map<String, String> scripts = new LinkedHashMap<>(Scripts.all());
+        scripts.put("differential.sw", Scripts.resource("differential.sw"));
+        for (Map.Entry<String, String> script : scripts.entrySet()) {
+            for (Event event : NativeParser.parseSwoftLangToEvents(script.getValue())) {
+                for (String message : MESSAGES) {
+                    TestEvent fixture = new TestEvent(new TestPlayer("Steve"), message);
+                    compare(script.getKey() + " " + event.getName() + " \"" + message + "\"", event.getExecuteBlock(), executor -> {
+                        fixture.setMessage(message); // the chat handler rewrites it
+                        executor.bind("event", fixture);
+                        executor.bind("player", fixture.getPlayer());
+                        executor.bind("message", message);
+                    });
+                }
+            }
+
+            for (Command command : NativeParser.parseSwoftLangToCommands(script.getValue())) {
+                Object[] values = {new TestPlayer("Alex"), new Pos(1, 2, 3)};
+                compare(script.getKey() + " " + command.getName(), command.getExecuteBlock(), executor -> {
+                    for (int i = 0; i < command.getArguments().size(); i++) {
+                        executor.bind(command.getArguments().get(i).getName(), values[i % values.length]);
+                    }
+                });
+            }
+        }
+    }
+
+    private static void compare(String label, ExecuteBlock block, Consumer<ASTExecutor> bind) {
+        RecordingSender sender = new RecordingSender("Steve");
+        double[] nanos = new double[EXECUTORS.length];
+        for (int i = 0; i < EXECUTORS.length; i++) {
+            String executorName = EXECUTORS[i];
+            nanos[i] = Timing.time(label + " " + executorName, RUNS, () -> {
+                sender.clear();
+                ASTExecutor executor = ASTExecutor.acquire(sender);
+                try {
+                    executor.useExecutor(executorName);
+                    bind.accept(executor);
+                    executor.execute(block);
+                    return executor.isHalted();
+                } finally {
+                    executor.release();
+                }
+            });
+        }
+        // The linked tree against the bytecode interpreter on the same handler and input
+        System.out.printf("%-48s %12.2f x bytecode%n", label + " tree", nanos[1] / nanos[0]);
+    }
+}
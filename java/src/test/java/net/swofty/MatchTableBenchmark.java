@@ -0,0 +1,108 @@
+package net.swofty;
+
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.ExecuteBlock;
+import net.swofty.nativebridge.representation.MatchTable;
+
+import java.util.Arrays;
+
+/**
+ * Times a moderation filter of hundreds of banned phrases over a set of chat lines: a
+ * CONTAINS per phrase, as an else-if chain used to run, against one MatchTable pass. The
+ * same chain is then run as a script with each executor; the native compiler turns it
+ * into a single MATCH.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.MatchTableBenchmark
+ */
+public final class MatchTableBenchmark {
+    private static final int RUNS = 200_000;
+    private static final String[] EXECUTORS = {"bytecode", "tree", "jvm", "native"};
+    private static final String[] FIRSTS = {"free", "cheap", "buy", "sell", "join", "visit", "click", "get", "win",
+            "best", "hack", "dupe", "fly", "kill", "grief", "spam", "scam", "trade", "rank", "op"};
+    private static final String[] SECONDS = {"diamonds", "gold", "netherite", "elytra", "ranks", "coins", "accounts",
+            "server", "discord", "client", "mods", "items", "keys", "spawners", "beacons", "totems", "shulkers",
+            "emeralds", "cash", "gems"};
+    // Chat lines of the length players type, two of them holding a phrase
+    private static final String[] LINES = {
+            "Anyone Selling Diamond Pickaxes? Meet Me At Spawn In 5 Mins",
+            "gg everyone, that was a close one",
+            "Does anybody know where the nearest village is?",
+            "LOL my house just burned down again",
+            "Click here for FREE DIAMONDS at example dot com",
+            "Trading two stacks of iron for a mending book",
+            "who wants to start a new town by the river",
+            "brb dinner",
+            "How do I get to the End? I have 12 eyes",
+            "Is the nether hub connected to the ice road yet",
+            "thanks for the help earlier, the farm works now",
+            "Join our Discord Server for giveaways every week",
+            "Can someone tp me back to base please",
+            "Why is the creeper farm not spawning anything",
+            "Good morning from the other side of the world",
+            "Lag is really bad today, is the server OK?",
+    };
+
+    public static void main(String[] args) {
+        Scripts.loadLibrary();
+        String[] phrases = phrases();
+        for (int count : new int[] {10, 100, phrases.length}) {
+            String[] some = Arrays.copyOf(phrases, count);
+            FoldedNeedle[] needles = new FoldedNeedle[count];
+            Arrays.setAll(needles, i -> new FoldedNeedle(some[i]));
+            MatchTable table = MatchTableTest.table(some);
+            String label = count + " phrases, ";
+
+            int[] line = {0};
+            Timing.time(label + "CONTAINS per phrase", RUNS, () -> {
+                String text = LINES[line[0]++ % LINES.length];
+                for (int i = 0; i < needles.length; i++) {
+                    if (needles[i].foundIn(text)) {
+                        return i;
+                    }
+                }
+                return -1;
+            });
+            Timing.time(label + "MatchTable", RUNS, () -> table.target(LINES[line[0]++ % LINES.length], -1));
+
+            ExecuteBlock block = NativeParser.parseSwoftLangToEvents(chain(some))[0].getExecuteBlock();
+            RecordingSender sender = new RecordingSender("Steve");
+            for (String executorName : EXECUTORS) {
+                Timing.time(label + executorName, RUNS, () -> {
+                    sender.clear();
+                    ASTExecutor executor = ASTExecutor.acquire(sender);
+                    try {
+                        executor.useExecutor(executorName);
+                        executor.bind("message", LINES[line[0]++ % LINES.length]);
+                        executor.execute(block);
+                        return sender;
+                    } finally {
+                        executor.release();
+                    }
+                });
+            }
+        }
+    }
+
+    /**
+     * Every pairing of a first and a second word, as a banned list
+     */
+    private static String[] phrases() {
+        String[] phrases = new String[FIRSTS.length * SECONDS.length];
+        for (int i = 0; i < phrases.length; i++) {
+            phrases[i] = FIRSTS[i / SECONDS.length] + " " + SECONDS[i % SECONDS.length];
+        }
+        return phrases;
+    }
+
+    /**
+     * A handler that tests the message against each phrase in turn
+     */
+    private static String chain(String[] phrases) {
+        StringBuilder body = new StringBuilder("event PlayerChat {\n    execute {\n");
+        for (int i = 0; i < phrases.length; i++) {
+            body.append(i == 0 ? "        if" : "        } else if").append(" message contains \"")
+                    .append(phrases[i]).append("\" {\n            send \"blocked\"\n");
+        }
+        return body.append("        }\n    }\n}\n").toString();
+    }
+}
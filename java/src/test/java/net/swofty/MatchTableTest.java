@@ -0,0 +1,82 @@
+package net.swofty;
+
+import net.swofty.nativebridge.representation.MatchTable;
+import org.junit.jupiter.api.Test;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Random;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+
+/**
+ * Checks that a MATCH finds what the chain of CONTAINS checks it replaces would: the
+ * first pattern, in order, that the text contains ignoring case, however the patterns
+ * overlap and whatever case the text is in
+ */
+class MatchTableTest {
+    private static final int NONE = -1;
+
+    // Overlapping, sharing prefixes and suffixes, nested in each other, differing in case
+    private static final String[] PATTERNS = {
+            "hers", "HE", "she", "his", "s", "bAdWoRd", "badword", "word", "Été", "straße", "",
+    };
+    private static final String[] FRAGMENTS = {
+            "h", "H", "e", "E", "r", "s", "S", "i", "BAD", "bad", "Wor", "WORD", "d", " ", "x",
+            "É", "é", "t", "T", "STRA", "ß", "ẞ", "K", "Σ",
+    };
+
+    @Test
+    void matchesTheFirstContainedPattern() {
+        Random random = new Random(48);
+        for (int skip = 0; skip < PATTERNS.length; skip++) {
+            // Every pattern but one, so the empty pattern does not always win
+            List<String> used = new ArrayList<>();
+            for (int i = 0; i < PATTERNS.length; i++) {
+                if (i != skip && !PATTERNS[i].isEmpty()) {
+                    used.add(PATTERNS[i]);
+                }
+            }
+            String[] patterns = used.toArray(new String[0]);
+            MatchTable table = table(patterns);
+            for (int run = 0; run < 2000; run++) {
+                StringBuilder text = new StringBuilder();
+                for (int length = random.nextInt(12); length > 0; length--) {
+                    text.append(FRAGMENTS[random.nextInt(FRAGMENTS.length)]);
+                }
+                assertEquals(firstContained(patterns, text.toString()), table.target(text.toString(), NONE),
+                        () -> "\"" + text + "\" against " + Arrays.toString(patterns));
+            }
+        }
+    }
+
+    @Test
+    void emptyPatternMatchesWhenNothingEarlierDoes() {
+        MatchTable table = table(PATTERNS);
+        assertEquals(0, table.target("USHERS", NONE));
+        assertEquals(1, table.target("ushe", NONE));
+        assertEquals(PATTERNS.length - 1, table.target("xyz", NONE));
+    }
+
+    /**
+     * A table whose targets are the pattern indexes
+     */
+    static MatchTable table(String[] patterns) {
+        int[] targets = new int[patterns.length];
+        Arrays.setAll(targets, i -> i);
+        return new MatchTable(patterns, targets);
+    }
+
+    /**
+     * What a chain of CONTAINS checks finds
+     */
+    static int firstContained(String[] patterns, String text) {
+        for (int i = 0; i < patterns.length; i++) {
+            if (FoldedNeedle.contains(text, patterns[i])) {
+                return i;
+            }
+        }
+        return NONE;
+    }
+}
@@ -0,0 +1,53 @@
+package net.swofty;
+
+import net.kyori.adventure.identity.Identity;
+import net.minestom.server.command.CommandSender;
+import net.minestom.server.tag.TagHandler;
+import org.jetbrains.annotations.NotNull;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * A sender that keeps the messages sent to it, for tests that compare what handlers do
+ */
+public class RecordingSender implements CommandSender {
+    private final String name;
+    private final TagHandler tags = TagHandler.newHandler();
+    private final List<String> messages = new ArrayList<>();
+
+    public RecordingSender(String name) {
+        this.name = name;
+    }
+
+    @Override
+    public void sendMessage(@NotNull String message) {
+        messages.add(message);
+    }
+
+    public List<String> getMessages() {
+        return messages;
+    }
+
+    /**
+     * Forget the messages sent so far, for benchmarks that reuse one sender
+     */
+    public void clear() {
+        messages.clear();
+    }
+
+    @Override
+    public @NotNull Identity identity() {
+        return Identity.nil();
+    }
+
+    @Override
+    public @NotNull TagHandler tagHandler() {
+        return tags;
+    }
+
+    @Override
+    public String toString() {
+        return name;
+    }
+}
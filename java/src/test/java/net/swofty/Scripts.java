@@ -0,0 +1,63 @@
+package net.swofty;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.UncheckedIOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.stream.Stream;
+
+/**
+ * The sample scripts tests and benchmarks run against, and the native library they need
+ */
+public final class Scripts {
+    private Scripts() {
+    }
+
+    /**
+     * Load the SwoftLang library the way the server does
+     */
+    public static void loadLibrary() {
+        try {
+            Class.forName(LibraryLoader.class.getName(), true, Scripts.class.getClassLoader());
+        } catch (ClassNotFoundException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+
+    /**
+     * @return Every .sw file in the scripts directory (-Dswoftlang.scripts), by file name
+     */
+    public static Map<String, String> all() {
+        Path directory = Path.of(System.getProperty("swoftlang.scripts", "../scripts"));
+        Map<String, String> scripts = new LinkedHashMap<>();
+        try (Stream<Path> paths = Files.list(directory)) {
+            for (Path path : paths.filter(p -> p.toString().endsWith(".sw")).sorted().toList()) {
+                scripts.put(path.getFileName().toString(), Files.readString(path));
+            }
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+        if (scripts.isEmpty()) {
+            throw new IllegalStateException("No scripts in " + directory.toAbsolutePath());
+        }
+        return scripts;
+    }
+
+    /**
+     * @return A script kept with the tests, under src/test/resources/scripts
+     */
+    public static String resource(String name) {
+        try (InputStream in = Scripts.class.getResourceAsStream("/scripts/" + name)) {
+            if (in == null) {
+                throw new IllegalStateException("No test script " + name);
+            }
+            return new String(in.readAllBytes(), StandardCharsets.UTF_8);
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+    }
+}
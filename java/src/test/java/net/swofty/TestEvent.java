@@ -0,0 +1,36 @@
+package net.swofty;
+
+/**
+ * The properties of a chat or join event as scripts see them, recording what handlers
+ * do to it
+ */
+public class TestEvent {
+    private final TestPlayer player;
+    private String message;
+    private int cancels;
+
+    public TestEvent(TestPlayer player, String message) {
+        this.player = player;
+        this.message = message;
+    }
+
+    public TestPlayer getPlayer() {
+        return player;
+    }
+
+    public String getMessage() {
+        return message;
+    }
+
+    public void setMessage(String message) {
+        this.message = message;
+    }
+
+    public void cancel() {
+        cancels++;
+    }
+
+    public int getCancels() {
+        return cancels;
+    }
+}
@@ -0,0 +1,44 @@
+package net.swofty;
+
+/**
+ * Stands in for a player in handler tests: the properties scripts read from a player,
+ * without a connection. Scripts see it as a plain object, not a Player, so type checks
+ * and sends to it take their non-player paths, the same in every executor.
+ */
+public class TestPlayer {
+    private final String username;
+
+    public TestPlayer(String username) {
+        this.username = username;
+    }
+
+    public String getUsername() {
+        return username;
+    }
+
+    public Name getName() {
+        return new Name(username);
+    }
+
+    @Override
+    public String toString() {
+        return username;
+    }
+
+    public static class Name {
+        private final String content;
+
+        Name(String content) {
+            this.content = content;
+        }
+
+        public String getContent() {
+            return content;
+        }
+
+        @Override
+        public String toString() {
+            return content;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+package net.swofty;
+
+/**
+ * A minimal timing loop for the benchmarks under src/test/java: the operation is run
+ * untimed until the JIT has settled, then timed over a fixed number of runs. The numbers
+ * are for comparing paths against each other on one machine, not absolute figures.
+ * Allocation is measured the same way, from the bytes the JVM counts for this thread.
+ */
+public final class Timing {
+    private static volatile Object sink;
+
+    private Timing() {
+    }
+
+    /**
+     * Time an operation and print the result
+     * @param label What to print the time under
+     * @param runs How many timed runs to average over; as many again are run first to warm up
+     * @param operation The work to time; its result is kept so it cannot be optimised away
+     * @return Nanoseconds per run
+     */
+    public static double time(String label, int runs, java.util.function.Supplier<?> operation) {
+        for (int i = 0; i < runs; i++) {
+            sink = operation.get();
+        }
+        long start = System.nanoTime();
+        for (int i = 0; i < runs; i++) {
+            sink = operation.get();
+        }
+        double perRun = (System.nanoTime() - start) / (double) runs;
+        System.out.printf("%-48s %12.1f ns/run%n", label, perRun);
+        return perRun;
+    }
+
+    /**
+     * Measure the heap an operation allocates and print the result
+     * @param label What to print the figure under
+     * @param runs How many measured runs to average over; as many again are run first to warm up
+     * @param operation The work to measure; it must run on the calling thread
+     * @return Bytes allocated per run
+     */
+    public static double allocated(String label, int runs, java.util.function.Supplier<?> operation) {
+        com.sun.management.ThreadMXBean threads =
+                (com.sun.management.ThreadMXBean) java.lang.management.ManagementFactory.getThreadMXBean();
+        for (int i = 0; i < runs; i++) {
+            sink = operation.get();
+        }
+        long before = threads.getCurrentThreadAllocatedBytes();
+        for (int i = 0; i < runs; i++) {
+            sink = operation.get();
+        }
+        double perRun = (threads.getCurrentThreadAllocatedBytes() - before) / (double) runs;
+        System.out.printf("%-48s %12.1f B/run%n", label, perRun);
+        return perRun;
+    }
+}
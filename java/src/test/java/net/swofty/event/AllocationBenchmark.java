@@ -0,0 +1,91 @@
+package net.swofty.event;
+
+import net.swofty.ASTExecutor;
+import net.swofty.RecordingSender;
+import net.swofty.Scripts;
+import net.swofty.Timing;
+import net.swofty.command.MinestomSenderAdapter;
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.Command;
+import net.swofty.nativebridge.representation.Event;
+
+import java.util.Set;
+
+/**
+ * Measures what handlers allocate once warm, on the paths the server runs them by: an
+ * event through EventDispatcher, which creates one wrapper per event, and through a
+ * wrapper's execute() alone; and a command the way MinestomCommandRegistrar runs it,
+ * with the sender adapter kept on the sender and a pooled executor. The handlers
+ * here build no strings, so anything they allocate is the runtime's own. The executor
+ * is the one -Dswoftlang.executor selects.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.event.AllocationBenchmark
+ */
+public final class AllocationBenchmark {
+    private static final int RUNS = 1_000_000;
+
+    private static final String SCRIPT = """
+            event PlayerChat {
+                execute {
+                    if event.message contains "badword" {
+                        send "<red>Your message was blocked!"
+                        cancel event
+                    }
+                }
+            }
+
+            command "check" {
+                arguments {
+                    word: String
+                }
+
+                execute {
+                    if args.word contains "yes" {
+                        send "<green>Checked"
+                    }
+                }
+            }
+            """;
+
+    public static void main(String[] args) {
+        Scripts.loadLibrary();
+        Event handler = NativeParser.parseSwoftLangToEvents(SCRIPT)[0];
+        Command command = NativeParser.parseSwoftLangToCommands(SCRIPT)[0];
+        RecordingSender sender = new RecordingSender("Steve");
+
+        // The dispatcher creates a wrapper per event; measure the run with and without it
+        Event[] handlers = {handler};
+        Set<String> accessed = AbstractSwoftEvent.accessedNames(handlers);
+        EventDispatcher dispatcher = new EventDispatcher(
+                (minestomEvent, swoftEvent) -> new TestChatWrapper((TestChatEvent) minestomEvent, swoftEvent),
+                false);
+        dispatcher.addHandler(handler);
+        for (String message : new String[] {"hello", "a badword"}) {
+            TestChatEvent event = new TestChatEvent(sender, message);
+            TestChatWrapper wrapper = new TestChatWrapper(event, handler);
+            Timing.allocated("event execute \"" + message + "\"", RUNS, () -> {
+                sender.clear();
+                return wrapper.execute(handlers, accessed, false);
+            });
+            Timing.allocated("event dispatch \"" + message + "\"", RUNS, () -> {
+                sender.clear();
+                dispatcher.dispatch(event);
+                return event;
+            });
+        }
+
+        for (String word : new String[] {"no", "yes"}) {
+            Timing.allocated("command \"" + word + "\"", RUNS, () -> {
+                sender.clear();
+                ASTExecutor executor = ASTExecutor.acquire(MinestomSenderAdapter.of(sender));
+                try {
+                    executor.bind(command.getArguments().get(0).getName(), word);
+                    executor.execute(command.getExecuteBlock());
+                    return sender;
+                } finally {
+                    executor.release();
+                }
+            });
+        }
+    }
+}
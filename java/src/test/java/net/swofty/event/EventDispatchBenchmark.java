@@ -0,0 +1,68 @@
+package net.swofty.event;
+
+import net.swofty.RecordingSender;
+import net.swofty.Scripts;
+import net.swofty.Timing;
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.Event;
+
+import java.util.concurrent.CountDownLatch;
+
+/**
+ * Times what a chat event costs the thread that dispatches it - the tick thread on a
+ * server - with every handler run there and with the read-only ones moved to an off-tick
+ * lane. The async figure includes reading the snapshot those handlers are given, not
+ * their run, which the lane does afterwards.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.event.EventDispatchBenchmark
+ */
+public final class EventDispatchBenchmark {
+    private static final int RUNS = 50_000;
+
+    private static final String SCRIPT = """
+            event PlayerChat {
+                execute {
+                    if event.message contains "badword" {
+                        cancel event
+                    }
+                }
+            }
+
+            event PlayerChat {
+                execute {
+                    if event.message contains "help" {
+                        send "<yellow>Try /help"
+                    } else if event.message contains "shop" || event.message contains "buy" {
+                        send "<green>The shop is at spawn"
+                    } else if event.message contains "discord" {
+                        send "<blue>Join us at example.com/discord"
+                    }
+                    send "[${event.message}]"
+                }
+            }
+            """;
+
+    public static void main(String[] args) throws InterruptedException {
+        Scripts.loadLibrary();
+        Event[] events = NativeParser.parseSwoftLangToEvents(SCRIPT);
+        for (boolean async : new boolean[] {false, true}) {
+            EventDispatcher dispatcher = new EventDispatcher(
+                    (minestomEvent, swoftEvent) -> new TestChatWrapper((TestChatEvent) minestomEvent, swoftEvent),
+                    async);
+            for (Event event : events) {
+                dispatcher.addHandler(event);
+            }
+
+            RecordingSender sender = new RecordingSender("Steve");
+            Timing.time(async ? "dispatch, read-only handlers off tick" : "dispatch, every handler on tick", RUNS, () -> {
+                dispatcher.dispatch(new TestChatEvent(sender, "where can I buy a sword"));
+                return sender;
+            });
+
+            // Let the lane finish before the next dispatcher is timed
+            CountDownLatch done = new CountDownLatch(1);
+            OffTickExecutor.submit(sender, done::countDown);
+            done.await();
+        }
+    }
+}
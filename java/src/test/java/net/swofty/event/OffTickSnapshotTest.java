@@ -0,0 +1,87 @@
+package net.swofty.event;
+
+import net.swofty.RecordingSender;
+import net.swofty.Scripts;
+import net.swofty.nativebridge.NativeParser;
+import net.swofty.nativebridge.representation.Event;
+import org.junit.jupiter.api.BeforeAll;
+import org.junit.jupiter.api.Test;
+
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+/**
+ * Checks that read-only handlers run off the event thread see the event as it was when
+ * the dispatcher returned, not as it is when their lane gets to them
+ */
+class OffTickSnapshotTest {
+    private static final String SCRIPT = """
+            event PlayerChat {
+                execute {
+                    set event.message to "${event.message}!"
+                }
+            }
+
+            event PlayerChat {
+                execute {
+                    send "event ${event.message}, variable ${message}"
+                }
+            }
+            """;
+
+    @BeforeAll
+    static void setUp() {
+        Scripts.loadLibrary();
+    }
+
+    @Test
+    void offTickHandlersSeeTheEventAsDispatched() throws InterruptedException {
+        EventDispatcher dispatcher = dispatcher(true);
+        RecordingSender sender = new RecordingSender("Steve");
+        TestChatEvent event = new TestChatEvent(sender, "hello");
+
+        // Hold the lane so the handler can only run after the event has changed again
+        CountDownLatch gate = new CountDownLatch(1);
+        OffTickExecutor.submit(sender, () -> awaitQuietly(gate));
+        dispatcher.dispatch(event);
+        event.setMessage("changed by a later listener");
+        gate.countDown();
+        drain(sender);
+
+        assertEquals(List.of("event hello!, variable hello!"), sender.getMessages());
+    }
+
+    static EventDispatcher dispatcher(boolean async) {
+        Event[] events = NativeParser.parseSwoftLangToEvents(SCRIPT);
+        assertTrue(events[1].getExecuteBlock().isReadOnly());
+
+        EventDispatcher dispatcher = new EventDispatcher(
+                (minestomEvent, swoftEvent) -> new TestChatWrapper((TestChatEvent) minestomEvent, swoftEvent),
+                async);
+        for (Event event : events) {
+            dispatcher.addHandler(event);
+        }
+        return dispatcher;
+    }
+
+    /**
+     * Wait until everything queued on a key's lane so far has run
+     */
+    static void drain(Object key) throws InterruptedException {
+        CountDownLatch done = new CountDownLatch(1);
+        OffTickExecutor.submit(key, done::countDown);
+        assertTrue(done.await(10, TimeUnit.SECONDS), "the off-tick lane did not finish");
+    }
+
+    private static void awaitQuietly(CountDownLatch latch) {
+        try {
+            latch.await(10, TimeUnit.SECONDS);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+}
@@ -0,0 +1,30 @@
+package net.swofty.event;
+
+import net.minestom.server.command.CommandSender;
+import net.minestom.server.event.Event;
+
+/**
+ * A Minestom event for dispatcher tests: a chat message that can still change after
+ * the dispatcher has returned, as later listeners can change a real one
+ */
+public class TestChatEvent implements Event {
+    private final CommandSender sender;
+    private String message;
+
+    public TestChatEvent(CommandSender sender, String message) {
+        this.sender = sender;
+        this.message = message;
+    }
+
+    public CommandSender getSender() {
+        return sender;
+    }
+
+    public String getMessage() {
+        return message;
+    }
+
+    public void setMessage(String message) {
+        this.message = message;
+    }
+}
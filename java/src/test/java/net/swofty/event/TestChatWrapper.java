@@ -0,0 +1,35 @@
+package net.swofty.event;
+
+import net.minestom.server.command.CommandSender;
+import net.swofty.ASTExecutor;
+import net.swofty.nativebridge.representation.Event;
+
+/**
+ * Wraps a TestChatEvent as SwoftPlayerChatEvent wraps a chat event, reading the message
+ * from the event each time it is asked for
+ */
+public class TestChatWrapper extends AbstractSwoftEvent<TestChatEvent> {
+    public TestChatWrapper(TestChatEvent minestomEvent, Event swoftEvent) {
+        super(minestomEvent, swoftEvent);
+    }
+
+    @Override
+    public CommandSender getSender() {
+        return minestomEvent.getSender();
+    }
+
+    @Override
+    protected void addCustomVariables(ASTExecutor executor) {
+        if (isAccessed("message")) {
+            executor.bind("message", getMessage());
+        }
+    }
+
+    public String getMessage() {
+        return minestomEvent.getMessage();
+    }
+
+    public void setMessage(String message) {
+        minestomEvent.setMessage(message);
+    }
+}
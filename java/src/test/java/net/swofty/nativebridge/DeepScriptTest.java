@@ -0,0 +1,90 @@
+package net.swofty.nativebridge;
+
+import net.swofty.Scripts;
+import net.swofty.nativebridge.representation.Event;
+import org.junit.jupiter.api.BeforeAll;
+import org.junit.jupiter.api.Test;
+
+import java.util.concurrent.atomic.AtomicReference;
+import java.util.function.Supplier;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+
+/**
+ * Scripts at the parser's limits, parsed through JNI so the result is built by
+ * AstMarshaller: a 10,000-branch else-if chain and blocks nested to the 256-level cap, on
+ * a thread with a 1 MB stack. One level past the cap is a parse error, not a crash.
+ */
+class DeepScriptTest {
+    private static final long STACK = 1024 * 1024;
+    private static final int MAX_BLOCK_DEPTH = 256;
+
+    @BeforeAll
+    static void loadLibrary() {
+        Scripts.loadLibrary();
+    }
+
+    @Test
+    void parsesLongElseIfChain() {
+        StringBuilder body = new StringBuilder();
+        for (int i = 0; i < 10_000; i++) {
+            body.append(i == 0 ? "if" : "} else if").append(" event.message = \"").append(i).append("\" {\n")
+                .append("send \"").append(i).append("\"\n");
+        }
+        body.append("} else {\nsend \"none\"\n}\n");
+
+        Event[] events = onSmallStack(() -> NativeParser.parseSwoftLangToEvents(event(body)));
+        assertEquals(1, events.length);
+        assertEquals(1, events[0].getExecuteBlock().getStatements().size());
+    }
+
+    @Test
+    void parsesBlocksNestedToTheCap() {
+        Event[] events = onSmallStack(() -> NativeParser.parseSwoftLangToEvents(event(nested(MAX_BLOCK_DEPTH))));
+        assertEquals(1, events.length);
+        assertNotNull(events[0].getExecuteBlock());
+    }
+
+    @Test
+    void rejectsBlocksNestedPastTheCap() {
+        Event[] events = onSmallStack(() -> NativeParser.parseSwoftLangToEvents(event(nested(MAX_BLOCK_DEPTH + 1))));
+        assertEquals(0, events.length);
+    }
+
+    private static String nested(int depth) {
+        StringBuilder body = new StringBuilder();
+        for (int i = 0; i < depth; i++) {
+            body.append("if event.message contains \"").append(i).append("\" {\n");
+        }
+        body.append("send \"deep\"\n");
+        body.append("}\n".repeat(depth));
+        return body.toString();
+    }
+
+    private static String event(CharSequence body) {
+        return "event PlayerChat {\n    execute {\n" + body + "    }\n}\n";
+    }
+
+    private static <T> T onSmallStack(Supplier<T> parse) {
+        AtomicReference<T> result = new AtomicReference<>();
+        AtomicReference<Throwable> failure = new AtomicReference<>();
+        Thread thread = new Thread(null, () -> {
+            try {
+                result.set(parse.get());
+            } catch (Throwable t) {
+                failure.set(t);
+            }
+        }, "deep-script-parse", STACK);
+        thread.start();
+        try {
+            thread.join();
+        } catch (InterruptedException e) {
+            throw new IllegalStateException(e);
+        }
+        if (failure.get() != null) {
+            throw new AssertionError(failure.get());
+        }
+        return result.get();
+    }
+}
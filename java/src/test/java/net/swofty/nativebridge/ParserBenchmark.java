@@ -0,0 +1,29 @@
+package net.swofty.nativebridge;
+
+import net.swofty.Scripts;
+import net.swofty.Timing;
+
+import java.util.Map;
+
+/**
+ * Parses every sample script through JNI, which builds the Java objects in C++, and through
+ * the C ABI, which returns one buffer that ScriptDecoder reads on the Java side. The JNI
+ * side is called as the processors call it: once for the commands and once for the events.
+ *
+ * gradle :java:benchmark -Pbenchmark=net.swofty.nativebridge.ParserBenchmark
+ */
+public final class ParserBenchmark {
+    private static final int RUNS = 20_000;
+
+    public static void main(String[] args) {
+        Scripts.loadLibrary();
+        for (Map.Entry<String, String> script : Scripts.all().entrySet()) {
+            String code = script.getValue();
+            Timing.time(script.getKey() + " jni", RUNS, () -> {
+                NativeParser.parseSwoftLangToCommands(code);
+                return NativeParser.parseSwoftLangToEvents(code);
+            });
+            Timing.time(script.getKey() + " ffm", RUNS, () -> ForeignParser.parseScript(code));
+        }
+    }
+}
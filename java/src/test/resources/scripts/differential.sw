@@ -0,0 +1,98 @@
+// Handlers for ExecutorDifferentialTest, each run with every executor on a range of
+// inputs. Between them they use every statement and operator the compiler handles.
+
+event PlayerChat {
+    execute {
+        if event.message contains "badword" || event.message contains "Spam" {
+            send "<red>blocked ${event.message}"
+            cancel event
+            halt
+        } else if event.message contains "he" {
+            send "he"
+        } else if event.message contains "hers" {
+            send "hers"
+        } else if event.message contains "x" && event.message contains "y" {
+            send "xy"
+        } else {
+            send "other"
+        }
+        send "end"
+    }
+}
+
+event PlayerChat {
+    execute {
+        if event.message = "a" {
+            send "A"
+        } else if event.message = "b" {
+            send "B"
+        } else if event.message = "a" {
+            send "dup"
+        } else if event.message = "c" {
+            send "C"
+        } else if event.message contains "x" || event.message contains "y" {
+            send "x or y"
+        } else {
+            send "none"
+        }
+    }
+}
+
+event PlayerChat {
+    execute {
+        if event.message contains "é" {
+            send "accent"
+        }
+        if event.message contains "Straße" {
+            send "street"
+        }
+        if event.message contains "ΣΟΦ" {
+            send "greek"
+        }
+        if event.message contains "ΣΟΦ" || event.message contains "évi" || event.message contains "STRASSE" {
+            send "any"
+        }
+        set event.message to "[${event.player.username}] " + event.message
+        send event.message to event.player
+    }
+}
+
+event PlayerJoin {
+    execute {
+        set greeting to "Welcome"
+        send greeting + " " + event.player.name.content + "!"
+        if event.player is a Player {
+            send "player"
+        } else {
+            send "not a player"
+        }
+        if "abc" contains "B" {
+            send "literal"
+        }
+        if "x" = "y" {
+            halt
+        }
+        send "done"
+    }
+}
+
+command "args" {
+    arguments {
+        who: Player = sender
+        target: either<Player|Location>
+    }
+
+    execute {
+        if args.who is not a Player {
+            send "<red>not a player: ${args.who}" to sender
+        }
+        if args.target is a Location {
+            send "to ${args.target}"
+        } else if args.target = args.who {
+            send "to self"
+            halt
+        }
+        teleport args.who to args.target
+        send "after teleport ${sender}"
+    }
+}
@@ -0,0 +1,45 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class net_swofty_nativebridge_NativeEngine */
+
+#ifndef _Included_net_swofty_nativebridge_NativeEngine
+#define _Included_net_swofty_nativebridge_NativeEngine
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    load
+ * Signature: ([I[Ljava/lang/Object;[II)J
+ */
+JNIEXPORT jlong JNICALL Java_net_swofty_nativebridge_NativeEngine_load
+  (JNIEnv *, jclass, jintArray, jobjectArray, jintArray, jint);
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    free
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_net_swofty_nativebridge_NativeEngine_free
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    run
+ * Signature: (J[Ljava/lang/Object;Lnet/swofty/nativebridge/NativeHost;)I
+ */
+JNIEXPORT jint JNICALL Java_net_swofty_nativebridge_NativeEngine_run
+  (JNIEnv *, jclass, jlong, jobjectArray, jobject);
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    generateClass
+ * Signature: ([I[Ljava/lang/Object;[IIILjava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_net_swofty_nativebridge_NativeEngine_generateClass
+  (JNIEnv *, jclass, jintArray, jobjectArray, jintArray, jint, jint, jstring);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
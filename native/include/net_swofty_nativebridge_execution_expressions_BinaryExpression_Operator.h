@@ -0,0 +1,15 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator */
+
+#ifndef _Included_net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator
+#define _Included_net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator_COUNT
+#define net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator_COUNT 22L
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,15 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class net_swofty_nativebridge_representation_BaseType */
+
+#ifndef _Included_net_swofty_nativebridge_representation_BaseType
+#define _Included_net_swofty_nativebridge_representation_BaseType
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef net_swofty_nativebridge_representation_BaseType_COUNT
+#define net_swofty_nativebridge_representation_BaseType_COUNT 8L
+#ifdef __cplusplus
+}
+#endif
+#endif
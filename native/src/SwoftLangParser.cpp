@@ -3,35 +3,75 @@
 #include "ScriptParser.h"
 #include "CommandParser.h"
 #include "EventParser.h"
+#include "ExecuteBlockParser.h"
+#include "BlockPasses.h"
 #include "Lexer.h"
+#include "ScratchArena.h"
+
+namespace {
+    // Token storage reused by every parse on this thread. A nested parse on the same
+    // thread gets its own vector so it cannot clobber the outer one.
+    class ScratchTokens {
+    public:
+        explicit ScratchTokens(const ScratchArena::Scope& scope)
+            : buffer(scope.isOutermost() ? threadTokens() : local) {}
+
+        std::vector<Token>& get() { return buffer; }
+
+    private:
+        std::vector<Token> local;
+        std::vector<Token>& buffer;
+
+        static std::vector<Token>& threadTokens() {
+            static thread_local std::vector<Token> tokens;
+            return tokens;
+        }
+    };
+}
 
 std::vector<std::shared_ptr<Command>> SwoftLangParser::parseCommands(const std::string& source) {
-    Lexer lexer(source);
-    std::vector<Token> tokens = lexer.tokenize();
+    ScratchArena::Scope scope;
+    ScratchTokens tokens(scope);
+    Lexer(source).tokenize(tokens.get());
     
-    ScriptParser parser(tokens);
+    ScriptParser parser(tokens.get());
     return parser.parseCommands();
 }
 
 std::vector<std::shared_ptr<Event>> SwoftLangParser::parseEvents(const std::string& source) {
-    Lexer lexer(source);
-    std::vector<Token> tokens = lexer.tokenize();
+    ScratchArena::Scope scope;
+    ScratchTokens tokens(scope);
+    Lexer(source).tokenize(tokens.get());
     
-    ScriptParser parser(tokens);
+    ScriptParser parser(tokens.get());
     return parser.parseEvents();
 }
 
 
 std::pair<std::vector<std::shared_ptr<Command>>, std::vector<std::shared_ptr<Event>>> SwoftLangParser::parseAll(const std::string& source) {
-    Lexer lexer(source);
-    std::vector<Token> tokens = lexer.tokenize();
+    ScratchArena::Scope scope;
+    ScratchTokens tokens(scope);
+    Lexer(source).tokenize(tokens.get());
     
-    ScriptParser parser(tokens);
+    ScriptParser parser(tokens.get());
     parser.parseAll(); // Parse both commands and events
     
     return std::make_pair(parser.getCommands(), parser.getEvents());
 }
 
+std::shared_ptr<ExecuteBlock> SwoftLangParser::parseExecuteBlock(const std::string& source) {
+    ScratchArena::Scope scope;
+    ScratchTokens tokens(scope);
+    Lexer(source).tokenize(tokens.get());
+
+    ExecuteBlockParser parser(tokens.get());
+    auto executeBlock = parser.parseExecuteBlock();
+    if (executeBlock) {
+        BlockPasses::run(*executeBlock, {}, {}, "execute block");
+    }
+    return executeBlock;
+}
+
 std::string SwoftLangParser::commandsToJson(const std::vector<std::shared_ptr<Command>>& commands) {
     // Existing implementation
     std::string json = "[";
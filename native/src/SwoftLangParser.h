@@ -5,11 +5,20 @@
 #include <memory>
 #include "Command.h"
 #include "Event.h" 
+#include "ExecuteBlock.h"
 
+// Entry point for parsing whole scripts.
+//
+// All functions are safe to call concurrently from any number of threads: the parse
+// pipeline keeps no shared mutable state, and each thread parses into its own scratch
+// token buffer and ScratchArena, both reused from one parse to the next. The returned
+// nodes may be kept and released on any thread.
 class SwoftLangParser {
 public:
     static std::vector<std::shared_ptr<Command>> parseCommands(const std::string& source);
     static std::vector<std::shared_ptr<Event>> parseEvents(const std::string& source);
     static std::pair<std::vector<std::shared_ptr<Command>>, std::vector<std::shared_ptr<Event>>> parseAll(const std::string &source);
+    // A bare execute block, with every pass run over it
+    static std::shared_ptr<ExecuteBlock> parseExecuteBlock(const std::string& source);
     static std::string commandsToJson(const std::vector<std::shared_ptr<Command>> &commands);
 };
\ No newline at end of file
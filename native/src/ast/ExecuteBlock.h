@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -8,6 +9,11 @@
 class ExecuteBlock : public ASTNode {
 private:
     std::vector<std::shared_ptr<Statement>> statements;
+    std::vector<std::string> slotNames; // Frame layout, see SlotResolver
+    std::vector<std::string> eventReads;  // Event properties the block reads, see SlotResolver
+    std::vector<std::string> eventWrites; // Event properties the block assigns
+    bool canHalt = true;                // Cleared by DeadCodeEliminator if no halt is reachable
+    int32_t effects = -1;               // EffectAnalyzer flags; -1 (every effect) until analysed
     
 public:
     void addStatement(std::shared_ptr<Statement> statement) {
@@ -18,6 +24,47 @@ public:
         return statements;
     }
     
+    void setStatements(std::vector<std::shared_ptr<Statement>> replacement) {
+        statements = std::move(replacement);
+    }
+    
+    bool getCanHalt() const {
+        return canHalt;
+    }
+    
+    void setCanHalt(bool value) {
+        canHalt = value;
+    }
+    
+    int32_t getEffects() const {
+        return effects;
+    }
+    
+    void setEffects(int32_t value) {
+        effects = value;
+    }
+    
+    const std::vector<std::string>& getSlotNames() const {
+        return slotNames;
+    }
+    
+    void setSlotNames(std::vector<std::string> names) {
+        slotNames = std::move(names);
+    }
+    
+    const std::vector<std::string>& getEventReads() const {
+        return eventReads;
+    }
+    
+    const std::vector<std::string>& getEventWrites() const {
+        return eventWrites;
+    }
+    
+    void setEventAccesses(std::vector<std::string> reads, std::vector<std::string> writes) {
+        eventReads = std::move(reads);
+        eventWrites = std::move(writes);
+    }
+    
     std::string toJson() const override { 
         std::string json = "{\"type\":\"ExecuteBlock\",\"statements\":[";
         for (size_t i = 0; i < statements.size(); i++) {
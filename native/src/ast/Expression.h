@@ -1,7 +1,15 @@
 #pragma once
 #include "ASTNode.h"
+#include <DataType.h>
 
 // Base class for expressions
 class Expression : public ASTNode {
+private:
+    // Set by TypeChecker. UNKNOWN means the type is only known at runtime; a known
+    // type may still evaluate to null (e.g. a local read before it is assigned).
+    BaseType staticType = BaseType::UNKNOWN;
+
 public:
-};
\ No newline at end of file
+    BaseType getStaticType() const { return staticType; }
+    void setStaticType(BaseType type) { staticType = type; }
+};
@@ -0,0 +1,150 @@
+#include "PostOrder.h"
+#include <stdexcept>
+#include <SendCommand.h>
+#include <TeleportCommand.h>
+#include <HaltCommand.h>
+#include <IfStatement.h>
+#include <BlockStatement.h>
+#include <VariableAssignment.h>
+#include <CancelEventStatement.h>
+#include <StringLiteral.h>
+#include <VariableReference.h>
+#include <BinaryExpression.h>
+#include <TypeLiteral.h>
+#include <EventAccessExpression.h>
+#include <InterpolatedString.h>
+#include <BooleanLiteral.h>
+#include <Concat.h>
+#include <SwitchStatement.h>
+
+namespace {
+    struct Pending {
+        const ASTNode* node;
+        NodeKind kind;
+        bool expanded;
+        uint32_t childCount;
+    };
+
+    // Appends the direct children of a node in source order
+    void appendChildren(const ASTNode* node, NodeKind kind, std::vector<const ASTNode*>& out) {
+        switch (kind) {
+            case NodeKind::SEND: {
+                auto send = static_cast<const SendCommand*>(node);
+                out.push_back(send->getMessage().get());
+                out.push_back(send->getTarget().get());
+                break;
+            }
+            case NodeKind::TELEPORT: {
+                auto teleport = static_cast<const TeleportCommand*>(node);
+                out.push_back(teleport->getEntity().get());
+                out.push_back(teleport->getTarget().get());
+                break;
+            }
+            case NodeKind::IF: {
+                auto ifStmt = static_cast<const IfStatement*>(node);
+                out.push_back(ifStmt->getCondition().get());
+                out.push_back(ifStmt->getThenStatement().get());
+                out.push_back(ifStmt->getElseStatement().get());
+                break;
+            }
+            case NodeKind::BLOCK:
+                for (const auto& statement : static_cast<const BlockStatement*>(node)->getStatements()) {
+                    out.push_back(statement.get());
+                }
+                break;
+            case NodeKind::ASSIGN:
+                out.push_back(static_cast<const VariableAssignment*>(node)->getValue().get());
+                break;
+            case NodeKind::BINARY: {
+                auto binary = static_cast<const BinaryExpression*>(node);
+                out.push_back(binary->getLeft().get());
+                out.push_back(binary->getRight().get());
+                break;
+            }
+            case NodeKind::INTERPOLATED_STRING:
+                for (const auto& part : static_cast<const InterpolatedString*>(node)->getParts()) {
+                    out.push_back(part.get());
+                }
+                break;
+            case NodeKind::CONCAT:
+                for (const auto& part : static_cast<const Concat*>(node)->getParts()) {
+                    out.push_back(part.get());
+                }
+                break;
+            case NodeKind::SWITCH: {
+                auto switchStmt = static_cast<const SwitchStatement*>(node);
+                out.push_back(switchStmt->getSubject().get());
+                for (const auto& branch : switchStmt->getBranches()) {
+                    out.push_back(branch.get());
+                }
+                out.push_back(switchStmt->getDefaultStatement().get());
+                break;
+            }
+            case NodeKind::EXECUTE_BLOCK:
+                for (const auto& statement : static_cast<const ExecuteBlock*>(node)->getStatements()) {
+                    out.push_back(statement.get());
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+NodeKind PostOrder::kindOf(const ASTNode* node) {
+    if (!node) return NodeKind::NONE;
+    if (dynamic_cast<const SendCommand*>(node)) return NodeKind::SEND;
+    if (dynamic_cast<const TeleportCommand*>(node)) return NodeKind::TELEPORT;
+    if (dynamic_cast<const HaltCommand*>(node)) return NodeKind::HALT;
+    if (dynamic_cast<const IfStatement*>(node)) return NodeKind::IF;
+    if (dynamic_cast<const BlockStatement*>(node)) return NodeKind::BLOCK;
+    if (dynamic_cast<const VariableAssignment*>(node)) return NodeKind::ASSIGN;
+    if (dynamic_cast<const CancelEventStatement*>(node)) return NodeKind::CANCEL_EVENT;
+    if (dynamic_cast<const StringLiteral*>(node)) return NodeKind::STRING_LITERAL;
+    if (dynamic_cast<const VariableReference*>(node)) return NodeKind::VARIABLE_REFERENCE;
+    if (dynamic_cast<const BinaryExpression*>(node)) return NodeKind::BINARY;
+    if (dynamic_cast<const TypeLiteral*>(node)) return NodeKind::TYPE_LITERAL;
+    if (dynamic_cast<const EventAccessExpression*>(node)) return NodeKind::EVENT_ACCESS;
+    if (dynamic_cast<const InterpolatedString*>(node)) return NodeKind::INTERPOLATED_STRING;
+    if (dynamic_cast<const BooleanLiteral*>(node)) return NodeKind::BOOLEAN_LITERAL;
+    if (dynamic_cast<const Concat*>(node)) return NodeKind::CONCAT;
+    if (dynamic_cast<const SwitchStatement*>(node)) return NodeKind::SWITCH;
+    if (dynamic_cast<const ExecuteBlock*>(node)) return NodeKind::EXECUTE_BLOCK;
+    throw std::runtime_error("Unknown AST node type");
+}
+
+FlatTree PostOrder::flatten(const ExecuteBlock& block) {
+    FlatTree tree;
+    std::vector<Pending> pending;
+    std::vector<const ASTNode*> children;
+    size_t depth = 0;
+
+    pending.push_back({&block, NodeKind::EXECUTE_BLOCK, false, 0});
+
+    while (!pending.empty()) {
+        Pending current = pending.back();
+        pending.pop_back();
+
+        if (!current.expanded) {
+            children.clear();
+            appendChildren(current.node, current.kind, children);
+
+            if (!children.empty()) {
+                // Revisit this node once every child has been emitted
+                pending.push_back({current.node, current.kind, true, static_cast<uint32_t>(children.size())});
+                for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                    pending.push_back({*it, kindOf(*it), false, 0});
+                }
+                continue;
+            }
+        }
+
+        tree.nodes.push_back({current.kind, current.node, current.childCount});
+        depth = depth - current.childCount + 1;
+        if (depth > tree.maxStackDepth) {
+            tree.maxStackDepth = depth;
+        }
+    }
+
+    return tree;
+}
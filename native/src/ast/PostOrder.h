@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ASTNode.h"
+#include "ExecuteBlock.h"
+
+// Node kinds as seen by code that walks a flattened execute block
+enum class NodeKind : uint8_t {
+    NONE,               // an absent child, e.g. a send without a target
+    SEND,
+    TELEPORT,
+    HALT,
+    IF,
+    BLOCK,
+    ASSIGN,
+    CANCEL_EVENT,
+    STRING_LITERAL,
+    VARIABLE_REFERENCE,
+    BINARY,
+    TYPE_LITERAL,
+    EVENT_ACCESS,
+    INTERPOLATED_STRING,
+    BOOLEAN_LITERAL,
+    CONCAT,
+    SWITCH,
+    EXECUTE_BLOCK
+};
+
+struct FlatNode {
+    NodeKind kind;
+    const ASTNode* node;    // nullptr for NONE
+    uint32_t childCount;    // number of child subtrees listed before this node
+};
+
+// An execute block listed in post-order: every node comes after all of its children,
+// in source order, so a consumer can rebuild the tree with one operand stack.
+struct FlatTree {
+    std::vector<FlatNode> nodes;
+    size_t maxStackDepth = 0;   // operand stack size needed to rebuild the tree
+};
+
+class PostOrder {
+public:
+    // Walks with an explicit stack, so arbitrarily deep nesting is safe
+    static FlatTree flatten(const ExecuteBlock& block);
+
+    static NodeKind kindOf(const ASTNode* node);
+};
@@ -3,5 +3,10 @@
 
 // Base class for statements
 class Statement : public ASTNode {
+private:
+    int line = 0; // Source line the statement starts on, 0 if not known
+
 public:
+    int getLine() const { return line; }
+    void setLine(int value) { line = value; }
 };
\ No newline at end of file
@@ -19,9 +19,25 @@ class BinaryExpression : public Expression {
             IS_TYPE,        // is a
             IS_NOT_TYPE,    // is not a
             CONTAINS,       // For string contains checks
-            CONCATENATE     // + for string concatenation
+            
+            // Variants chosen by TypeChecker when the operand types are known, so the
+            // runtime skips its instanceof dispatch
+            STRING_EQUALS,          // == with a String operand
+            STRING_NOT_EQUALS,
+            NUMBER_EQUALS,          // == on two numbers
+            NUMBER_NOT_EQUALS,
+            NUMBER_LESS_THAN,       // < on two numbers
+            NUMBER_GREATER_THAN,
+            NUMBER_LESS_EQUALS,
+            NUMBER_GREATER_EQUALS,
+            IDENTITY_EQUALS,        // == on two players
+            IDENTITY_NOT_EQUALS,
+            
+            CONCATENATE     // + for string concatenation (keep last, see OPERATOR_COUNT)
         };
         
+        static constexpr size_t OPERATOR_COUNT = static_cast<size_t>(Operator::CONCATENATE) + 1;
+        
     private:
         std::shared_ptr<Expression> left;
         Operator operator_;
@@ -33,17 +49,30 @@ class BinaryExpression : public Expression {
         
         std::shared_ptr<Expression> getLeft() const { return left; }
         Operator getOperator() const { return operator_; }
+        
+        // Replaces the operator with one of its typed variants, see TypeChecker
+        void specialize(Operator variant) { operator_ = variant; }
         std::shared_ptr<Expression> getRight() const { return right; }
         
         std::string toJson() const override {
             std::string opStr;
             switch (operator_) {
-                case Operator::EQUALS: opStr = "=="; break;
-                case Operator::NOT_EQUALS: opStr = "!="; break;
-                case Operator::LESS_THAN: opStr = "<"; break;
-                case Operator::GREATER_THAN: opStr = ">"; break;
-                case Operator::LESS_EQUALS: opStr = "<="; break;
-                case Operator::GREATER_EQUALS: opStr = ">="; break;
+                case Operator::EQUALS:
+                case Operator::STRING_EQUALS:
+                case Operator::NUMBER_EQUALS:
+                case Operator::IDENTITY_EQUALS: opStr = "=="; break;
+                case Operator::NOT_EQUALS:
+                case Operator::STRING_NOT_EQUALS:
+                case Operator::NUMBER_NOT_EQUALS:
+                case Operator::IDENTITY_NOT_EQUALS: opStr = "!="; break;
+                case Operator::LESS_THAN:
+                case Operator::NUMBER_LESS_THAN: opStr = "<"; break;
+                case Operator::GREATER_THAN:
+                case Operator::NUMBER_GREATER_THAN: opStr = ">"; break;
+                case Operator::LESS_EQUALS:
+                case Operator::NUMBER_LESS_EQUALS: opStr = "<="; break;
+                case Operator::GREATER_EQUALS:
+                case Operator::NUMBER_GREATER_EQUALS: opStr = ">="; break;
                 case Operator::AND: opStr = "&&"; break;
                 case Operator::OR: opStr = "||"; break;
                 case Operator::IS_TYPE: opStr = "is"; break;
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <Expression.h>
+
+// The result of a comparison the parser could evaluate itself
+class BooleanLiteral : public Expression {
+    private:
+        bool value;
+        
+    public:
+        BooleanLiteral(bool value) : value(value) {}
+        
+        bool getValue() const { return value; }
+        
+        std::string toJson() const override {
+            return std::string("{\"type\":\"BooleanLiteral\",\"value\":") + (value ? "true" : "false") + "}";
+        }
+    };
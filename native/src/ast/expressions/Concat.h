@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <Expression.h>
+
+// A whole "a" + x + "b" chain as one node. Adjacent constants are already merged
+// into single StringLiteral parts, so the runtime appends each part once instead of
+// building an intermediate string per '+'.
+class Concat : public Expression {
+    private:
+        std::vector<std::shared_ptr<Expression>> parts;
+        size_t literalLength = 0;
+        
+    public:
+        void addLiteral(std::shared_ptr<Expression> chunk, size_t length) {
+            parts.push_back(chunk);
+            literalLength += length;
+        }
+        
+        void addOperand(std::shared_ptr<Expression> operand) {
+            parts.push_back(operand);
+        }
+        
+        const std::vector<std::shared_ptr<Expression>>& getParts() const { return parts; }
+        
+        // Total length of the literal parts, a lower bound for the result
+        size_t getLiteralLength() const { return literalLength; }
+        
+        std::string toJson() const override {
+            std::string json = "{\"type\":\"Concat\",\"parts\":[";
+            for (size_t i = 0; i < parts.size(); i++) {
+                if (i > 0) json += ",";
+                json += parts[i]->toJson();
+            }
+            json += "]}";
+            return json;
+        }
+    };
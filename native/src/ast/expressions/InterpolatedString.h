@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <Expression.h>
+
+// A string literal containing ${...}, split at parse time. Each part is either a
+// StringLiteral chunk, rendered as-is, or a VariableReference whose value is rendered
+// in its place, so "Hello ${event.player.name}!" has three parts.
+class InterpolatedString : public Expression {
+    private:
+        std::vector<std::shared_ptr<Expression>> parts;
+        size_t literalLength = 0;
+        
+    public:
+        void addLiteral(std::shared_ptr<Expression> chunk, size_t length) {
+            parts.push_back(chunk);
+            literalLength += length;
+        }
+        
+        void addVariable(std::shared_ptr<Expression> variable) {
+            parts.push_back(variable);
+        }
+        
+        const std::vector<std::shared_ptr<Expression>>& getParts() const { return parts; }
+        
+        // Total length of the literal chunks, a lower bound for the rendered string
+        size_t getLiteralLength() const { return literalLength; }
+        
+        std::string toJson() const override {
+            std::string json = "{\"type\":\"InterpolatedString\",\"parts\":[";
+            for (size_t i = 0; i < parts.size(); i++) {
+                if (i > 0) json += ",";
+                json += parts[i]->toJson();
+            }
+            json += "]}";
+            return json;
+        }
+    };
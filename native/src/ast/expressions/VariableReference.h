@@ -9,10 +9,22 @@ class VariableReference : public Expression {
     private:
         std::string name;
         
+        // Bound by SlotResolver: the frame slot of the root name and the property
+        // segments after it ("event.player.name" -> event's slot, {"player", "name"})
+        int slot = -1;
+        std::vector<std::string> path;
+        
     public:
         VariableReference(const std::string& name) : name(name) {}
         
         const std::string& getName() const { return name; }
+        int getSlot() const { return slot; }
+        const std::vector<std::string>& getPath() const { return path; }
+        
+        void bind(int slot, std::vector<std::string> path) {
+            this->slot = slot;
+            this->path = std::move(path);
+        }
         
         std::string toJson() const override {
             return "{\"type\":\"VariableReference\",\"name\":\"" + name + "\"}";
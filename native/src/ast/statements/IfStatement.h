@@ -18,6 +18,18 @@ class IfStatement : public Statement {
                     std::shared_ptr<Statement> elseStatement = nullptr)
             : condition(condition), thenStatement(thenStatement), elseStatement(elseStatement) {}
         
+        ~IfStatement() override {
+            // Unlink an else-if chain one link at a time; letting the members go would
+            // recurse through every link's destructor
+            std::shared_ptr<Statement> next = std::move(elseStatement);
+            while (next && next.use_count() == 1) {
+                auto elseIf = dynamic_cast<IfStatement*>(next.get());
+                if (!elseIf) break;
+                std::shared_ptr<Statement> following = std::move(elseIf->elseStatement);
+                next = std::move(following);
+            }
+        }
+        
         std::shared_ptr<Expression> getCondition() const { return condition; }
         std::shared_ptr<Statement> getThenStatement() const { return thenStatement; }
         std::shared_ptr<Statement> getElseStatement() const { return elseStatement; }
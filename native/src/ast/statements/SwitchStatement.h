@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <Statement.h>
+#include <Expression.h>
+
+// An else-if chain that compares one value against string literals, built by
+// ConditionCompiler. Runs the branch whose label equals the subject, or the default.
+class SwitchStatement : public Statement {
+    private:
+        std::shared_ptr<Expression> subject;
+        std::vector<std::string> labels;
+        std::vector<std::shared_ptr<Statement>> branches;
+        std::shared_ptr<Statement> defaultStatement;
+        
+    public:
+        SwitchStatement(std::shared_ptr<Expression> subject,
+                        std::vector<std::string> labels,
+                        std::vector<std::shared_ptr<Statement>> branches,
+                        std::shared_ptr<Statement> defaultStatement = nullptr)
+            : subject(subject), labels(std::move(labels)), branches(std::move(branches)),
+              defaultStatement(defaultStatement) {}
+        
+        std::shared_ptr<Expression> getSubject() const { return subject; }
+        const std::vector<std::string>& getLabels() const { return labels; }
+        const std::vector<std::shared_ptr<Statement>>& getBranches() const { return branches; }
+        std::shared_ptr<Statement> getDefaultStatement() const { return defaultStatement; }
+        
+        std::string toJson() const override {
+            std::string json = "{\"type\":\"SwitchStatement\",\"subject\":" + subject->toJson() + ",\"cases\":[";
+            for (size_t i = 0; i < labels.size(); i++) {
+                if (i > 0) json += ",";
+                json += "{\"label\":\"" + labels[i] + "\",\"statement\":" + branches[i]->toJson() + "}";
+            }
+            json += "]";
+            if (defaultStatement) {
+                json += ",\"defaultStatement\":" + defaultStatement->toJson();
+            }
+            json += "}";
+            return json;
+        }
+    };
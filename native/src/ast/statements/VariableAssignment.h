@@ -11,12 +11,23 @@ class VariableAssignment : public Statement {
         std::string variableName;
         std::shared_ptr<Expression> value;
         
+        // Bound by SlotResolver, see VariableReference
+        int slot = -1;
+        std::vector<std::string> path;
+        
     public:
         VariableAssignment(const std::string& variableName, std::shared_ptr<Expression> value)
             : variableName(variableName), value(value) {}
         
         const std::string& getVariableName() const { return variableName; }
         std::shared_ptr<Expression> getValue() const { return value; }
+        int getSlot() const { return slot; }
+        const std::vector<std::string>& getPath() const { return path; }
+        
+        void bind(int slot, std::vector<std::string> path) {
+            this->slot = slot;
+            this->path = std::move(path);
+        }
         
         std::string toJson() const override {
             return "{\"type\":\"VariableAssignment\",\"variableName\":\"" + variableName + 
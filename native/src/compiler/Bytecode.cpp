@@ -0,0 +1,72 @@
+#include "Bytecode.h"
+#include <BinaryExpression.h>
+
+namespace {
+    struct OpcodeInfo {
+        const char* name;
+        size_t operands;
+    };
+
+    // Indexed by opcode; CONCAT has four fixed operands plus one per part
+    const OpcodeInfo OPCODES[OPCODE_COUNT] = {
+        {"LOAD_CONST", 2},
+        {"LOAD_BOOL", 2},
+        {"MOVE", 2},
+        {"GET_PATH", 3},
+        {"SET_PATH", 4},
+        {"BINARY", 4},
+        {"CONCAT", 4},
+        {"TO_MESSAGE", 2},
+        {"JUMP", 1},
+        {"JUMP_IF_FALSE", 2},
+        {"JUMP_IF_TRUE", 2},
+        {"SWITCH", 3},
+        {"SEND", 2},
+        {"TELEPORT", 2},
+        {"CANCEL", 0},
+        {"HALT", 0},
+        {"RETURN", 0},
+        {"MATCH", 3}
+    };
+
+    // Indexed by BinaryExpression::Operator, spelled as the Java enum constants
+    const char* const OPERATOR_NAMES[] = {
+        "EQUALS", "NOT_EQUALS", "LESS_THAN", "GREATER_THAN", "LESS_EQUALS", "GREATER_EQUALS",
+        "AND", "OR", "IS_TYPE", "IS_NOT_TYPE", "CONTAINS",
+        "STRING_EQUALS", "STRING_NOT_EQUALS",
+        "NUMBER_EQUALS", "NUMBER_NOT_EQUALS", "NUMBER_LESS_THAN", "NUMBER_GREATER_THAN",
+        "NUMBER_LESS_EQUALS", "NUMBER_GREATER_EQUALS",
+        "IDENTITY_EQUALS", "IDENTITY_NOT_EQUALS", "CONCATENATE"
+    };
+    static_assert(sizeof(OPERATOR_NAMES) / sizeof(OPERATOR_NAMES[0]) == BinaryExpression::OPERATOR_COUNT,
+                  "OPERATOR_NAMES must list every BinaryExpression::Operator");
+}
+
+const char* Bytecode::name(Opcode opcode) {
+    size_t index = static_cast<size_t>(opcode);
+    return index < OPCODE_COUNT ? OPCODES[index].name : "?";
+}
+
+const char* Bytecode::operatorName(int32_t op) {
+    return op >= 0 && static_cast<size_t>(op) < BinaryExpression::OPERATOR_COUNT ? OPERATOR_NAMES[op] : "?";
+}
+
+size_t Bytecode::operandCount(const std::vector<int32_t>& code, size_t offset) {
+    size_t index = static_cast<size_t>(code[offset]);
+    if (index >= OPCODE_COUNT) {
+        return 0;
+    }
+    if (static_cast<Opcode>(code[offset]) == Opcode::CONCAT) {
+        return 4 + static_cast<size_t>(code[offset + 4]);
+    }
+    return OPCODES[index].operands;
+}
+
+int32_t Bytecode::lineAt(const Program& program, size_t offset) {
+    int32_t line = 0;
+    for (const auto& entry : program.lines) {
+        if (static_cast<size_t>(entry.first) > offset) break;
+        line = entry.second;
+    }
+    return line;
+}
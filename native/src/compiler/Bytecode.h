@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Register bytecode for execute blocks, produced by Compiler and run by the Java
+// BytecodeInterpreter (whose opcode constants must match this enum).
+//
+// Code is a flat int32 array: an opcode followed by its operands. Registers index the
+// executor's frame: registers 0..slotCount-1 are the block's slots (see SlotResolver),
+// the rest are temporaries. Jump targets are absolute code offsets. "#k" is an index
+// into the constant pool. Operands marked "rk" are a register if >= 0, or string
+// constant -(rk + 1) if negative, so literals need no load of their own.
+//
+//   LOAD_CONST     dst, #k                     dst = string constant k
+//   LOAD_BOOL      dst, value                  dst = value != 0
+//   MOVE           dst, src                    dst = src
+//   GET_PATH       dst, root, #path            dst = property path read from root (null-safe)
+//   SET_PATH       root, #path, src, #name     store src at the end of a property path; #name
+//                                              is the assigned variable, for the error message
+//   BINARY         dst, operator, rk, rk       dst = a <operator> b, any operator but AND/OR
+//   CONCAT         dst, flags, capacity, count, rk...
+//                                              dst = the parts rendered back to back; constant
+//                                              parts are appended as-is
+//   TO_MESSAGE     dst, src                    dst = src as send text, color tags translated
+//   JUMP           target
+//   JUMP_IF_FALSE  src, target                 jump unless src is truthy
+//   JUMP_IF_TRUE   src, target                 jump if src is truthy
+//   SWITCH         src, #table, default        jump to the table's target for src, else default
+//   MATCH          src, #table, default        jump to the target of the first pattern in the
+//                                              table that src contains (as CONTAINS tests it),
+//                                              else default
+//   SEND           rk, target                  send the message; target -1 is the command sender
+//   TELEPORT       entity, target
+//   CANCEL                                     cancel the event in slot 1
+//   HALT                                       stop the handler
+//   RETURN                                     end of the block
+enum class Opcode : int32_t {
+    LOAD_CONST = 0,
+    LOAD_BOOL = 1,
+    MOVE = 2,
+    GET_PATH = 3,
+    SET_PATH = 4,
+    BINARY = 5,
+    CONCAT = 6,
+    TO_MESSAGE = 7,
+    JUMP = 8,
+    JUMP_IF_FALSE = 9,
+    JUMP_IF_TRUE = 10,
+    SWITCH = 11,
+    SEND = 12,
+    TELEPORT = 13,
+    CANCEL = 14,
+    HALT = 15,
+    RETURN = 16,
+    MATCH = 17
+};
+
+constexpr size_t OPCODE_COUNT = 18;
+
+// CONCAT flags
+constexpr int32_t CONCAT_TRANSLATE = 1; // translate color tags in register parts (send messages)
+constexpr int32_t CONCAT_SKIP_NULL = 2; // null registers add nothing (${...}) instead of "null" (+)
+
+struct Constant {
+    enum class Kind : int32_t {
+        STRING = 0, // strings[0]
+        PATH = 1,   // strings are the property segments
+        SWITCH = 2, // strings are the labels, targets the code offset of each
+        MATCH = 3   // strings are the patterns, targets the code offset of each
+    };
+
+    Kind kind;
+    std::vector<std::string> strings;
+    std::vector<int32_t> targets;
+};
+
+struct Program {
+    std::vector<int32_t> code;
+    std::vector<Constant> constants;
+    std::vector<std::pair<int32_t, int32_t>> lines; // (first offset, source line), by offset
+    int32_t registerCount = 0;
+};
+
+class Bytecode {
+public:
+    static const char* name(Opcode opcode);
+
+    // Name of a BINARY operator operand, as the Java Operator enum spells it
+    static const char* operatorName(int32_t op);
+
+    // Number of int32 operands following the opcode at code[offset]
+    static size_t operandCount(const std::vector<int32_t>& code, size_t offset);
+
+    // Source line for a code offset, or 0 if the table has none
+    static int32_t lineAt(const Program& program, size_t offset);
+};
@@ -0,0 +1,418 @@
+#include "ClassWriter.h"
+#include <stdexcept>
+
+namespace {
+    // Constant pool tags
+    const uint8_t TAG_UTF8 = 1;
+    const uint8_t TAG_INTEGER = 3;
+    const uint8_t TAG_CLASS = 7;
+    const uint8_t TAG_STRING = 8;
+    const uint8_t TAG_NAME_AND_TYPE = 12;
+
+    const uint8_t FULL_FRAME = 255;
+    const uint8_t ITEM_OBJECT = 7;
+
+    void put2(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void put4(std::vector<uint8_t>& out, uint32_t value) {
+        put2(out, value >> 16);
+        put2(out, value & 0xffff);
+    }
+
+    void putString(std::string& out, uint16_t value) {
+        out += static_cast<char>(value >> 8);
+        out += static_cast<char>(value & 0xff);
+    }
+
+    // Stack slots of a field type or return type; 0 for void
+    int typeSize(char type) {
+        return type == 'V' ? 0 : (type == 'J' || type == 'D' ? 2 : 1);
+    }
+
+    // Stack effect of a call: the arguments are popped and the result pushed
+    int callDelta(const std::string& descriptor) {
+        int delta = 0;
+        size_t i = 1;
+        while (descriptor[i] != ')') {
+            char type = descriptor[i];
+            while (descriptor[i] == '[') i++;
+            if (descriptor[i] == 'L') i = descriptor.find(';', i);
+            delta -= type == '[' || type == 'L' ? 1 : typeSize(type);
+            i++;
+        }
+        return delta + typeSize(descriptor[i + 1]);
+    }
+
+    // The JVM's "modified UTF-8": NUL as two bytes and characters outside the BMP as
+    // surrogate pairs of three bytes each
+    std::string modifiedUtf8(const std::string& value) {
+        std::string out;
+        out.reserve(value.size());
+        for (size_t i = 0; i < value.size(); i++) {
+            auto byte = static_cast<unsigned char>(value[i]);
+            if (byte == 0) {
+                out += "\xC0\x80";
+            } else if (byte >= 0xF0 && i + 3 < value.size()) {
+                uint32_t codePoint = ((byte & 0x07u) << 18) |
+                                     ((static_cast<unsigned char>(value[i + 1]) & 0x3Fu) << 12) |
+                                     ((static_cast<unsigned char>(value[i + 2]) & 0x3Fu) << 6) |
+                                     (static_cast<unsigned char>(value[i + 3]) & 0x3Fu);
+                codePoint -= 0x10000;
+                for (uint32_t unit : {0xD800 + (codePoint >> 10), 0xDC00 + (codePoint & 0x3FF)}) {
+                    out += static_cast<char>(0xE0 | (unit >> 12));
+                    out += static_cast<char>(0x80 | ((unit >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (unit & 0x3F));
+                }
+                i += 3;
+            } else {
+                out += static_cast<char>(byte);
+            }
+        }
+        return out;
+    }
+}
+
+// CodeBuilder
+
+CodeBuilder::Type CodeBuilder::objectType(const std::string& className) {
+    return {ITEM_OBJECT, owner.classRef(className)};
+}
+
+CodeBuilder::Label CodeBuilder::newLabel() {
+    labels.push_back(SIZE_MAX);
+    return labels.size() - 1;
+}
+
+void CodeBuilder::bind(Label label) {
+    labels[label] = code.size();
+}
+
+void CodeBuilder::frame(const std::vector<Type>& locals, const std::vector<Type>& stack) {
+    if (!frames.empty() && frames.back().offset == code.size()) {
+        frames.pop_back();
+    }
+    frames.push_back({code.size(), locals, stack});
+    depth = static_cast<int>(stack.size());
+    if (depth > maxStack) maxStack = depth;
+}
+
+void CodeBuilder::tryCatch(Label start, Label end, Label handler, const std::string& exceptionClass) {
+    handlers.push_back({start, end, handler, owner.classRef(exceptionClass)});
+}
+
+void CodeBuilder::op(JvmOpcode opcode, int stackDelta) {
+    u1(opcode);
+    adjust(stackDelta);
+}
+
+void CodeBuilder::load(JvmOpcode opcode, uint16_t local) {
+    auto shortForm = static_cast<uint8_t>(opcode == JvmOpcode::ALOAD ? JvmOpcode::ALOAD_0 : JvmOpcode::ILOAD_0);
+    if (local < 4) {
+        u1(static_cast<uint8_t>(shortForm + local));
+    } else if (local < 256) {
+        u1(opcode);
+        u1(static_cast<uint8_t>(local));
+    } else {
+        u1(JvmOpcode::WIDE);
+        u1(opcode);
+        u2(local);
+    }
+    adjust(1);
+}
+
+void CodeBuilder::store(JvmOpcode opcode, uint16_t local) {
+    auto shortForm = static_cast<uint8_t>(opcode == JvmOpcode::ASTORE ? JvmOpcode::ASTORE_0 : JvmOpcode::ISTORE_0);
+    if (local < 4) {
+        u1(static_cast<uint8_t>(shortForm + local));
+    } else if (local < 256) {
+        u1(opcode);
+        u1(static_cast<uint8_t>(local));
+    } else {
+        u1(JvmOpcode::WIDE);
+        u1(opcode);
+        u2(local);
+    }
+    adjust(-1);
+}
+
+void CodeBuilder::pushInt(int32_t value) {
+    if (value >= -1 && value <= 5) {
+        u1(static_cast<uint8_t>(static_cast<int>(JvmOpcode::ICONST_0) + value));
+    } else if (value >= -128 && value <= 127) {
+        u1(JvmOpcode::BIPUSH);
+        u1(static_cast<uint8_t>(value));
+    } else if (value >= -32768 && value <= 32767) {
+        u1(JvmOpcode::SIPUSH);
+        u2(static_cast<uint16_t>(value));
+    } else {
+        uint16_t index = owner.integer(value);
+        if (index < 256) {
+            u1(JvmOpcode::LDC);
+            u1(static_cast<uint8_t>(index));
+        } else {
+            u1(JvmOpcode::LDC_W);
+            u2(index);
+        }
+    }
+    adjust(1);
+}
+
+void CodeBuilder::pushString(const std::string& value) {
+    uint16_t index = owner.string(value);
+    if (index < 256) {
+        u1(JvmOpcode::LDC);
+        u1(static_cast<uint8_t>(index));
+    } else {
+        u1(JvmOpcode::LDC_W);
+        u2(index);
+    }
+    adjust(1);
+}
+
+void CodeBuilder::typeOp(JvmOpcode opcode, const std::string& className) {
+    u1(opcode);
+    u2(owner.classRef(className));
+    adjust(opcode == JvmOpcode::NEW ? 1 : 0);   // CHECKCAST leaves the stack as is
+}
+
+void CodeBuilder::field(JvmOpcode opcode, const std::string& ownerName, const std::string& name,
+                        const std::string& descriptor) {
+    u1(opcode);
+    u2(owner.memberRef(9, ownerName, name, descriptor));
+
+    int size = typeSize(descriptor[0]);
+    switch (opcode) {
+        case JvmOpcode::GETSTATIC: adjust(size); break;
+        case JvmOpcode::PUTSTATIC: adjust(-size); break;
+        case JvmOpcode::GETFIELD: adjust(size - 1); break;
+        default: adjust(-size - 1); break;    // PUTFIELD
+    }
+}
+
+void CodeBuilder::invoke(JvmOpcode opcode, const std::string& ownerName, const std::string& name,
+                         const std::string& descriptor) {
+    u1(opcode);
+    u2(owner.memberRef(10, ownerName, name, descriptor));
+    adjust(callDelta(descriptor) - (opcode == JvmOpcode::INVOKESTATIC ? 0 : 1));
+}
+
+void CodeBuilder::branch(JvmOpcode opcode, Label target) {
+    size_t instruction = code.size();
+    u1(opcode);
+    fixups.push_back({instruction, code.size(), target, false});
+    u2(0);
+    if (opcode != JvmOpcode::GOTO) {
+        adjust(-1);    // the conditional branches used here test one int
+    }
+}
+
+void CodeBuilder::lookupSwitch(Label defaultTarget, const std::map<int32_t, Label>& cases) {
+    size_t instruction = code.size();
+    u1(JvmOpcode::LOOKUPSWITCH);
+    while (code.size() % 4 != 0) {
+        u1(0);
+    }
+    fixups.push_back({instruction, code.size(), defaultTarget, true});
+    u4(0);
+    u4(static_cast<uint32_t>(cases.size()));
+    for (const auto& entry : cases) {
+        u4(static_cast<uint32_t>(entry.first));
+        fixups.push_back({instruction, code.size(), entry.second, true});
+        u4(0);
+    }
+    adjust(-1);
+}
+
+void CodeBuilder::u2(uint16_t value) {
+    put2(code, value);
+}
+
+void CodeBuilder::u4(uint32_t value) {
+    put4(code, value);
+}
+
+void CodeBuilder::adjust(int delta) {
+    depth += delta;
+    if (depth > maxStack) maxStack = depth;
+}
+
+void CodeBuilder::resolve() {
+    if (code.size() > 65535) {
+        throw std::runtime_error("method code exceeds 64 KiB");
+    }
+    for (const Fixup& fixup : fixups) {
+        if (labels[fixup.label] == SIZE_MAX) {
+            throw std::logic_error("branch to an unbound label");
+        }
+        long offset = static_cast<long>(labels[fixup.label]) - static_cast<long>(fixup.instruction);
+        if (fixup.wide) {
+            auto value = static_cast<uint32_t>(static_cast<int32_t>(offset));
+            for (int i = 0; i < 4; i++) {
+                code[fixup.position + i] = static_cast<uint8_t>(value >> (24 - 8 * i));
+            }
+        } else {
+            if (offset < -32768 || offset > 32767) {
+                throw std::runtime_error("branch offset exceeds 16 bits");
+            }
+            auto value = static_cast<uint16_t>(static_cast<int16_t>(offset));
+            code[fixup.position] = static_cast<uint8_t>(value >> 8);
+            code[fixup.position + 1] = static_cast<uint8_t>(value);
+        }
+    }
+}
+
+// ClassWriter
+
+ClassWriter::ClassWriter(uint16_t access, const std::string& name, const std::string& superName)
+    : name(name), access(access) {
+    thisClass = classRef(name);
+    superClass = classRef(superName);
+}
+
+void ClassWriter::addInterface(const std::string& interfaceName) {
+    interfaces.push_back(classRef(interfaceName));
+}
+
+void ClassWriter::addField(uint16_t fieldAccess, const std::string& fieldName, const std::string& descriptor) {
+    put2(fields, fieldAccess);
+    put2(fields, utf8(fieldName));
+    put2(fields, utf8(descriptor));
+    put2(fields, 0);
+    fieldCount++;
+}
+
+void ClassWriter::addMethod(uint16_t methodAccess, const std::string& methodName, const std::string& descriptor,
+                            CodeBuilder& code, uint16_t maxLocals) {
+    code.resolve();
+
+    std::vector<uint8_t> stackMap;
+    size_t previous = 0;
+    for (size_t i = 0; i < code.frames.size(); i++) {
+        const auto& frame = code.frames[i];
+        size_t delta = i == 0 ? frame.offset : frame.offset - previous - 1;
+        previous = frame.offset;
+
+        stackMap.push_back(FULL_FRAME);
+        put2(stackMap, static_cast<uint32_t>(delta));
+        for (const auto* types : {&frame.locals, &frame.stack}) {
+            put2(stackMap, static_cast<uint32_t>(types->size()));
+            for (const auto& type : *types) {
+                stackMap.push_back(type.tag);
+                if (type.tag == ITEM_OBJECT) {
+                    put2(stackMap, type.classIndex);
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> body;
+    put2(body, code.getMaxStack());
+    put2(body, maxLocals);
+    put4(body, static_cast<uint32_t>(code.code.size()));
+    body.insert(body.end(), code.code.begin(), code.code.end());
+    put2(body, static_cast<uint32_t>(code.handlers.size()));
+    for (const auto& handler : code.handlers) {
+        put2(body, static_cast<uint32_t>(code.labels[handler.start]));
+        put2(body, static_cast<uint32_t>(code.labels[handler.end]));
+        put2(body, static_cast<uint32_t>(code.labels[handler.handler]));
+        put2(body, handler.type);
+    }
+    if (code.frames.empty()) {
+        put2(body, 0);
+    } else {
+        put2(body, 1);
+        put2(body, utf8("StackMapTable"));
+        put4(body, static_cast<uint32_t>(stackMap.size() + 2));
+        put2(body, static_cast<uint32_t>(code.frames.size()));
+        body.insert(body.end(), stackMap.begin(), stackMap.end());
+    }
+
+    put2(methods, methodAccess);
+    put2(methods, utf8(methodName));
+    put2(methods, utf8(descriptor));
+    put2(methods, 1);
+    put2(methods, utf8("Code"));
+    put4(methods, static_cast<uint32_t>(body.size()));
+    methods.insert(methods.end(), body.begin(), body.end());
+    methodCount++;
+}
+
+uint16_t ClassWriter::utf8(const std::string& value) {
+    std::string encoded = modifiedUtf8(value);
+    if (encoded.size() > 65535) {
+        throw std::runtime_error("string constant exceeds 64 KiB");
+    }
+    std::string key(1, static_cast<char>(TAG_UTF8));
+    putString(key, static_cast<uint16_t>(encoded.size()));
+    return addEntry(key + encoded);
+}
+
+uint16_t ClassWriter::classRef(const std::string& internalName) {
+    std::string key(1, static_cast<char>(TAG_CLASS));
+    putString(key, utf8(internalName));
+    return addEntry(key);
+}
+
+uint16_t ClassWriter::string(const std::string& value) {
+    std::string key(1, static_cast<char>(TAG_STRING));
+    putString(key, utf8(value));
+    return addEntry(key);
+}
+
+uint16_t ClassWriter::integer(int32_t value) {
+    std::string key(1, static_cast<char>(TAG_INTEGER));
+    auto bits = static_cast<uint32_t>(value);
+    putString(key, static_cast<uint16_t>(bits >> 16));
+    putString(key, static_cast<uint16_t>(bits & 0xffff));
+    return addEntry(key);
+}
+
+uint16_t ClassWriter::memberRef(uint8_t tag, const std::string& owner, const std::string& memberName,
+                                const std::string& descriptor) {
+    std::string nameAndType(1, static_cast<char>(TAG_NAME_AND_TYPE));
+    putString(nameAndType, utf8(memberName));
+    putString(nameAndType, utf8(descriptor));
+
+    std::string key(1, static_cast<char>(tag));
+    putString(key, classRef(owner));
+    putString(key, addEntry(nameAndType));
+    return addEntry(key);
+}
+
+uint16_t ClassWriter::addEntry(const std::string& key) {
+    auto it = poolIndex.find(key);
+    if (it != poolIndex.end()) {
+        return it->second;
+    }
+    if (poolCount == 65535) {
+        throw std::runtime_error("constant pool exceeds 65535 entries");
+    }
+    pool.insert(pool.end(), key.begin(), key.end());
+    poolIndex.emplace(key, poolCount);
+    return poolCount++;
+}
+
+std::vector<uint8_t> ClassWriter::toBytes() const {
+    std::vector<uint8_t> out;
+    put4(out, 0xCAFEBABE);
+    put2(out, 0);
+    put2(out, MAJOR_VERSION);
+    put2(out, poolCount);
+    out.insert(out.end(), pool.begin(), pool.end());
+    put2(out, access);
+    put2(out, thisClass);
+    put2(out, superClass);
+    put2(out, static_cast<uint32_t>(interfaces.size()));
+    for (uint16_t index : interfaces) {
+        put2(out, index);
+    }
+    put2(out, fieldCount);
+    out.insert(out.end(), fields.begin(), fields.end());
+    put2(out, methodCount);
+    out.insert(out.end(), methods.begin(), methods.end());
+    put2(out, 0);
+    return out;
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ClassWriter;
+
+// The JVM instructions generated code is made of
+enum class JvmOpcode : uint8_t {
+    ACONST_NULL = 0x01,
+    ICONST_0 = 0x03,
+    BIPUSH = 0x10,
+    SIPUSH = 0x11,
+    LDC = 0x12,
+    LDC_W = 0x13,
+    ILOAD = 0x15,
+    ALOAD = 0x19,
+    ILOAD_0 = 0x1a,
+    ALOAD_0 = 0x2a,
+    AALOAD = 0x32,
+    ISTORE = 0x36,
+    ASTORE = 0x3a,
+    ISTORE_0 = 0x3b,
+    ASTORE_0 = 0x4b,
+    DUP = 0x59,
+    SWAP = 0x5f,
+    IFEQ = 0x99,
+    IFNE = 0x9a,
+    GOTO = 0xa7,
+    LOOKUPSWITCH = 0xab,
+    RETURN = 0xb1,
+    GETSTATIC = 0xb2,
+    PUTSTATIC = 0xb3,
+    GETFIELD = 0xb4,
+    PUTFIELD = 0xb5,
+    INVOKEVIRTUAL = 0xb6,
+    INVOKESPECIAL = 0xb7,
+    INVOKESTATIC = 0xb8,
+    NEW = 0xbb,
+    ATHROW = 0xbf,
+    CHECKCAST = 0xc0,
+    WIDE = 0xc4
+};
+
+// The body of one method: instructions, the exception table and the stack map frames
+// the verifier needs at branch targets. Branches go to labels, which are resolved when
+// the method is added to its class. The maximum stack depth is tracked as instructions
+// are emitted; a frame resets the current depth to the size of its stack.
+//
+// Throws std::runtime_error if the method grows past what the class-file format can
+// encode (16-bit branch offsets, 64 KiB of code).
+class CodeBuilder {
+public:
+    // A verification type in a stack map frame
+    struct Type {
+        uint8_t tag;
+        uint16_t classIndex;
+    };
+
+    using Label = size_t;
+
+    explicit CodeBuilder(ClassWriter& owner) : owner(owner) {}
+
+    static Type integerType() { return {1, 0}; }
+    Type objectType(const std::string& className);
+
+    Label newLabel();
+    void bind(Label label);
+
+    // Declares the types at the current offset. Required at every branch target, every
+    // exception handler and every instruction that follows an unconditional transfer.
+    void frame(const std::vector<Type>& locals, const std::vector<Type>& stack);
+
+    void tryCatch(Label start, Label end, Label handler, const std::string& exceptionClass);
+
+    // Instructions. `op` is for those with no operands; the stack effect of the others
+    // follows from their operands.
+    void op(JvmOpcode opcode, int stackDelta);
+    void load(JvmOpcode opcode, uint16_t local);     // ALOAD / ILOAD
+    void store(JvmOpcode opcode, uint16_t local);    // ASTORE / ISTORE
+    void pushInt(int32_t value);
+    void pushString(const std::string& value);
+    void typeOp(JvmOpcode opcode, const std::string& className);  // NEW / CHECKCAST
+    void field(JvmOpcode opcode, const std::string& owner, const std::string& name, const std::string& descriptor);
+    void invoke(JvmOpcode opcode, const std::string& owner, const std::string& name, const std::string& descriptor);
+    void branch(JvmOpcode opcode, Label target);     // GOTO / IFEQ / IFNE
+    void lookupSwitch(Label defaultTarget, const std::map<int32_t, Label>& cases);
+
+    uint16_t getMaxStack() const { return static_cast<uint16_t>(maxStack); }
+
+private:
+    friend class ClassWriter;
+
+    struct Fixup {
+        size_t instruction;
+        size_t position;
+        Label label;
+        bool wide;
+    };
+
+    struct Frame {
+        size_t offset;
+        std::vector<Type> locals;
+        std::vector<Type> stack;
+    };
+
+    struct Handler {
+        Label start;
+        Label end;
+        Label handler;
+        uint16_t type;
+    };
+
+    ClassWriter& owner;
+    std::vector<uint8_t> code;
+    std::vector<size_t> labels;
+    std::vector<Fixup> fixups;
+    std::vector<Frame> frames;
+    std::vector<Handler> handlers;
+    int depth = 0;
+    int maxStack = 0;
+
+    void u1(uint8_t value) { code.push_back(value); }
+    void u1(JvmOpcode opcode) { code.push_back(static_cast<uint8_t>(opcode)); }
+    void u2(uint16_t value);
+    void u4(uint32_t value);
+    void adjust(int delta);
+    void resolve();
+};
+
+// Writes a JVM class file: a constant pool, fields without attributes, and methods
+// whose Code carries an exception table and a StackMapTable. That is all generated
+// handler classes need; see JvmBackend.
+class ClassWriter {
+public:
+    static constexpr uint16_t ACC_PUBLIC = 0x0001;
+    static constexpr uint16_t ACC_PRIVATE = 0x0002;
+    static constexpr uint16_t ACC_FINAL = 0x0010;
+    static constexpr uint16_t ACC_SUPER = 0x0020;
+
+    // Java 8 class files: the oldest version that requires stack maps, and one every
+    // supported JVM loads
+    static constexpr uint16_t MAJOR_VERSION = 52;
+
+    ClassWriter(uint16_t access, const std::string& name, const std::string& superName);
+
+    void addInterface(const std::string& name);
+    void addField(uint16_t access, const std::string& name, const std::string& descriptor);
+    void addMethod(uint16_t access, const std::string& name, const std::string& descriptor,
+                   CodeBuilder& code, uint16_t maxLocals);
+
+    const std::string& getName() const { return name; }
+
+    // Constant pool entries, each added once
+    uint16_t utf8(const std::string& value);
+    uint16_t classRef(const std::string& internalName);
+    uint16_t string(const std::string& value);
+    uint16_t integer(int32_t value);
+    uint16_t memberRef(uint8_t tag, const std::string& owner, const std::string& name, const std::string& descriptor);
+
+    std::vector<uint8_t> toBytes() const;
+
+private:
+    std::string name;
+    uint16_t access;
+    uint16_t thisClass;
+    uint16_t superClass;
+    std::vector<uint16_t> interfaces;
+    std::vector<uint8_t> fields;
+    uint16_t fieldCount = 0;
+    std::vector<uint8_t> methods;
+    uint16_t methodCount = 0;
+
+    std::vector<uint8_t> pool;
+    uint16_t poolCount = 1;
+    std::map<std::string, uint16_t> poolIndex;   // tag and payload -> index
+
+    uint16_t addEntry(const std::string& key);
+};
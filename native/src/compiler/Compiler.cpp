@@ -0,0 +1,476 @@
+#include "Compiler.h"
+#include <BlockStatement.h>
+#include <SendCommand.h>
+#include <TeleportCommand.h>
+#include <HaltCommand.h>
+#include <CancelEventStatement.h>
+#include <VariableAssignment.h>
+#include <BinaryExpression.h>
+#include <StringLiteral.h>
+#include <BooleanLiteral.h>
+#include <TypeLiteral.h>
+#include <VariableReference.h>
+#include <InterpolatedString.h>
+#include <Concat.h>
+#include <algorithm>
+
+namespace {
+    using Op = BinaryExpression::Operator;
+
+    // Capacity the runtime reserves for a rendered string, as the tree walker does
+    int32_t capacityFor(size_t literalLength, size_t partCount) {
+        return static_cast<int32_t>(std::min<size_t>(literalLength + 16 * partCount, INT32_MAX));
+    }
+
+    bool sameValue(const VariableReference& first, const VariableReference& second) {
+        return first.getSlot() == second.getSlot() && first.getPath() == second.getPath();
+    }
+
+    // The literals of a condition that only tests one value for substrings: `subject
+    // contains "literal"`, or such tests joined by OR, in evaluation order. Returns the
+    // subject, or null if the condition is anything else.
+    const VariableReference* containsTests(const Expression* condition, std::vector<std::string>& literals) {
+        const VariableReference* subject = nullptr;
+        std::vector<const Expression*> pending{condition};
+        while (!pending.empty()) {
+            auto binary = dynamic_cast<const BinaryExpression*>(pending.back());
+            pending.pop_back();
+            if (!binary) {
+                return nullptr;
+            }
+            if (binary->getOperator() == Op::OR) {
+                pending.push_back(binary->getRight().get());
+                pending.push_back(binary->getLeft().get());
+                continue;
+            }
+
+            auto reference = dynamic_cast<const VariableReference*>(binary->getLeft().get());
+            auto literal = dynamic_cast<const StringLiteral*>(binary->getRight().get());
+            if (binary->getOperator() != Op::CONTAINS || !reference || !literal || reference->getSlot() < 0 ||
+                (subject && !sameValue(*subject, *reference))) {
+                return nullptr;
+            }
+            subject = reference;
+            literals.push_back(literal->getValue());
+        }
+        return subject;
+    }
+}
+
+std::optional<Program> Compiler::compile(const ExecuteBlock& block) {
+    Compiler compiler(static_cast<int32_t>(block.getSlotNames().size()));
+    try {
+        for (const auto& statement : block.getStatements()) {
+            compiler.compileStatement(statement.get());
+        }
+    } catch (const Unsupported&) {
+        return std::nullopt;
+    }
+    compiler.emit(Opcode::RETURN);
+    compiler.finish();
+    return std::move(compiler.program);
+}
+
+Compiler::Compiler(int32_t slotCount) : nextRegister(slotCount) {
+    program.registerCount = slotCount;
+}
+
+void Compiler::compileStatement(const Statement* statement) {
+    if (!statement) {
+        return;
+    }
+    markLine(statement);
+
+    // Temporaries only live until the statement is done
+    int32_t firstTemporary = nextRegister;
+
+    if (auto send = dynamic_cast<const SendCommand*>(statement)) {
+        int32_t message = compileMessage(send->getMessage().get());
+        int32_t target = send->getTarget() ? compileExpression(send->getTarget().get()) : -1;
+        emit(Opcode::SEND, {message, target});
+    } else if (auto teleport = dynamic_cast<const TeleportCommand*>(statement)) {
+        int32_t entity = compileExpression(teleport->getEntity().get());
+        int32_t target = compileExpression(teleport->getTarget().get());
+        emit(Opcode::TELEPORT, {entity, target});
+    } else if (dynamic_cast<const HaltCommand*>(statement)) {
+        emit(Opcode::HALT);
+    } else if (dynamic_cast<const CancelEventStatement*>(statement)) {
+        emit(Opcode::CANCEL);
+    } else if (auto chain = dynamic_cast<const IfStatement*>(statement)) {
+        compileIfChain(chain);
+    } else if (auto switchStatement = dynamic_cast<const SwitchStatement*>(statement)) {
+        compileSwitch(switchStatement);
+    } else if (auto block = dynamic_cast<const BlockStatement*>(statement)) {
+        for (const auto& child : block->getStatements()) {
+            compileStatement(child.get());
+        }
+    } else if (auto assignment = dynamic_cast<const VariableAssignment*>(statement)) {
+        int32_t slot = assignment->getSlot();
+        if (slot < 0) {
+            throw Unsupported{};
+        }
+
+        if (assignment->getPath().empty()) {
+            int32_t value = compileExpression(assignment->getValue().get(), slot);
+            if (value != slot) {
+                emit(Opcode::MOVE, {slot, value});
+            }
+        } else {
+            int32_t value = compileExpression(assignment->getValue().get());
+            emit(Opcode::SET_PATH, {slot, pathConstant(assignment->getPath()), value,
+                                    stringConstant(assignment->getVariableName())});
+        }
+    } else {
+        throw Unsupported{};
+    }
+
+    nextRegister = firstTemporary;
+}
+
+void Compiler::compileIfChain(const IfStatement* chain) {
+    // Walk the else-if links in a loop so long chains do not recurse
+    int32_t end = newLabel();
+    const Statement* current = chain;
+
+    while (auto link = dynamic_cast<const IfStatement*>(current)) {
+        if (link != chain) {
+            markLine(link);
+        }
+
+        const Statement* rest = nullptr;
+        if (compileMatch(link, end, rest)) {
+            current = rest;
+            continue;
+        }
+
+        int32_t next = newLabel();
+        int32_t firstTemporary = nextRegister;
+        compileCondition(link->getCondition().get(), false, next);
+        nextRegister = firstTemporary;
+
+        compileStatement(link->getThenStatement().get());
+        current = link->getElseStatement().get();
+        if (current) {
+            emitJump(Opcode::JUMP, -1, end);
+        }
+        bind(next);
+    }
+
+    compileStatement(current);
+    bind(end);
+}
+
+// Compiles the longest run of links from `first` whose conditions are contains tests on
+// one value as a MATCH, if the run has enough patterns. A link's patterns all jump to
+// its branch, and the first pattern found in chain order wins, so the first link whose
+// test holds runs, as with separate tests. `rest` is what follows the run.
+bool Compiler::compileMatch(const IfStatement* first, int32_t end, const Statement*& rest) {
+    std::vector<const IfStatement*> links;
+    std::vector<std::vector<std::string>> patterns;
+    const VariableReference* subject = nullptr;
+    size_t patternCount = 0;
+
+    const Statement* current = first;
+    while (auto link = dynamic_cast<const IfStatement*>(current)) {
+        std::vector<std::string> literals;
+        const VariableReference* tested = containsTests(link->getCondition().get(), literals);
+        if (!tested || (subject && !sameValue(*subject, *tested))) {
+            break;
+        }
+        subject = tested;
+        links.push_back(link);
+        patternCount += literals.size();
+        patterns.push_back(std::move(literals));
+        current = link->getElseStatement().get();
+    }
+    if (patternCount < MATCH_MIN_PATTERNS) {
+        return false;
+    }
+    rest = current;
+
+    int32_t firstTemporary = nextRegister;
+    int32_t value = compileExpression(subject);
+    nextRegister = firstTemporary;
+
+    Constant table{Constant::Kind::MATCH, {}, {}};
+    std::vector<int32_t> branches;
+    for (const auto& literals : patterns) {
+        branches.push_back(newLabel());
+        for (const auto& literal : literals) {
+            table.strings.push_back(literal);
+            table.targets.push_back(branches.back());
+        }
+    }
+    int32_t tableIndex = static_cast<int32_t>(program.constants.size());
+    program.constants.push_back(std::move(table));
+
+    int32_t defaultLabel = newLabel();
+    emit(Opcode::MATCH, {value, tableIndex, defaultLabel});
+    fixups.emplace_back(program.code.size() - 1, defaultLabel);
+
+    for (size_t i = 0; i < links.size(); i++) {
+        bind(branches[i]);
+        compileStatement(links[i]->getThenStatement().get());
+        // The last branch falls through when nothing follows the run
+        if (i + 1 < links.size() || rest) {
+            emitJump(Opcode::JUMP, -1, end);
+        }
+    }
+    bind(defaultLabel);
+    return true;
+}
+
+void Compiler::compileSwitch(const SwitchStatement* statement) {
+    int32_t subject = compileExpression(statement->getSubject().get());
+
+    const auto& branches = statement->getBranches();
+    Constant table{Constant::Kind::SWITCH, statement->getLabels(), {}};
+    for (size_t i = 0; i < branches.size(); i++) {
+        table.targets.push_back(newLabel());
+    }
+    int32_t tableIndex = static_cast<int32_t>(program.constants.size());
+    program.constants.push_back(std::move(table));
+
+    int32_t defaultLabel = newLabel();
+    int32_t end = newLabel();
+    emit(Opcode::SWITCH, {subject, tableIndex, defaultLabel});
+    fixups.emplace_back(program.code.size() - 1, defaultLabel);
+
+    for (size_t i = 0; i < branches.size(); i++) {
+        bind(program.constants[tableIndex].targets[i]);
+        compileStatement(branches[i].get());
+        // The last branch falls through when there is no default to skip
+        if (i + 1 < branches.size() || statement->getDefaultStatement()) {
+            emitJump(Opcode::JUMP, -1, end);
+        }
+    }
+
+    bind(defaultLabel);
+    compileStatement(statement->getDefaultStatement().get());
+    bind(end);
+}
+
+void Compiler::compileCondition(const Expression* condition, bool jumpWhen, int32_t label) {
+    if (auto literal = dynamic_cast<const BooleanLiteral*>(condition)) {
+        if (literal->getValue() == jumpWhen) {
+            emitJump(Opcode::JUMP, -1, label);
+        }
+        return;
+    }
+
+    auto binary = dynamic_cast<const BinaryExpression*>(condition);
+    if (binary && (binary->getOperator() == Op::AND || binary->getOperator() == Op::OR)) {
+        // `a && b` jumps when false as soon as either side is false; jumping when it is
+        // true needs both, so a false left side skips the right one. OR is the mirror.
+        bool decidesWhen = binary->getOperator() == Op::OR;
+        if (jumpWhen == decidesWhen) {
+            compileCondition(binary->getLeft().get(), jumpWhen, label);
+            compileCondition(binary->getRight().get(), jumpWhen, label);
+        } else {
+            int32_t skip = newLabel();
+            compileCondition(binary->getLeft().get(), decidesWhen, skip);
+            compileCondition(binary->getRight().get(), jumpWhen, label);
+            bind(skip);
+        }
+        return;
+    }
+
+    int32_t value = compileExpression(condition);
+    emitJump(jumpWhen ? Opcode::JUMP_IF_TRUE : Opcode::JUMP_IF_FALSE, value, label);
+}
+
+int32_t Compiler::compileExpression(const Expression* expression, int32_t target) {
+    // A target is only written once every operand has been read, so `x = x + "!"` can
+    // build straight into x's slot
+    auto destination = [this, target]() { return target >= 0 ? target : newRegister(); };
+
+    if (auto literal = dynamic_cast<const StringLiteral*>(expression)) {
+        int32_t dst = destination();
+        emit(Opcode::LOAD_CONST, {dst, stringConstant(literal->getValue())});
+        return dst;
+    }
+    if (auto type = dynamic_cast<const TypeLiteral*>(expression)) {
+        int32_t dst = destination();
+        emit(Opcode::LOAD_CONST, {dst, stringConstant(type->getTypeName())});
+        return dst;
+    }
+    if (auto literal = dynamic_cast<const BooleanLiteral*>(expression)) {
+        int32_t dst = destination();
+        emit(Opcode::LOAD_BOOL, {dst, literal->getValue() ? 1 : 0});
+        return dst;
+    }
+    if (auto reference = dynamic_cast<const VariableReference*>(expression)) {
+        if (reference->getSlot() < 0) {
+            throw Unsupported{};
+        }
+        if (reference->getPath().empty()) {
+            return reference->getSlot();
+        }
+        int32_t dst = destination();
+        emit(Opcode::GET_PATH, {dst, reference->getSlot(), pathConstant(reference->getPath())});
+        return dst;
+    }
+    if (auto interpolated = dynamic_cast<const InterpolatedString*>(expression)) {
+        return compileParts(interpolated->getParts(), interpolated->getLiteralLength(), CONCAT_SKIP_NULL, target);
+    }
+    if (auto concat = dynamic_cast<const Concat*>(expression)) {
+        return compileParts(concat->getParts(), concat->getLiteralLength(), 0, target);
+    }
+    if (auto binary = dynamic_cast<const BinaryExpression*>(expression)) {
+        if (binary->getOperator() == Op::AND || binary->getOperator() == Op::OR) {
+            // The result register is set on both paths, after the operands were read
+            int32_t dst = newRegister();
+            int32_t isFalse = newLabel();
+            int32_t end = newLabel();
+            compileCondition(expression, false, isFalse);
+            emit(Opcode::LOAD_BOOL, {dst, 1});
+            emitJump(Opcode::JUMP, -1, end);
+            bind(isFalse);
+            emit(Opcode::LOAD_BOOL, {dst, 0});
+            bind(end);
+            return dst;
+        }
+
+        int32_t left = compileOperand(binary->getLeft().get());
+        int32_t right = compileOperand(binary->getRight().get());
+        int32_t dst = destination();
+        emit(Opcode::BINARY, {dst, static_cast<int32_t>(binary->getOperator()), left, right});
+        return dst;
+    }
+
+    // EventAccessExpression and anything newer have no runtime rule yet
+    throw Unsupported{};
+}
+
+int32_t Compiler::compileOperand(const Expression* expression) {
+    // String and type literals are read straight from the constant pool
+    if (auto literal = dynamic_cast<const StringLiteral*>(expression)) {
+        return -(stringConstant(literal->getValue()) + 1);
+    }
+    if (auto type = dynamic_cast<const TypeLiteral*>(expression)) {
+        return -(stringConstant(type->getTypeName()) + 1);
+    }
+    return compileExpression(expression);
+}
+
+int32_t Compiler::compileMessage(const Expression* message) {
+    // Literal text had its color tags translated by the parser; only values inserted at
+    // runtime are translated here
+    if (dynamic_cast<const StringLiteral*>(message)) {
+        return compileOperand(message);
+    }
+    if (auto interpolated = dynamic_cast<const InterpolatedString*>(message)) {
+        return compileParts(interpolated->getParts(), interpolated->getLiteralLength(),
+                            CONCAT_SKIP_NULL | CONCAT_TRANSLATE, -1);
+    }
+    if (auto concat = dynamic_cast<const Concat*>(message)) {
+        return compileParts(concat->getParts(), concat->getLiteralLength(), CONCAT_TRANSLATE, -1);
+    }
+
+    int32_t value = compileExpression(message);
+    int32_t dst = newRegister();
+    emit(Opcode::TO_MESSAGE, {dst, value});
+    return dst;
+}
+
+int32_t Compiler::compileParts(const std::vector<std::shared_ptr<Expression>>& parts, size_t literalLength,
+                               int32_t flags, int32_t target) {
+    std::vector<int32_t> operands;
+    operands.reserve(parts.size());
+    for (const auto& part : parts) {
+        operands.push_back(compileOperand(part.get()));
+    }
+
+    int32_t dst = target >= 0 ? target : newRegister();
+    emit(Opcode::CONCAT, {dst, flags, capacityFor(literalLength, parts.size()),
+                          static_cast<int32_t>(operands.size())});
+    program.code.insert(program.code.end(), operands.begin(), operands.end());
+    return dst;
+}
+
+void Compiler::emit(Opcode opcode, std::initializer_list<int32_t> operands) {
+    program.code.push_back(static_cast<int32_t>(opcode));
+    program.code.insert(program.code.end(), operands);
+}
+
+void Compiler::emitJump(Opcode opcode, int32_t condition, int32_t label) {
+    if (opcode == Opcode::JUMP) {
+        emit(opcode, {label});
+    } else {
+        emit(opcode, {condition, label});
+    }
+    fixups.emplace_back(program.code.size() - 1, label);
+}
+
+int32_t Compiler::newLabel() {
+    labels.push_back(-1);
+    return static_cast<int32_t>(labels.size() - 1);
+}
+
+void Compiler::bind(int32_t label) {
+    labels[label] = static_cast<int32_t>(program.code.size());
+}
+
+int32_t Compiler::newRegister() {
+    int32_t reg = nextRegister++;
+    program.registerCount = std::max(program.registerCount, nextRegister);
+    return reg;
+}
+
+int32_t Compiler::stringConstant(const std::string& value) {
+    auto it = stringConstants.find(value);
+    if (it != stringConstants.end()) {
+        return it->second;
+    }
+
+    int32_t index = static_cast<int32_t>(program.constants.size());
+    program.constants.push_back({Constant::Kind::STRING, {value}, {}});
+    stringConstants.emplace(value, index);
+    return index;
+}
+
+int32_t Compiler::pathConstant(const std::vector<std::string>& path) {
+    std::string key;
+    for (const auto& segment : path) {
+        key += segment;
+        key += '\0';
+    }
+
+    auto it = pathConstants.find(key);
+    if (it != pathConstants.end()) {
+        return it->second;
+    }
+
+    int32_t index = static_cast<int32_t>(program.constants.size());
+    program.constants.push_back({Constant::Kind::PATH, path, {}});
+    pathConstants.emplace(std::move(key), index);
+    return index;
+}
+
+void Compiler::markLine(const Statement* statement) {
+    int32_t line = statement->getLine();
+    if (line <= 0) {
+        return;
+    }
+
+    int32_t offset = static_cast<int32_t>(program.code.size());
+    if (!program.lines.empty() && program.lines.back().first == offset) {
+        // Nothing was emitted for the previous statement (e.g. a block's opening line)
+        program.lines.back().second = line;
+    } else if (program.lines.empty() || program.lines.back().second != line) {
+        program.lines.emplace_back(offset, line);
+    }
+}
+
+void Compiler::finish() {
+    for (const auto& fixup : fixups) {
+        program.code[fixup.first] = labels[fixup.second];
+    }
+    for (auto& constant : program.constants) {
+        if (constant.kind == Constant::Kind::SWITCH || constant.kind == Constant::Kind::MATCH) {
+            for (auto& target : constant.targets) {
+                target = labels[target];
+            }
+        }
+    }
+}
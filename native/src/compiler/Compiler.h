@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Bytecode.h"
+#include "ExecuteBlock.h"
+#include "Statement.h"
+#include "Expression.h"
+#include "IfStatement.h"
+#include "SwitchStatement.h"
+
+// Lowers a resolved execute block (after SlotResolver and the other passes) into the
+// register bytecode described in Bytecode.h.
+//
+// Conditions compile to jumps, so `a && b` in an if never materialises a Boolean, and
+// an else-if chain is a run of tests that each jump to the next link. Links that only
+// test one value for string literals with `contains` (a chat filter's banned phrases)
+// become a single MATCH once there are MATCH_MIN_PATTERNS literals, so the message is
+// scanned once for all of them. Temporaries are released after every statement, so
+// registerCount stays close to slotCount.
+//
+// Returns nothing for a block the bytecode cannot express - a reference SlotResolver
+// left unbound or an expression the executor has no rule for - and the runtime then
+// keeps walking the tree for it.
+class Compiler {
+public:
+    static constexpr size_t MATCH_MIN_PATTERNS = 3;
+
+    static std::optional<Program> compile(const ExecuteBlock& block);
+
+private:
+    explicit Compiler(int32_t slotCount);
+
+    struct Unsupported {};
+
+    Program program;
+    int32_t nextRegister;
+    std::vector<int32_t> labels;                      // code offset of each label, -1 until bound
+    std::vector<std::pair<size_t, int32_t>> fixups;   // (code index, label) to patch
+    std::unordered_map<std::string, int32_t> stringConstants;
+    std::unordered_map<std::string, int32_t> pathConstants;
+
+    void compileStatement(const Statement* statement);
+    void compileIfChain(const IfStatement* chain);
+    bool compileMatch(const IfStatement* first, int32_t end, const Statement*& rest);
+    void compileSwitch(const SwitchStatement* statement);
+    void compileCondition(const Expression* condition, bool jumpWhen, int32_t label);
+    int32_t compileExpression(const Expression* expression, int32_t target = -1);
+    int32_t compileOperand(const Expression* expression);
+    int32_t compileMessage(const Expression* message);
+    int32_t compileParts(const std::vector<std::shared_ptr<Expression>>& parts, size_t literalLength,
+                         int32_t flags, int32_t target);
+
+    void emit(Opcode opcode, std::initializer_list<int32_t> operands = {});
+    void emitJump(Opcode opcode, int32_t condition, int32_t label);
+    int32_t newLabel();
+    void bind(int32_t label);
+    int32_t newRegister();
+    int32_t stringConstant(const std::string& value);
+    int32_t pathConstant(const std::vector<std::string>& path);
+    void markLine(const Statement* statement);
+    void finish();
+};
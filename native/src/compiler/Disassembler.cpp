@@ -0,0 +1,158 @@
+#include "Disassembler.h"
+#include <cstdio>
+
+namespace {
+    std::string quote(const std::string& value) {
+        std::string out = "\"";
+        for (char c : value) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                default: out += c;
+            }
+        }
+        return out + "\"";
+    }
+
+    std::string offsetOf(int32_t target) {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "@%04d", target);
+        return buffer;
+    }
+}
+
+std::string Disassembler::disassemble(const Program& program, const std::vector<std::string>& slotNames) {
+    std::string out = "registers " + std::to_string(program.registerCount) +
+                      " (" + std::to_string(slotNames.size()) + " slots)\n";
+
+    for (size_t i = 0; i < program.constants.size(); i++) {
+        out += "  #" + std::to_string(i) + " = " + constant(program, static_cast<int32_t>(i)) + "\n";
+    }
+
+    const auto& code = program.code;
+    int32_t lastLine = 0;
+    for (size_t pc = 0; pc < code.size(); pc += 1 + Bytecode::operandCount(code, pc)) {
+        auto opcode = static_cast<Opcode>(code[pc]);
+        const int32_t* a = &code[pc + 1];
+        std::vector<std::string> operands;
+
+        switch (opcode) {
+            case Opcode::LOAD_CONST:
+                operands = {reg(a[0], slotNames), "#" + std::to_string(a[1])};
+                break;
+            case Opcode::LOAD_BOOL:
+                operands = {reg(a[0], slotNames), a[1] ? "true" : "false"};
+                break;
+            case Opcode::MOVE:
+            case Opcode::TO_MESSAGE:
+                operands = {reg(a[0], slotNames), reg(a[1], slotNames)};
+                break;
+            case Opcode::GET_PATH:
+                operands = {reg(a[0], slotNames), reg(a[1], slotNames), "#" + std::to_string(a[2])};
+                break;
+            case Opcode::SET_PATH:
+                operands = {reg(a[0], slotNames), "#" + std::to_string(a[1]), reg(a[2], slotNames),
+                            "#" + std::to_string(a[3])};
+                break;
+            case Opcode::BINARY:
+                operands = {reg(a[0], slotNames), Bytecode::operatorName(a[1]),
+                            operand(a[2], slotNames), operand(a[3], slotNames)};
+                break;
+            case Opcode::CONCAT: {
+                std::string flags;
+                if (a[1] & CONCAT_TRANSLATE) flags += "translate ";
+                if (a[1] & CONCAT_SKIP_NULL) flags += "skip-null ";
+                operands = {reg(a[0], slotNames), "[" + (flags.empty() ? "" : flags.substr(0, flags.size() - 1)) + "]",
+                            "cap " + std::to_string(a[2])};
+                for (int32_t i = 0; i < a[3]; i++) {
+                    operands.push_back(operand(a[4 + i], slotNames));
+                }
+                break;
+            }
+            case Opcode::JUMP:
+                operands = {offsetOf(a[0])};
+                break;
+            case Opcode::JUMP_IF_FALSE:
+            case Opcode::JUMP_IF_TRUE:
+                operands = {reg(a[0], slotNames), offsetOf(a[1])};
+                break;
+            case Opcode::SWITCH:
+            case Opcode::MATCH:
+                operands = {reg(a[0], slotNames), "#" + std::to_string(a[1]), "default " + offsetOf(a[2])};
+                break;
+            case Opcode::SEND:
+                operands = {operand(a[0], slotNames), a[1] < 0 ? "sender" : reg(a[1], slotNames)};
+                break;
+            case Opcode::TELEPORT:
+                operands = {reg(a[0], slotNames), reg(a[1], slotNames)};
+                break;
+            case Opcode::CANCEL:
+            case Opcode::HALT:
+            case Opcode::RETURN:
+                break;
+        }
+
+        // "%04zu  %-14s", built up so no field can be cut short
+        std::string line = std::to_string(pc);
+        if (line.size() < 4) line.insert(0, 4 - line.size(), '0');
+        line += "  ";
+        size_t nameEnd = line.size() + 14;
+        line += Bytecode::name(opcode);
+        if (line.size() < nameEnd) line.append(nameEnd - line.size(), ' ');
+        for (size_t i = 0; i < operands.size(); i++) {
+            line += (i > 0 ? ", " : "") + operands[i];
+        }
+
+        int32_t sourceLine = Bytecode::lineAt(program, pc);
+        if (sourceLine != lastLine) {
+            if (line.size() < 56) line.append(56 - line.size(), ' ');
+            line += " ; line " + std::to_string(sourceLine);
+            lastLine = sourceLine;
+        }
+        out += line + "\n";
+    }
+    return out;
+}
+
+std::string Disassembler::reg(int32_t index, const std::vector<std::string>& slotNames) {
+    std::string name = "r" + std::to_string(index);
+    if (index >= 0 && static_cast<size_t>(index) < slotNames.size()) {
+        name += "(" + slotNames[index] + ")";
+    }
+    return name;
+}
+
+std::string Disassembler::operand(int32_t rk, const std::vector<std::string>& slotNames) {
+    return rk >= 0 ? reg(rk, slotNames) : "#" + std::to_string(-(rk + 1));
+}
+
+std::string Disassembler::constant(const Program& program, int32_t index) {
+    const Constant& constant = program.constants[index];
+    switch (constant.kind) {
+        case Constant::Kind::STRING:
+            return quote(constant.strings[0]);
+        case Constant::Kind::PATH: {
+            std::string path = "path ";
+            for (size_t i = 0; i < constant.strings.size(); i++) {
+                path += (i > 0 ? "." : "") + constant.strings[i];
+            }
+            return path;
+        }
+        case Constant::Kind::SWITCH: {
+            std::string table = "switch {";
+            for (size_t i = 0; i < constant.strings.size(); i++) {
+                table += (i > 0 ? ", " : "") + quote(constant.strings[i]) + " -> " + offsetOf(constant.targets[i]);
+            }
+            return table + "}";
+        }
+        case Constant::Kind::MATCH: {
+            std::string table = "match {";
+            for (size_t i = 0; i < constant.strings.size(); i++) {
+                table += (i > 0 ? ", " : "") + quote(constant.strings[i]) + " -> " + offsetOf(constant.targets[i]);
+            }
+            return table + "}";
+        }
+    }
+    return "?";
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Bytecode.h"
+
+// Renders a Program as text for swoftc and debugging: the constant pool, then one
+// instruction per line with the source line wherever it changes.
+//
+//   #2 = path player.name
+//   0007  GET_PATH      r4, r1(event), #2                ; line 5
+//
+// Registers that are block slots are shown with their variable name.
+class Disassembler {
+public:
+    static std::string disassemble(const Program& program, const std::vector<std::string>& slotNames);
+
+private:
+    static std::string reg(int32_t index, const std::vector<std::string>& slotNames);
+    static std::string operand(int32_t rk, const std::vector<std::string>& slotNames);
+    static std::string constant(const Program& program, int32_t index);
+};
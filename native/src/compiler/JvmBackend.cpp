@@ -0,0 +1,428 @@
+#include "JvmBackend.h"
+#include "ClassWriter.h"
+#include <map>
+#include <stdexcept>
+
+namespace {
+    // Java classes and members the generated code refers to - must match the Java side
+    const char* const OBJECT = "java/lang/Object";
+    const char* const OBJECT_ARRAY = "[Ljava/lang/Object;";
+    const char* const STRING = "java/lang/String";
+    const char* const STRING_BUILDER = "java/lang/StringBuilder";
+    const char* const RUNTIME_EXCEPTION = "java/lang/RuntimeException";
+    const char* const BOOLEAN = "java/lang/Boolean";
+    const char* const HANDLER = "net/swofty/nativebridge/CompiledHandler";
+    const char* const EXECUTOR = "net/swofty/ASTExecutor";
+    const char* const INTERPRETER = "net/swofty/BytecodeInterpreter";
+    const char* const SWITCH_TABLE = "net/swofty/nativebridge/representation/SwitchTable";
+    const char* const MATCH_TABLE = "net/swofty/nativebridge/representation/MatchTable";
+    const char* const OPERATOR = "net/swofty/nativebridge/execution/expressions/BinaryExpression$Operator";
+    const char* const OPERATOR_DESCRIPTOR = "Lnet/swofty/nativebridge/execution/expressions/BinaryExpression$Operator;";
+    const char* const CONSTANTS_FIELD = "constants";
+
+    // Locals of run()
+    const uint16_t LOCAL_THIS = 0;
+    const uint16_t LOCAL_EXECUTOR_ARGUMENT = 1;   // as Object, from the interface
+    const uint16_t LOCAL_FRAME = 2;
+    const uint16_t LOCAL_EXECUTOR = 3;            // cast once to ASTExecutor
+    const uint16_t LOCAL_LINE = 4;                // source line of the current statement
+    const uint16_t FIRST_REGISTER = 5;
+
+    using Op = JvmOpcode;
+
+    class Generator {
+    public:
+        Generator(const Program& program, size_t slotCount, ClassWriter& writer)
+            : program(program), slotCount(slotCount), writer(writer), code(writer) {}
+
+        void generate() {
+            if (program.registerCount < 0 || FIRST_REGISTER + static_cast<size_t>(program.registerCount) > 65535) {
+                throw std::runtime_error("too many registers");
+            }
+            findFrames();
+
+            locals = {code.objectType(writer.getName()), code.objectType(OBJECT), code.objectType(OBJECT_ARRAY),
+                      code.objectType(EXECUTOR), CodeBuilder::integerType()};
+            locals.resize(locals.size() + static_cast<size_t>(program.registerCount), code.objectType(OBJECT));
+
+            prologue();
+
+            CodeBuilder::Label start = code.newLabel();
+            CodeBuilder::Label end = code.newLabel();
+            CodeBuilder::Label handler = code.newLabel();
+            code.bind(start);
+            body();
+            code.bind(end);
+
+            // catch (RuntimeException e) { throw BytecodeInterpreter.failure(e, line); }
+            code.bind(handler);
+            code.frame(locals, {code.objectType(RUNTIME_EXCEPTION)});
+            code.load(Op::ILOAD, LOCAL_LINE);
+            code.invoke(Op::INVOKESTATIC, INTERPRETER, "failure",
+                        "(Ljava/lang/RuntimeException;I)Ljava/lang/RuntimeException;");
+            code.op(Op::ATHROW, -1);
+            code.tryCatch(start, end, handler, RUNTIME_EXCEPTION);
+
+            writer.addMethod(ClassWriter::ACC_PUBLIC, "run", "(Ljava/lang/Object;[Ljava/lang/Object;)V", code,
+                             static_cast<uint16_t>(locals.size()));
+        }
+
+    private:
+        const Program& program;
+        size_t slotCount;
+        ClassWriter& writer;
+        CodeBuilder code;
+        std::vector<CodeBuilder::Type> locals;
+        std::map<int32_t, CodeBuilder::Label> labels;   // program offset -> label, where a frame is needed
+
+        uint16_t reg(int32_t index) const {
+            if (index < 0 || index >= program.registerCount) {
+                throw std::runtime_error("register out of range");
+            }
+            return static_cast<uint16_t>(FIRST_REGISTER + index);
+        }
+
+        const Constant& constant(int32_t index, Constant::Kind kind) const {
+            if (index < 0 || static_cast<size_t>(index) >= program.constants.size() ||
+                program.constants[index].kind != kind) {
+                throw std::runtime_error("bad constant operand");
+            }
+            return program.constants[index];
+        }
+
+        CodeBuilder::Label labelAt(int32_t offset) {
+            auto it = labels.find(offset);
+            if (it == labels.end()) {
+                it = labels.emplace(offset, code.newLabel()).first;
+            }
+            return it->second;
+        }
+
+        // Branch targets, plus every instruction after an unconditional transfer: the
+        // verifier expects a stack map frame at both
+        void findFrames() {
+            size_t pc = 0;
+            while (pc < program.code.size()) {
+                const int32_t* a = &program.code[pc + 1];
+                size_t next = pc + 1 + Bytecode::operandCount(program.code, pc);
+                bool falls = true;
+
+                switch (static_cast<Opcode>(program.code[pc])) {
+                    case Opcode::JUMP:
+                        labelAt(a[0]);
+                        falls = false;
+                        break;
+                    case Opcode::JUMP_IF_FALSE:
+                    case Opcode::JUMP_IF_TRUE:
+                        labelAt(a[1]);
+                        break;
+                    case Opcode::SWITCH:
+                        for (int32_t target : constant(a[1], Constant::Kind::SWITCH).targets) {
+                            labelAt(target);
+                        }
+                        labelAt(a[2]);
+                        falls = false;
+                        break;
+                    case Opcode::MATCH:
+                        for (int32_t target : constant(a[1], Constant::Kind::MATCH).targets) {
+                            labelAt(target);
+                        }
+                        labelAt(a[2]);
+                        falls = false;
+                        break;
+                    case Opcode::HALT:
+                    case Opcode::RETURN:
+                        falls = false;
+                        break;
+                    default:
+                        break;
+                }
+
+                if (!falls && next < program.code.size()) {
+                    labelAt(static_cast<int32_t>(next));
+                }
+                pc = next;
+            }
+        }
+
+        // Cast the executor once, copy the slots into locals and clear the temporaries
+        void prologue() {
+            code.load(Op::ALOAD, LOCAL_EXECUTOR_ARGUMENT);
+            code.typeOp(Op::CHECKCAST, EXECUTOR);
+            code.store(Op::ASTORE, LOCAL_EXECUTOR);
+            code.pushInt(0);
+            code.store(Op::ISTORE, LOCAL_LINE);
+
+            for (int32_t r = 0; r < program.registerCount; r++) {
+                if (static_cast<size_t>(r) < slotCount) {
+                    code.load(Op::ALOAD, LOCAL_FRAME);
+                    code.pushInt(r);
+                    code.op(Op::AALOAD, -1);
+                } else {
+                    code.op(Op::ACONST_NULL, 1);
+                }
+                code.store(Op::ASTORE, reg(r));
+            }
+        }
+
+        void body() {
+            size_t lineIndex = 0;
+            size_t pc = 0;
+            bool reachable = true;
+
+            while (pc < program.code.size()) {
+                auto offset = static_cast<int32_t>(pc);
+                bool lineChanged = false;
+                while (lineIndex < program.lines.size() && program.lines[lineIndex].first <= offset) {
+                    lineIndex++;
+                    lineChanged = true;
+                }
+
+                // A jump can skip line entries, so targets set the line again
+                auto label = labels.find(offset);
+                if (label != labels.end()) {
+                    code.bind(label->second);
+                    code.frame(locals, {});
+                    lineChanged = true;
+                }
+                if (lineChanged && lineIndex > 0) {
+                    code.pushInt(program.lines[lineIndex - 1].second);
+                    code.store(Op::ISTORE, LOCAL_LINE);
+                }
+
+                reachable = instruction(pc);
+                pc += 1 + Bytecode::operandCount(program.code, pc);
+            }
+
+            // Jumps past the last instruction end the handler
+            auto end = labels.lower_bound(static_cast<int32_t>(program.code.size()));
+            if (end != labels.end()) {
+                for (auto it = end; it != labels.end(); ++it) {
+                    code.bind(it->second);
+                }
+                code.frame(locals, {});
+                reachable = true;
+            }
+            if (reachable) {
+                code.op(Op::RETURN, 0);
+            }
+        }
+
+        // Emits one instruction; returns false if control does not fall through it
+        bool instruction(size_t pc) {
+            const int32_t* a = &program.code[pc + 1];
+
+            switch (static_cast<Opcode>(program.code[pc])) {
+                case Opcode::LOAD_CONST:
+                    code.pushString(constant(a[1], Constant::Kind::STRING).strings[0]);
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+
+                case Opcode::LOAD_BOOL:
+                    code.field(Op::GETSTATIC, BOOLEAN, a[1] ? "TRUE" : "FALSE", "Ljava/lang/Boolean;");
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+
+                case Opcode::MOVE:
+                    code.load(Op::ALOAD, reg(a[1]));
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+
+                case Opcode::GET_PATH:
+                    // One getObjectProperty per segment; it passes null through
+                    code.load(Op::ALOAD, reg(a[1]));
+                    for (const auto& segment : constant(a[2], Constant::Kind::PATH).strings) {
+                        code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                        code.op(Op::SWAP, 0);
+                        code.pushString(segment);
+                        code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "getObjectProperty",
+                                    "(Ljava/lang/Object;Ljava/lang/String;)Ljava/lang/Object;");
+                    }
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+
+                case Opcode::SET_PATH:
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.load(Op::ALOAD, reg(a[0]));
+                    loadConstant(a[1], Constant::Kind::PATH, "[Ljava/lang/String;");
+                    code.load(Op::ALOAD, reg(a[2]));
+                    code.pushString(constant(a[3], Constant::Kind::STRING).strings[0]);
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "assignPath",
+                                "(Ljava/lang/Object;[Ljava/lang/String;Ljava/lang/Object;Ljava/lang/String;)V");
+                    return true;
+
+                case Opcode::BINARY: {
+                    const char* name = Bytecode::operatorName(a[1]);
+                    if (name[0] == '?') {
+                        throw std::runtime_error("unknown operator");
+                    }
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.field(Op::GETSTATIC, OPERATOR, name, OPERATOR_DESCRIPTOR);
+                    operand(a[2]);
+                    operand(a[3]);
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "applyOperator",
+                                std::string("(") + OPERATOR_DESCRIPTOR + "Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+                }
+
+                case Opcode::CONCAT:
+                    code.typeOp(Op::NEW, STRING_BUILDER);
+                    code.op(Op::DUP, 1);
+                    code.pushInt(a[2]);
+                    code.invoke(Op::INVOKESPECIAL, STRING_BUILDER, "<init>", "(I)V");
+                    for (int32_t i = 0; i < a[3]; i++) {
+                        int32_t part = a[4 + i];
+                        if (part < 0) {
+                            operand(part);
+                        } else {
+                            code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                            code.load(Op::ALOAD, reg(part));
+                            code.pushInt(a[1]);
+                            code.invoke(Op::INVOKESTATIC, INTERPRETER, "concatPart",
+                                        "(Lnet/swofty/ASTExecutor;Ljava/lang/Object;I)Ljava/lang/String;");
+                        }
+                        code.invoke(Op::INVOKEVIRTUAL, STRING_BUILDER, "append",
+                                    "(Ljava/lang/String;)Ljava/lang/StringBuilder;");
+                    }
+                    code.invoke(Op::INVOKEVIRTUAL, STRING_BUILDER, "toString", "()Ljava/lang/String;");
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+
+                case Opcode::TO_MESSAGE:
+                    code.load(Op::ALOAD, reg(a[1]));
+                    code.invoke(Op::INVOKESTATIC, INTERPRETER, "toMessage", "(Ljava/lang/Object;)Ljava/lang/String;");
+                    code.store(Op::ASTORE, reg(a[0]));
+                    return true;
+
+                case Opcode::JUMP:
+                    code.branch(Op::GOTO, labelAt(a[0]));
+                    return false;
+
+                case Opcode::JUMP_IF_FALSE:
+                case Opcode::JUMP_IF_TRUE:
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.load(Op::ALOAD, reg(a[0]));
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "toBoolean", "(Ljava/lang/Object;)Z");
+                    code.branch(static_cast<Opcode>(program.code[pc]) == Opcode::JUMP_IF_FALSE ? Op::IFEQ : Op::IFNE,
+                                labelAt(a[1]));
+                    return true;
+
+                case Opcode::SWITCH: {
+                    // SwitchTable.target maps the value to a program offset; the
+                    // lookupswitch maps that offset to its label
+                    loadConstant(a[1], Constant::Kind::SWITCH, SWITCH_TABLE);
+                    code.load(Op::ALOAD, reg(a[0]));
+                    code.pushInt(a[2]);
+                    code.invoke(Op::INVOKEVIRTUAL, SWITCH_TABLE, "target", "(Ljava/lang/Object;I)I");
+
+                    std::map<int32_t, CodeBuilder::Label> cases;
+                    for (int32_t target : constant(a[1], Constant::Kind::SWITCH).targets) {
+                        cases.emplace(target, labelAt(target));
+                    }
+                    code.lookupSwitch(labelAt(a[2]), cases);
+                    return false;
+                }
+
+                case Opcode::MATCH: {
+                    // As SWITCH, with MatchTable.target scanning the value's text
+                    loadConstant(a[1], Constant::Kind::MATCH, MATCH_TABLE);
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.load(Op::ALOAD, reg(a[0]));
+                    code.invoke(Op::INVOKESTATIC, INTERPRETER, "matchText",
+                                "(Lnet/swofty/ASTExecutor;Ljava/lang/Object;)Ljava/lang/String;");
+                    code.pushInt(a[2]);
+                    code.invoke(Op::INVOKEVIRTUAL, MATCH_TABLE, "target", "(Ljava/lang/String;I)I");
+
+                    std::map<int32_t, CodeBuilder::Label> cases;
+                    for (int32_t target : constant(a[1], Constant::Kind::MATCH).targets) {
+                        cases.emplace(target, labelAt(target));
+                    }
+                    code.lookupSwitch(labelAt(a[2]), cases);
+                    return false;
+                }
+
+                case Opcode::SEND:
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    operand(a[0]);
+                    if (a[0] >= 0) {
+                        code.typeOp(Op::CHECKCAST, STRING);
+                    }
+                    if (a[1] >= 0) {
+                        code.load(Op::ALOAD, reg(a[1]));
+                    } else {
+                        code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                        code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "getSender",
+                                    "()Lnet/minestom/server/command/CommandSender;");
+                    }
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "sendMessage", "(Ljava/lang/String;Ljava/lang/Object;)V");
+                    return true;
+
+                case Opcode::TELEPORT:
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.load(Op::ALOAD, reg(a[0]));
+                    code.load(Op::ALOAD, reg(a[1]));
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "teleport", "(Ljava/lang/Object;Ljava/lang/Object;)V");
+                    return true;
+
+                case Opcode::CANCEL:
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "executeCancelEventStatement", "()V");
+                    return true;
+
+                case Opcode::HALT:
+                    code.load(Op::ALOAD, LOCAL_EXECUTOR);
+                    code.invoke(Op::INVOKEVIRTUAL, EXECUTOR, "halt", "()V");
+                    code.op(Op::RETURN, 0);
+                    return false;
+
+                case Opcode::RETURN:
+                    code.op(Op::RETURN, 0);
+                    return false;
+            }
+            throw std::runtime_error("unknown opcode " + std::to_string(program.code[pc]));
+        }
+
+        // Pushes an rk operand: a register, or a string constant
+        void operand(int32_t rk) {
+            if (rk >= 0) {
+                code.load(Op::ALOAD, reg(rk));
+            } else {
+                code.pushString(constant(-(rk + 1), Constant::Kind::STRING).strings[0]);
+            }
+        }
+
+        // Pushes this.constants[index], cast to its Java type
+        void loadConstant(int32_t index, Constant::Kind kind, const char* type) {
+            constant(index, kind);
+            code.load(Op::ALOAD, LOCAL_THIS);
+            code.field(Op::GETFIELD, writer.getName(), CONSTANTS_FIELD, OBJECT_ARRAY);
+            code.pushInt(index);
+            code.op(Op::AALOAD, -1);
+            code.typeOp(Op::CHECKCAST, type);
+        }
+    };
+
+    // <init>(Object[] constants) { super(); this.constants = constants; }
+    void constructor(ClassWriter& writer) {
+        CodeBuilder code(writer);
+        code.load(Op::ALOAD, 0);
+        code.invoke(Op::INVOKESPECIAL, OBJECT, "<init>", "()V");
+        code.load(Op::ALOAD, 0);
+        code.load(Op::ALOAD, 1);
+        code.field(Op::PUTFIELD, writer.getName(), CONSTANTS_FIELD, OBJECT_ARRAY);
+        code.op(Op::RETURN, 0);
+        writer.addMethod(ClassWriter::ACC_PUBLIC, "<init>", "([Ljava/lang/Object;)V", code, 2);
+    }
+}
+
+std::vector<uint8_t> JvmBackend::generate(const Program& program, size_t slotCount, const std::string& className) {
+    ClassWriter writer(ClassWriter::ACC_FINAL | ClassWriter::ACC_SUPER, className, OBJECT);
+    writer.addInterface(HANDLER);
+    writer.addField(ClassWriter::ACC_PRIVATE | ClassWriter::ACC_FINAL, CONSTANTS_FIELD, OBJECT_ARRAY);
+    constructor(writer);
+
+    Generator generator(program, slotCount, writer);
+    generator.generate();
+    return writer.toBytes();
+}
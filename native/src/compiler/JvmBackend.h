@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Bytecode.h"
+
+// Translates a compiled Program into a JVM class, so HotSpot can compile a handler
+// and inline the executor calls it makes instead of running BytecodeInterpreter.
+//
+// The class implements net.swofty.nativebridge.CompiledHandler:
+//
+//   final class <name> implements CompiledHandler {
+//       private final Object[] constants;     // the Program's constant pool
+//       <init>(Object[] constants)
+//       public void run(Object executor, Object[] frame)
+//   }
+//
+// run() keeps every register in a local and calls into net.swofty.ASTExecutor (and
+// BytecodeInterpreter's helpers) for each operation, with the same semantics as the
+// interpreter. The class has to be defined as a hidden class of the net.swofty package
+// to reach those package-private methods, so `className` must be in that package.
+// Runtime failures are rethrown prefixed with the source line, as the interpreter does.
+class JvmBackend {
+public:
+    // Throws std::runtime_error if the program does not fit the class-file limits
+    static std::vector<uint8_t> generate(const Program& program, size_t slotCount, const std::string& className);
+};
@@ -0,0 +1,275 @@
+#include "ScriptSerializer.h"
+#include <cstring>
+#include <PostOrder.h>
+#include <VariableAssignment.h>
+#include <StringLiteral.h>
+#include <VariableReference.h>
+#include <BinaryExpression.h>
+#include <TypeLiteral.h>
+#include <EventAccessExpression.h>
+#include <InterpolatedString.h>
+#include <BooleanLiteral.h>
+#include <Concat.h>
+#include <SwitchStatement.h>
+#include <Compiler.h>
+
+std::vector<uint8_t> ScriptSerializer::serialize(const std::vector<std::shared_ptr<Command>>& commands,
+                                                 const std::vector<std::shared_ptr<Event>>& events) {
+    ScriptSerializer writer;
+    uint32_t commandCount = 0;
+    uint32_t eventCount = 0;
+
+    for (const auto& command : commands) {
+        if (!command) continue;
+        writer.writeCommand(*command);
+        commandCount++;
+    }
+    for (const auto& event : events) {
+        if (!event) continue;
+        writer.writeEvent(*event);
+        eventCount++;
+    }
+
+    return writer.finish(commandCount, eventCount);
+}
+
+int32_t ScriptSerializer::stringRef(const std::string& value) {
+    auto it = stringIndex.find(value);
+    if (it != stringIndex.end()) {
+        return it->second;
+    }
+
+    int32_t index = static_cast<int32_t>(stringTable.size());
+    stringTable.push_back(value);
+    stringIndex.emplace(value, index);
+    return index;
+}
+
+void ScriptSerializer::writeCommand(const Command& command) {
+    body.push_back(stringRef(command.getName()));
+    body.push_back(stringRef(command.getPermission()));
+    body.push_back(stringRef(command.getDescription()));
+
+    const auto& arguments = command.getArguments();
+    body.push_back(static_cast<int32_t>(arguments.size()));
+    for (const auto& arg : arguments) {
+        body.push_back(stringRef(arg->getName()));
+        body.push_back(arg->getHasDefault() ? stringRef(arg->getDefaultValue()) : -1);
+        writeDataType(arg->getType());
+    }
+
+    writeBlock(command.getExecuteBlock());
+}
+
+void ScriptSerializer::writeEvent(const Event& event) {
+    body.push_back(stringRef(event.getName()));
+    body.push_back(event.getPriority());
+    writeBlock(event.getExecuteBlock());
+}
+
+void ScriptSerializer::writeDataType(const std::shared_ptr<DataType>& type) {
+    if (!type) {
+        body.push_back(static_cast<int32_t>(BaseType::UNKNOWN));
+        body.push_back(0);
+        return;
+    }
+
+    body.push_back(static_cast<int32_t>(type->getBaseType()));
+    body.push_back(static_cast<int32_t>(type->getSubTypes().size()));
+    for (const auto& subType : type->getSubTypes()) {
+        writeDataType(subType);
+    }
+}
+
+void ScriptSerializer::writeBlock(const std::shared_ptr<ExecuteBlock>& block) {
+    if (!block) {
+        body.push_back(0);
+        return;
+    }
+
+    FlatTree tree = PostOrder::flatten(*block);
+    body.push_back(static_cast<int32_t>(tree.nodes.size()));
+    body.push_back(block->getCanHalt() ? 1 : 0);
+    body.push_back(block->getEffects());
+
+    const auto& slotNames = block->getSlotNames();
+    body.push_back(static_cast<int32_t>(slotNames.size()));
+    for (const auto& name : slotNames) {
+        body.push_back(stringRef(name));
+    }
+
+    for (const auto* properties : {&block->getEventReads(), &block->getEventWrites()}) {
+        body.push_back(static_cast<int32_t>(properties->size()));
+        for (const auto& property : *properties) {
+            body.push_back(stringRef(property));
+        }
+    }
+
+    for (const FlatNode& flat : tree.nodes) {
+        switch (flat.kind) {
+            case NodeKind::NONE:
+                body.push_back(static_cast<int32_t>(WireTag::NONE));
+                break;
+            case NodeKind::SEND:
+                body.push_back(static_cast<int32_t>(WireTag::SEND));
+                break;
+            case NodeKind::TELEPORT:
+                body.push_back(static_cast<int32_t>(WireTag::TELEPORT));
+                break;
+            case NodeKind::HALT:
+                body.push_back(static_cast<int32_t>(WireTag::HALT));
+                break;
+            case NodeKind::IF:
+                body.push_back(static_cast<int32_t>(WireTag::IF));
+                break;
+            case NodeKind::BLOCK:
+                body.push_back(static_cast<int32_t>(WireTag::BLOCK));
+                body.push_back(static_cast<int32_t>(flat.childCount));
+                break;
+            case NodeKind::ASSIGN: {
+                auto assignment = static_cast<const VariableAssignment*>(flat.node);
+                body.push_back(static_cast<int32_t>(WireTag::ASSIGN));
+                body.push_back(stringRef(assignment->getVariableName()));
+                writeBinding(assignment->getSlot(), assignment->getPath());
+                break;
+            }
+            case NodeKind::CANCEL_EVENT:
+                body.push_back(static_cast<int32_t>(WireTag::CANCEL_EVENT));
+                break;
+            case NodeKind::STRING_LITERAL:
+                body.push_back(static_cast<int32_t>(WireTag::STRING_LITERAL));
+                body.push_back(stringRef(static_cast<const StringLiteral*>(flat.node)->getValue()));
+                break;
+            case NodeKind::VARIABLE_REFERENCE: {
+                auto reference = static_cast<const VariableReference*>(flat.node);
+                body.push_back(static_cast<int32_t>(WireTag::VARIABLE_REFERENCE));
+                body.push_back(stringRef(reference->getName()));
+                writeBinding(reference->getSlot(), reference->getPath());
+                break;
+            }
+            case NodeKind::BINARY:
+                body.push_back(static_cast<int32_t>(WireTag::BINARY));
+                body.push_back(static_cast<int32_t>(static_cast<const BinaryExpression*>(flat.node)->getOperator()));
+                break;
+            case NodeKind::TYPE_LITERAL:
+                body.push_back(static_cast<int32_t>(WireTag::TYPE_LITERAL));
+                body.push_back(stringRef(static_cast<const TypeLiteral*>(flat.node)->getTypeName()));
+                break;
+            case NodeKind::EVENT_ACCESS:
+                body.push_back(static_cast<int32_t>(WireTag::EVENT_ACCESS));
+                body.push_back(stringRef(static_cast<const EventAccessExpression*>(flat.node)->getProperty()));
+                break;
+            case NodeKind::INTERPOLATED_STRING:
+                body.push_back(static_cast<int32_t>(WireTag::INTERPOLATED_STRING));
+                body.push_back(static_cast<int32_t>(flat.childCount));
+                body.push_back(static_cast<int32_t>(
+                    static_cast<const InterpolatedString*>(flat.node)->getLiteralLength()));
+                break;
+            case NodeKind::BOOLEAN_LITERAL:
+                body.push_back(static_cast<int32_t>(WireTag::BOOLEAN_LITERAL));
+                body.push_back(static_cast<const BooleanLiteral*>(flat.node)->getValue() ? 1 : 0);
+                break;
+            case NodeKind::CONCAT:
+                body.push_back(static_cast<int32_t>(WireTag::CONCAT));
+                body.push_back(static_cast<int32_t>(flat.childCount));
+                body.push_back(static_cast<int32_t>(static_cast<const Concat*>(flat.node)->getLiteralLength()));
+                break;
+            case NodeKind::SWITCH: {
+                const auto& labels = static_cast<const SwitchStatement*>(flat.node)->getLabels();
+                body.push_back(static_cast<int32_t>(WireTag::SWITCH));
+                body.push_back(static_cast<int32_t>(labels.size()));
+                for (const auto& label : labels) {
+                    body.push_back(stringRef(label));
+                }
+                break;
+            }
+            case NodeKind::EXECUTE_BLOCK:
+                body.push_back(static_cast<int32_t>(WireTag::EXECUTE_BLOCK));
+                body.push_back(static_cast<int32_t>(flat.childCount));
+                break;
+        }
+    }
+
+    writeProgram(*block);
+}
+
+void ScriptSerializer::writeProgram(const ExecuteBlock& block) {
+    auto program = Compiler::compile(block);
+    if (!program) {
+        body.push_back(0);
+        return;
+    }
+
+    body.push_back(static_cast<int32_t>(program->code.size()));
+    body.insert(body.end(), program->code.begin(), program->code.end());
+
+    body.push_back(static_cast<int32_t>(program->constants.size()));
+    for (const auto& constant : program->constants) {
+        body.push_back(static_cast<int32_t>(constant.kind));
+        switch (constant.kind) {
+            case Constant::Kind::STRING:
+                body.push_back(stringRef(constant.strings[0]));
+                break;
+            case Constant::Kind::PATH:
+                body.push_back(static_cast<int32_t>(constant.strings.size()));
+                for (const auto& segment : constant.strings) {
+                    body.push_back(stringRef(segment));
+                }
+                break;
+            case Constant::Kind::SWITCH:
+            case Constant::Kind::MATCH:
+                body.push_back(static_cast<int32_t>(constant.strings.size()));
+                for (size_t i = 0; i < constant.strings.size(); i++) {
+                    body.push_back(stringRef(constant.strings[i]));
+                    body.push_back(constant.targets[i]);
+                }
+                break;
+        }
+    }
+
+    body.push_back(static_cast<int32_t>(program->lines.size()));
+    for (const auto& entry : program->lines) {
+        body.push_back(entry.first);
+        body.push_back(entry.second);
+    }
+    body.push_back(program->registerCount);
+}
+
+void ScriptSerializer::writeBinding(int slot, const std::vector<std::string>& path) {
+    body.push_back(slot);
+    body.push_back(static_cast<int32_t>(path.size()));
+    for (const auto& segment : path) {
+        body.push_back(stringRef(segment));
+    }
+}
+
+std::vector<uint8_t> ScriptSerializer::finish(uint32_t commandCount, uint32_t eventCount) const {
+    size_t size = 5 * sizeof(int32_t) + body.size() * sizeof(int32_t);
+    for (const auto& value : stringTable) {
+        size += sizeof(int32_t) + value.size();
+    }
+
+    std::vector<uint8_t> out(size);
+    uint8_t* cursor = out.data();
+    auto put = [&cursor](uint32_t value) {
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    };
+
+    put(MAGIC);
+    put(VERSION);
+    put(static_cast<uint32_t>(stringTable.size()));
+    put(commandCount);
+    put(eventCount);
+
+    for (const auto& value : stringTable) {
+        put(static_cast<uint32_t>(value.size()));
+        std::memcpy(cursor, value.data(), value.size());
+        cursor += value.size();
+    }
+
+    if (!body.empty()) {
+        std::memcpy(cursor, body.data(), body.size() * sizeof(int32_t));
+    }
+    return out;
+}
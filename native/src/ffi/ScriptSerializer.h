@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Command.h"
+#include "Event.h"
+#include "ExecuteBlock.h"
+#include "DataType.h"
+#include "Bytecode.h"
+
+// Writes parsed commands and events into the flat buffer handed out by the C ABI.
+//
+// Every value is a 32-bit integer in native byte order. Strings are referenced by
+// index into a table stored once at the front, and -1 stands for "no string".
+//
+//   header   magic 'SWFT', version, stringCount, commandCount, eventCount
+//   strings  stringCount x (byteLength, UTF-8 bytes)   - not padded
+//   command  name, permission, description, argCount, arg..., block
+//   arg      name, default (-1 if none), type
+//   type     baseType, subTypeCount, type...
+//   event    name, priority, block
+//   block    nodeCount, canHalt, effects, slotCount, slotName..., readCount, eventRead...,
+//            writeCount, eventWrite..., node..., program
+//            (nodeCount 0 = no block, nothing else follows; canHalt is 0 when no
+//            halt statement survived DeadCodeEliminator; effects are EffectAnalyzer's
+//            flags; the event properties the block reads and writes are those
+//            recorded by SlotResolver)
+//   program  codeLength, code..., constantCount, constant..., lineCount,
+//            (offset, line)..., registerCount
+//            (codeLength 0 = the block was not compiled, nothing else follows)
+//   constant kind (Constant::Kind), then
+//            STRING: string | PATH: segmentCount, segment... | SWITCH: caseCount, (label, target)...
+//            | MATCH: patternCount, (pattern, target)...
+//
+// Nodes are written in post-order: a node follows all of its children, so a reader
+// rebuilds the tree with a single operand stack and never recurses. Each node is a
+// tag followed by the operands listed in WireTag; the last node of a block is always
+// EXECUTE_BLOCK.
+class ScriptSerializer {
+public:
+    static constexpr uint32_t MAGIC = 0x54465753; // "SWFT" read as little-endian
+    static constexpr uint32_t VERSION = 10;
+
+    enum class WireTag : int32_t {
+        NONE = 0,           // an absent child (no send target, no else branch)
+
+        // Statements
+        SEND = 1,           //                  pops target, message
+        TELEPORT = 2,       //                  pops target, entity
+        HALT = 3,
+        IF = 4,             //                  pops else, then, condition
+        BLOCK = 5,          // statementCount   pops statements
+        ASSIGN = 6,         // name, slot, segmentCount, segment...   pops value
+        CANCEL_EVENT = 7,
+        SWITCH = 8,         // caseCount, label...   pops default, branch..., subject
+
+        // Expressions
+        STRING_LITERAL = 16,     // value
+        VARIABLE_REFERENCE = 17, // name, slot, segmentCount, segment...
+        BINARY = 18,             // operator        pops right, left
+        TYPE_LITERAL = 19,       // typeName
+        EVENT_ACCESS = 20,       // property
+        INTERPOLATED_STRING = 21, // partCount, literalLength   pops parts
+        BOOLEAN_LITERAL = 22,    // value (0 or 1)
+        CONCAT = 23,             // partCount, literalLength   pops parts
+
+        EXECUTE_BLOCK = 32  // statementCount   pops statements
+    };
+
+    static std::vector<uint8_t> serialize(const std::vector<std::shared_ptr<Command>>& commands,
+                                          const std::vector<std::shared_ptr<Event>>& events);
+
+private:
+    std::vector<int32_t> body;
+    std::vector<std::string> stringTable;
+    std::unordered_map<std::string, int32_t> stringIndex;
+
+    int32_t stringRef(const std::string& value);
+    void writeCommand(const Command& command);
+    void writeEvent(const Event& event);
+    void writeDataType(const std::shared_ptr<DataType>& type);
+    void writeBlock(const std::shared_ptr<ExecuteBlock>& block);
+    void writeBinding(int slot, const std::vector<std::string>& path);
+    void writeProgram(const ExecuteBlock& block);
+    std::vector<uint8_t> finish(uint32_t commandCount, uint32_t eventCount) const;
+};
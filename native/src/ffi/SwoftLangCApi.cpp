@@ -0,0 +1,93 @@
+#include "SwoftLangCApi.h"
+#include "ScriptSerializer.h"
+#include "SwoftLangParser.h"
+#include <Diagnostics.h>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+struct swoft_result {
+    std::vector<uint8_t> data;
+    std::string error;
+    std::string diagnostics;
+    uint32_t commandCount = 0;
+    uint32_t eventCount = 0;
+};
+
+extern "C" {
+
+uint32_t swoft_abi_version(void) {
+    return ScriptSerializer::VERSION;
+}
+
+int swoft_parse(const char* source, size_t length, swoft_result** out) {
+    if (!out) {
+        return SWOFT_ERROR_INVALID_ARGUMENT;
+    }
+
+    swoft_result* result = new (std::nothrow) swoft_result();
+    *out = result;
+    if (!result) {
+        return SWOFT_ERROR_INTERNAL;
+    }
+
+    if (!source && length > 0) {
+        result->error = "Input code is null";
+        return SWOFT_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        Diagnostics::Scope diagnostics;
+        std::string code(source ? source : "", length);
+        auto parsed = SwoftLangParser::parseAll(code);
+
+        for (const auto& note : diagnostics.getNotes()) {
+            if (!result->diagnostics.empty()) result->diagnostics += '\n';
+            result->diagnostics += note;
+        }
+
+        result->data = ScriptSerializer::serialize(parsed.first, parsed.second);
+        result->commandCount = static_cast<uint32_t>(parsed.first.size());
+        result->eventCount = static_cast<uint32_t>(parsed.second.size());
+        return SWOFT_OK;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in swoft_parse: " << e.what() << std::endl;
+        result->error = e.what();
+        return SWOFT_ERROR_PARSE;
+    } catch (...) {
+        std::cerr << "Unknown exception in swoft_parse" << std::endl;
+        result->error = "Unknown error in native parser";
+        return SWOFT_ERROR_INTERNAL;
+    }
+}
+
+const uint8_t* swoft_result_data(const swoft_result* result) {
+    return result ? result->data.data() : nullptr;
+}
+
+size_t swoft_result_size(const swoft_result* result) {
+    return result ? result->data.size() : 0;
+}
+
+uint32_t swoft_result_command_count(const swoft_result* result) {
+    return result ? result->commandCount : 0;
+}
+
+uint32_t swoft_result_event_count(const swoft_result* result) {
+    return result ? result->eventCount : 0;
+}
+
+const char* swoft_result_error(const swoft_result* result) {
+    return result ? result->error.c_str() : "";
+}
+
+const char* swoft_result_diagnostics(const swoft_result* result) {
+    return result ? result->diagnostics.c_str() : "";
+}
+
+void swoft_free(swoft_result* result) {
+    delete result;
+}
+
+}
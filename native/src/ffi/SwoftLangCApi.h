@@ -0,0 +1,65 @@
+/*
+ * Stable C ABI for the SwoftLang parser.
+ *
+ * This is the entry point used by the Java Foreign Function & Memory binding
+ * (ForeignParser.parseScript). Unlike the JNI functions it needs no JNIEnv and creates
+ * no Java objects: a parse produces an opaque result holding one contiguous buffer
+ * in the wire format described in ScriptSerializer.h, which the caller reads in place
+ * and then releases with swoft_free.
+ */
+#ifndef SWOFTLANG_C_API_H
+#define SWOFTLANG_C_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define SWOFT_API __declspec(dllexport)
+#else
+#define SWOFT_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Status codes returned by swoft_parse */
+#define SWOFT_OK 0
+#define SWOFT_ERROR_INVALID_ARGUMENT 1
+#define SWOFT_ERROR_PARSE 2
+#define SWOFT_ERROR_INTERNAL 3
+
+typedef struct swoft_result swoft_result;
+
+/* Version of the wire format produced by swoft_parse */
+SWOFT_API uint32_t swoft_abi_version(void);
+
+/*
+ * Parse `length` bytes of UTF-8 source. On return *out always points to a result
+ * (also on failure, so the error message can be read) that must be passed to swoft_free.
+ */
+SWOFT_API int swoft_parse(const char* source, size_t length, swoft_result** out);
+
+/* Serialized commands and events; valid until swoft_free */
+SWOFT_API const uint8_t* swoft_result_data(const swoft_result* result);
+SWOFT_API size_t swoft_result_size(const swoft_result* result);
+
+SWOFT_API uint32_t swoft_result_command_count(const swoft_result* result);
+SWOFT_API uint32_t swoft_result_event_count(const swoft_result* result);
+
+/* NUL-terminated error message, or an empty string if the parse succeeded */
+SWOFT_API const char* swoft_result_error(const swoft_result* result);
+
+/*
+ * NUL-terminated, newline-separated notes from the optimisation passes (for example
+ * how many unreachable statements were removed), or an empty string if there are none
+ */
+SWOFT_API const char* swoft_result_diagnostics(const swoft_result* result);
+
+SWOFT_API void swoft_free(swoft_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
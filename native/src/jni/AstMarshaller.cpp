@@ -0,0 +1,336 @@
+#include "AstMarshaller.h"
+#include "SwoftLangJNIBridge.h"
+#include <iostream>
+#include <VariableAssignment.h>
+#include <StringLiteral.h>
+#include <VariableReference.h>
+#include <TypeLiteral.h>
+#include <EventAccessExpression.h>
+#include <InterpolatedString.h>
+#include <BooleanLiteral.h>
+#include <Concat.h>
+#include <SwitchStatement.h>
+#include <Compiler.h>
+
+AstMarshaller::AstMarshaller(JNIEnv* env, JStringInterner& strings, const JavaClassCache& classes)
+    : env(env), strings(strings), classes(classes) {}
+
+jobject AstMarshaller::marshal(const ExecuteBlock& block) {
+    FlatTree tree = PostOrder::flatten(block);
+
+    jobjectArray stack = env->NewObjectArray(static_cast<jsize>(tree.maxStackDepth), classes.objectClass, NULL);
+    if (!stack) {
+        return NULL;
+    }
+
+    jsize top = 0;
+    for (const FlatNode& flat : tree.nodes) {
+        if (env->PushLocalFrame(FRAME_CAPACITY) != 0) {
+            env->DeleteLocalRef(stack);
+            return NULL;
+        }
+
+        jobject node = build(flat, stack, top);
+        if (checkAndClearJNIException(env, "AstMarshaller::build")) {
+            node = NULL;
+        }
+
+        // Only an absent else or default is NULL; any other NULL is a node that failed,
+        // and its parents would be built from the wrong children
+        if (!node && flat.kind != NodeKind::NONE) {
+            env->PopLocalFrame(NULL);
+            env->DeleteLocalRef(stack);
+            return NULL;
+        }
+
+        env->SetObjectArrayElement(stack, top++, node);
+        env->PopLocalFrame(NULL);
+    }
+
+    jobject result = env->GetObjectArrayElement(stack, 0);
+    env->DeleteLocalRef(stack);
+    if (!result) {
+        return NULL;
+    }
+
+    jobjectArray slotNames = stringArray(block.getSlotNames());
+    if (slotNames) {
+        env->CallVoidMethod(result, classes.executeBlockSetSlotNames, slotNames);
+        env->DeleteLocalRef(slotNames);
+    }
+    checkAndClearJNIException(env, "ExecuteBlock setSlotNames");
+
+    jobjectArray eventReads = stringArray(block.getEventReads());
+    jobjectArray eventWrites = stringArray(block.getEventWrites());
+    if (eventReads && eventWrites) {
+        env->CallVoidMethod(result, classes.executeBlockSetEventAccesses, eventReads, eventWrites);
+    }
+    env->DeleteLocalRef(eventWrites);
+    env->DeleteLocalRef(eventReads);
+    checkAndClearJNIException(env, "ExecuteBlock setEventAccesses");
+
+    env->CallVoidMethod(result, classes.executeBlockSetCanHalt, static_cast<jboolean>(block.getCanHalt()));
+    checkAndClearJNIException(env, "ExecuteBlock setCanHalt");
+
+    env->CallVoidMethod(result, classes.executeBlockSetEffects, static_cast<jint>(block.getEffects()));
+    checkAndClearJNIException(env, "ExecuteBlock setEffects");
+
+    // Without a program the runtime walks the tree built above
+    auto program = Compiler::compile(block);
+    if (program && env->PushLocalFrame(FRAME_CAPACITY) == 0) {
+        jobject compiled = buildProgram(*program);
+        if (compiled) {
+            env->CallVoidMethod(result, classes.executeBlockSetProgram, compiled);
+        }
+        checkAndClearJNIException(env, "ExecuteBlock setProgram");
+        env->PopLocalFrame(NULL);
+    }
+    return result;
+}
+
+jobject AstMarshaller::buildProgram(const Program& program) {
+    jintArray code = intArray(program.code);
+    if (!code) return NULL;
+
+    jobjectArray constants = env->NewObjectArray(static_cast<jsize>(program.constants.size()),
+                                                 classes.objectClass, NULL);
+    if (!constants) return NULL;
+
+    for (size_t i = 0; i < program.constants.size(); i++) {
+        const Constant& constant = program.constants[i];
+        jobject value = NULL;
+        switch (constant.kind) {
+            case Constant::Kind::STRING: {
+                // Interned strings are global references, so there is nothing to delete
+                jstring text = strings.intern(constant.strings[0]);
+                if (!text) return NULL;
+                env->SetObjectArrayElement(constants, static_cast<jsize>(i), text);
+                continue;
+            }
+            case Constant::Kind::PATH:
+                value = stringArray(constant.strings);
+                break;
+            case Constant::Kind::SWITCH: {
+                jobjectArray labels = stringArray(constant.strings);
+                jintArray targets = intArray(constant.targets);
+                if (labels && targets) {
+                    value = env->NewObject(classes.switchTableClass, classes.switchTableInit, labels, targets);
+                }
+                if (labels) env->DeleteLocalRef(labels);
+                if (targets) env->DeleteLocalRef(targets);
+                break;
+            }
+            case Constant::Kind::MATCH: {
+                jobjectArray patterns = stringArray(constant.strings);
+                jintArray targets = intArray(constant.targets);
+                if (patterns && targets) {
+                    value = env->NewObject(classes.matchTableClass, classes.matchTableInit, patterns, targets);
+                }
+                if (patterns) env->DeleteLocalRef(patterns);
+                if (targets) env->DeleteLocalRef(targets);
+                break;
+            }
+        }
+        if (!value) return NULL;
+        env->SetObjectArrayElement(constants, static_cast<jsize>(i), value);
+        env->DeleteLocalRef(value);
+    }
+
+    std::vector<int32_t> lines;
+    lines.reserve(program.lines.size() * 2);
+    for (const auto& entry : program.lines) {
+        lines.push_back(entry.first);
+        lines.push_back(entry.second);
+    }
+    jintArray lineTable = intArray(lines);
+    if (!lineTable) return NULL;
+
+    return env->NewObject(classes.programClass, classes.programInit, code, constants, lineTable,
+                          static_cast<jint>(program.registerCount));
+}
+
+jintArray AstMarshaller::intArray(const std::vector<int32_t>& values) {
+    jintArray array = env->NewIntArray(static_cast<jsize>(values.size()));
+    if (!array) return NULL;
+    if (!values.empty()) {
+        env->SetIntArrayRegion(array, 0, static_cast<jsize>(values.size()),
+                               reinterpret_cast<const jint*>(values.data()));
+    }
+    return array;
+}
+
+jobject AstMarshaller::pop(jobjectArray stack, jsize& top) {
+    return env->GetObjectArrayElement(stack, --top);
+}
+
+jobject AstMarshaller::build(const FlatNode& flat, jobjectArray stack, jsize& top) {
+    switch (flat.kind) {
+        case NodeKind::NONE:
+            return NULL;
+
+        case NodeKind::SEND: {
+            jobject target = pop(stack, top);
+            jobject message = pop(stack, top);
+            return env->NewObject(classes.sendCommandClass, classes.sendCommandInit, message, target);
+        }
+
+        case NodeKind::TELEPORT: {
+            jobject target = pop(stack, top);
+            jobject entity = pop(stack, top);
+            return env->NewObject(classes.teleportCommandClass, classes.teleportCommandInit, entity, target);
+        }
+
+        case NodeKind::HALT:
+            return env->NewObject(classes.haltCommandClass, classes.haltCommandInit);
+
+        case NodeKind::CANCEL_EVENT:
+            return env->NewObject(classes.cancelEventStatementClass, classes.cancelEventStatementInit);
+
+        case NodeKind::IF: {
+            jobject elseStatement = pop(stack, top);
+            jobject thenStatement = pop(stack, top);
+            jobject condition = pop(stack, top);
+            return env->NewObject(classes.ifStatementClass, classes.ifStatementInit,
+                                  condition, thenStatement, elseStatement);
+        }
+
+        case NodeKind::SWITCH: {
+            jobject defaultStatement = pop(stack, top);
+            jobjectArray branches = childArray(classes.statementClass, flat.childCount - 2, stack, top);
+            jobject subject = pop(stack, top);
+            if (!branches) return NULL;
+            jobjectArray labels = stringArray(static_cast<const SwitchStatement*>(flat.node)->getLabels());
+            if (!labels) return NULL;
+            return env->NewObject(classes.switchStatementClass, classes.switchStatementInit,
+                                  subject, labels, branches, defaultStatement);
+        }
+
+        case NodeKind::BLOCK:
+            return buildBlock(classes.blockStatementClass, classes.blockStatementInit,
+                              classes.blockStatementAddStatement, flat.childCount, stack, top);
+
+        case NodeKind::EXECUTE_BLOCK:
+            return buildBlock(classes.executeBlockClass, classes.executeBlockInit,
+                              classes.executeBlockAddStatement, flat.childCount, stack, top);
+
+        case NodeKind::ASSIGN: {
+            jobject value = pop(stack, top);
+            auto assignment = static_cast<const VariableAssignment*>(flat.node);
+            jstring name = strings.intern(assignment->getVariableName());
+            if (!name) return NULL;
+            jobjectArray path = stringArray(assignment->getPath());
+            if (!path) return NULL;
+            return env->NewObject(classes.variableAssignmentClass, classes.variableAssignmentInit,
+                                  name, static_cast<jint>(assignment->getSlot()), path, value);
+        }
+
+        case NodeKind::STRING_LITERAL: {
+            jstring value = strings.intern(static_cast<const StringLiteral*>(flat.node)->getValue());
+            if (!value) return NULL;
+            return env->NewObject(classes.stringLiteralClass, classes.stringLiteralInit, value);
+        }
+
+        case NodeKind::VARIABLE_REFERENCE: {
+            auto reference = static_cast<const VariableReference*>(flat.node);
+            jstring name = strings.intern(reference->getName());
+            if (!name) return NULL;
+            jobjectArray path = stringArray(reference->getPath());
+            if (!path) return NULL;
+            return env->NewObject(classes.variableReferenceClass, classes.variableReferenceInit,
+                                  name, static_cast<jint>(reference->getSlot()), path);
+        }
+
+        case NodeKind::TYPE_LITERAL: {
+            jstring typeName = strings.intern(static_cast<const TypeLiteral*>(flat.node)->getTypeName());
+            if (!typeName) return NULL;
+            return env->NewObject(classes.typeLiteralClass, classes.typeLiteralInit, typeName);
+        }
+
+        case NodeKind::EVENT_ACCESS: {
+            jstring property = strings.intern(static_cast<const EventAccessExpression*>(flat.node)->getProperty());
+            if (!property) return NULL;
+            return env->NewObject(classes.eventAccessExpressionClass, classes.eventAccessExpressionInit, property);
+        }
+
+        case NodeKind::INTERPOLATED_STRING: {
+            jobjectArray parts = childArray(classes.expressionClass, flat.childCount, stack, top);
+            if (!parts) return NULL;
+            auto interpolated = static_cast<const InterpolatedString*>(flat.node);
+            return env->NewObject(classes.interpolatedStringClass, classes.interpolatedStringInit,
+                                  parts, static_cast<jint>(interpolated->getLiteralLength()));
+        }
+
+        case NodeKind::CONCAT: {
+            jobjectArray parts = childArray(classes.expressionClass, flat.childCount, stack, top);
+            if (!parts) return NULL;
+            return env->NewObject(classes.concatClass, classes.concatInit,
+                                  parts, static_cast<jint>(static_cast<const Concat*>(flat.node)->getLiteralLength()));
+        }
+
+        case NodeKind::BOOLEAN_LITERAL:
+            return env->NewObject(classes.booleanLiteralClass, classes.booleanLiteralInit,
+                                  static_cast<jboolean>(static_cast<const BooleanLiteral*>(flat.node)->getValue()));
+
+        case NodeKind::BINARY: {
+            jobject right = pop(stack, top);
+            jobject left = pop(stack, top);
+            jobject op = classes.binaryOperator(static_cast<const BinaryExpression*>(flat.node)->getOperator());
+            return env->NewObject(classes.binaryExpressionClass, classes.binaryExpressionInit, left, op, right);
+        }
+    }
+
+    return NULL;
+}
+
+jobject AstMarshaller::buildBlock(jclass cls, jmethodID init, jmethodID add, uint32_t count,
+                                  jobjectArray stack, jsize& top) {
+    jsize first = top - static_cast<jsize>(count);
+    top = first;
+
+    jobject block = env->NewObject(cls, init);
+    if (!block) return NULL;
+
+    // Children are added one at a time so only one of them is referenced natively
+    for (jsize i = first; i < first + static_cast<jsize>(count); i++) {
+        jobject statement = env->GetObjectArrayElement(stack, i);
+        if (!statement) continue;
+
+        env->CallVoidMethod(block, add, statement);
+        env->DeleteLocalRef(statement);
+        checkAndClearJNIException(env, "CallVoidMethod addStatement");
+    }
+
+    return block;
+}
+
+jobjectArray AstMarshaller::childArray(jclass elementClass, uint32_t count, jobjectArray stack, jsize& top) {
+    jsize first = top - static_cast<jsize>(count);
+    top = first;
+
+    jobjectArray children = env->NewObjectArray(static_cast<jsize>(count), elementClass, NULL);
+    if (!children) return NULL;
+
+    // Moved across one at a time, like block children
+    for (jsize i = 0; i < static_cast<jsize>(count); i++) {
+        jobject child = env->GetObjectArrayElement(stack, first + i);
+        env->SetObjectArrayElement(children, i, child);
+        env->DeleteLocalRef(child);
+    }
+    return children;
+}
+
+jobjectArray AstMarshaller::stringArray(const std::vector<std::string>& values) {
+    jobjectArray array = env->NewObjectArray(static_cast<jsize>(values.size()), classes.stringClass, NULL);
+    if (!array) return NULL;
+
+    // Interned strings are global references, so filling the array creates no locals
+    for (size_t i = 0; i < values.size(); i++) {
+        jstring value = strings.intern(values[i]);
+        if (!value) {
+            env->DeleteLocalRef(array);
+            return NULL;
+        }
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), value);
+    }
+    return array;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <jni.h>
+#include "JStringInterner.h"
+#include "JavaClassCache.h"
+#include "PostOrder.h"
+#include "ExecuteBlock.h"
+#include "Bytecode.h"
+
+// Converts an ExecuteBlock into its Java execution tree.
+//
+// The block is walked in post-order (see PostOrder.h) rather than recursively. Finished
+// Java nodes wait on an operand stack that lives in a Java Object[], not in native
+// local references, and each node is built inside its own PushLocalFrame/PopLocalFrame
+// pair. The number of live local references therefore stays at FRAME_CAPACITY plus the
+// stack array, however deep or wide the script is.
+//
+// The block's bytecode (see Compiler.h) is attached to the root as a Program.
+class AstMarshaller {
+public:
+    AstMarshaller(JNIEnv* env, JStringInterner& strings, const JavaClassCache& classes);
+
+    // Returns a local reference in the caller's frame, or NULL if some node could not be
+    // built; a whole tree is never returned with a node missing
+    jobject marshal(const ExecuteBlock& block);
+
+private:
+    // Enough for the widest node: a switch pops three children and builds two arrays
+    static constexpr jint FRAME_CAPACITY = 8;
+
+    JNIEnv* env;
+    JStringInterner& strings;
+    const JavaClassCache& classes;
+
+    jobject build(const FlatNode& flat, jobjectArray stack, jsize& top);
+    jobject buildBlock(jclass cls, jmethodID init, jmethodID add, uint32_t count, jobjectArray stack, jsize& top);
+    jobject pop(jobjectArray stack, jsize& top);
+    jobjectArray childArray(jclass elementClass, uint32_t count, jobjectArray stack, jsize& top);
+    jobjectArray stringArray(const std::vector<std::string>& values);
+    jintArray intArray(const std::vector<int32_t>& values);
+    jobject buildProgram(const Program& program);
+};
@@ -0,0 +1,69 @@
+#include "JStringInterner.h"
+#include <mutex>
+#include <iostream>
+
+namespace {
+    // Names that show up in nearly every script - created once per JVM
+    const char* const WELL_KNOWN_NAMES[] = {
+        "", "sender", "event", "args", "player", "message", "name", "target", "all",
+        "event.player", "event.message", "event.player.name",
+        "Player", "Location", "String", "Number", "Boolean"
+    };
+
+    std::once_flag wellKnownOnce;
+    std::unordered_map<std::string, jstring> wellKnownStrings;
+}
+
+void JStringInterner::initWellKnown(JNIEnv* env) {
+    std::call_once(wellKnownOnce, [env]() {
+        for (const char* name : WELL_KNOWN_NAMES) {
+            jstring local = env->NewStringUTF(name);
+            if (!local) {
+                env->ExceptionClear();
+                continue;
+            }
+            wellKnownStrings[name] = static_cast<jstring>(env->NewGlobalRef(local));
+            env->DeleteLocalRef(local);
+        }
+    });
+}
+
+JStringInterner::JStringInterner(JNIEnv* env) : env(env) {
+    initWellKnown(env);
+}
+
+JStringInterner::~JStringInterner() {
+    for (auto& entry : strings) {
+        env->DeleteGlobalRef(entry.second);
+    }
+}
+
+jstring JStringInterner::intern(const std::string& value) {
+    auto known = wellKnownStrings.find(value);
+    if (known != wellKnownStrings.end()) {
+        return known->second;
+    }
+
+    auto it = strings.find(value);
+    if (it != strings.end()) {
+        return it->second;
+    }
+
+    jstring created = createGlobal(value);
+    if (created) {
+        strings.emplace(value, created);
+    }
+    return created;
+}
+
+jstring JStringInterner::createGlobal(const std::string& value) {
+    jstring local = env->NewStringUTF(value.c_str());
+    if (!local) {
+        std::cerr << "Failed to create Java string for '" << value << "'" << std::endl;
+        return NULL;
+    }
+
+    jstring global = static_cast<jstring>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    return global;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <jni.h>
+#include <string>
+#include <unordered_map>
+
+// Hands out one Java string per distinct native string for the duration of a parse.
+// Every identifier, property path and literal that crosses the bridge goes through
+// intern(), so "sender" or "event.player" is converted once and every node that
+// uses it shares the same java.lang.String instance.
+//
+// Entries are held as global references, so they stay valid across local reference
+// frames and are released when the interner is destroyed. A fixed set of well-known
+// names is shared by all interners and kept for the lifetime of the JVM.
+class JStringInterner {
+public:
+    explicit JStringInterner(JNIEnv* env);
+    ~JStringInterner();
+
+    JStringInterner(const JStringInterner&) = delete;
+    JStringInterner& operator=(const JStringInterner&) = delete;
+
+    // Returns a reference owned by the interner - callers must not delete it.
+    // Returns NULL (with a pending Java exception) if the string could not be created.
+    jstring intern(const std::string& value);
+
+private:
+    JNIEnv* env;
+    std::unordered_map<std::string, jstring> strings;
+
+    jstring createGlobal(const std::string& value);
+    static void initWellKnown(JNIEnv* env);
+};
@@ -0,0 +1,288 @@
+#include "JavaClassCache.h"
+#include "SwoftLangJNIBridge.h"
+#include <net_swofty_nativebridge_representation_BaseType.h>
+#include <net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator.h>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+// The bridge maps C++ enums to Java constants by ordinal, so both sides must declare the
+// same constants in the same order. The Java enums export their size through @Native.
+static_assert(net_swofty_nativebridge_representation_BaseType_COUNT == BASE_TYPE_COUNT,
+              "BaseType.java and the C++ BaseType enum are out of sync");
+static_assert(net_swofty_nativebridge_execution_expressions_BinaryExpression_Operator_COUNT
+                  == BinaryExpression::OPERATOR_COUNT,
+              "BinaryExpression.Operator in Java and C++ are out of sync");
+
+namespace {
+    std::mutex cacheMutex;
+    std::atomic<JavaClassCache*> cache{nullptr};
+
+    class Resolver {
+    public:
+        explicit Resolver(JNIEnv* env) : env(env) {}
+
+        bool findClass(const char* name, jclass& out) {
+            jclass local = env->FindClass(name);
+            if (!local) {
+                std::cerr << "Failed to find Java class " << name << std::endl;
+                return false;
+            }
+            out = static_cast<jclass>(env->NewGlobalRef(local));
+            env->DeleteLocalRef(local);
+            if (!out) return false;
+            created.push_back(out);
+            return true;
+        }
+
+        bool findMethod(jclass cls, const char* name, const char* signature, jmethodID& out) {
+            out = env->GetMethodID(cls, name, signature);
+            if (!out) {
+                std::cerr << "Failed to find Java method " << name << signature << std::endl;
+            }
+            return out != NULL;
+        }
+
+        bool findStaticMethod(jclass cls, const char* name, const char* signature, jmethodID& out) {
+            out = env->GetStaticMethodID(cls, name, signature);
+            if (!out) {
+                std::cerr << "Failed to find static Java method " << name << signature << std::endl;
+            }
+            return out != NULL;
+        }
+
+        // Stores a global reference to every constant of an enum, in ordinal order
+        bool enumConstants(jclass cls, const char* valuesSignature, jobject* out, size_t count) {
+            jmethodID values = env->GetStaticMethodID(cls, "values", valuesSignature);
+            if (!values) return false;
+
+            auto array = static_cast<jobjectArray>(env->CallStaticObjectMethod(cls, values));
+            if (!array) return false;
+
+            bool ok = static_cast<size_t>(env->GetArrayLength(array)) == count;
+            if (!ok) {
+                std::cerr << "Java enum has " << env->GetArrayLength(array)
+                          << " constants, native code expects " << count << std::endl;
+            }
+            for (size_t i = 0; ok && i < count; i++) {
+                jobject local = env->GetObjectArrayElement(array, static_cast<jsize>(i));
+                out[i] = env->NewGlobalRef(local);
+                env->DeleteLocalRef(local);
+                if (!out[i]) {
+                    ok = false;
+                } else {
+                    created.push_back(out[i]);
+                }
+            }
+
+            env->DeleteLocalRef(array);
+            return ok;
+        }
+
+        void rollback() {
+            for (jobject ref : created) {
+                env->DeleteGlobalRef(ref);
+            }
+            created.clear();
+        }
+
+    private:
+        JNIEnv* env;
+        std::vector<jobject> created;
+    };
+
+    bool resolve(Resolver& r, JavaClassCache& c) {
+        return r.findClass("java/lang/Object", c.objectClass)
+            && r.findClass("java/lang/String", c.stringClass)
+
+            && r.findClass("net/swofty/nativebridge/representation/Command", c.commandClass)
+            && r.findMethod(c.commandClass, "<init>", "(Ljava/lang/String;)V", c.commandInit)
+            && r.findMethod(c.commandClass, "setPermission", "(Ljava/lang/String;)V", c.commandSetPermission)
+            && r.findMethod(c.commandClass, "setDescription", "(Ljava/lang/String;)V", c.commandSetDescription)
+            && r.findMethod(c.commandClass, "addArgument",
+                   "(Lnet/swofty/nativebridge/representation/Variable;)V", c.commandAddArgument)
+            && r.findMethod(c.commandClass, "setExecuteBlock",
+                   "(Lnet/swofty/nativebridge/representation/ExecuteBlock;)V", c.commandSetExecuteBlock)
+
+            && r.findClass("net/swofty/nativebridge/representation/Event", c.eventClass)
+            && r.findMethod(c.eventClass, "<init>", "(Ljava/lang/String;)V", c.eventInit)
+            && r.findMethod(c.eventClass, "setPriority", "(I)V", c.eventSetPriority)
+            && r.findMethod(c.eventClass, "setExecuteBlock",
+                   "(Lnet/swofty/nativebridge/representation/ExecuteBlock;)V", c.eventSetExecuteBlock)
+
+            && r.findClass("net/swofty/nativebridge/representation/Variable", c.variableClass)
+            && r.findMethod(c.variableClass, "<init>",
+                   "(Ljava/lang/String;Lnet/swofty/nativebridge/representation/DataType;)V", c.variableInit)
+            && r.findMethod(c.variableClass, "setDefault", "(Ljava/lang/String;)V", c.variableSetDefault)
+
+            && r.findClass("net/swofty/nativebridge/representation/DataType", c.dataTypeClass)
+            && r.findMethod(c.dataTypeClass, "<init>",
+                   "(Lnet/swofty/nativebridge/representation/BaseType;)V", c.dataTypeInit)
+            && r.findMethod(c.dataTypeClass, "addSubType",
+                   "(Lnet/swofty/nativebridge/representation/DataType;)V", c.dataTypeAddSubType)
+
+            && r.findClass("net/swofty/nativebridge/representation/BaseType", c.baseTypeClass)
+            && r.enumConstants(c.baseTypeClass, "()[Lnet/swofty/nativebridge/representation/BaseType;",
+                   c.baseTypes, BASE_TYPE_COUNT)
+
+            && r.findClass("net/swofty/nativebridge/representation/ExecuteBlock", c.executeBlockClass)
+            && r.findMethod(c.executeBlockClass, "<init>", "()V", c.executeBlockInit)
+            && r.findMethod(c.executeBlockClass, "addStatement",
+                   "(Lnet/swofty/nativebridge/execution/Statement;)V", c.executeBlockAddStatement)
+            && r.findMethod(c.executeBlockClass, "setSlotNames", "([Ljava/lang/String;)V",
+                   c.executeBlockSetSlotNames)
+            && r.findMethod(c.executeBlockClass, "setEventAccesses", "([Ljava/lang/String;[Ljava/lang/String;)V",
+                   c.executeBlockSetEventAccesses)
+            && r.findMethod(c.executeBlockClass, "setCanHalt", "(Z)V", c.executeBlockSetCanHalt)
+            && r.findMethod(c.executeBlockClass, "setEffects", "(I)V", c.executeBlockSetEffects)
+            && r.findMethod(c.executeBlockClass, "setProgram",
+                   "(Lnet/swofty/nativebridge/representation/Program;)V", c.executeBlockSetProgram)
+
+            && r.findClass("net/swofty/nativebridge/representation/Program", c.programClass)
+            && r.findMethod(c.programClass, "<init>", "([I[Ljava/lang/Object;[II)V", c.programInit)
+            && r.findClass("net/swofty/nativebridge/representation/SwitchTable", c.switchTableClass)
+            && r.findMethod(c.switchTableClass, "<init>", "([Ljava/lang/String;[I)V", c.switchTableInit)
+            && r.findMethod(c.switchTableClass, "getLabels", "()[Ljava/lang/String;", c.switchTableGetLabels)
+            && r.findMethod(c.switchTableClass, "getTargets", "()[I", c.switchTableGetTargets)
+            && r.findClass("net/swofty/nativebridge/representation/MatchTable", c.matchTableClass)
+            && r.findMethod(c.matchTableClass, "<init>", "([Ljava/lang/String;[I)V", c.matchTableInit)
+            && r.findMethod(c.matchTableClass, "getPatterns", "()[Ljava/lang/String;", c.matchTableGetPatterns)
+            && r.findMethod(c.matchTableClass, "getTargets", "()[I", c.matchTableGetTargets)
+
+            && r.findClass("java/lang/Boolean", c.booleanClass)
+            && r.findStaticMethod(c.booleanClass, "valueOf", "(Z)Ljava/lang/Boolean;", c.booleanValueOf)
+            && r.findMethod(c.booleanClass, "booleanValue", "()Z", c.booleanBooleanValue)
+            && r.findClass("java/lang/Number", c.numberClass)
+            && r.findMethod(c.numberClass, "doubleValue", "()D", c.numberDoubleValue)
+            && r.findMethod(c.objectClass, "equals", "(Ljava/lang/Object;)Z", c.objectEquals)
+            && r.findClass("java/lang/Throwable", c.throwableClass)
+            && r.findMethod(c.throwableClass, "getMessage", "()Ljava/lang/String;", c.throwableGetMessage)
+            && r.findClass("java/lang/RuntimeException", c.runtimeExceptionClass)
+            && r.findMethod(c.runtimeExceptionClass, "<init>", "(Ljava/lang/String;Ljava/lang/Throwable;)V",
+                   c.runtimeExceptionInit)
+            && r.findClass("net/swofty/nativebridge/NativeHost", c.nativeHostClass)
+            && r.findMethod(c.nativeHostClass, "getProperty", "(Ljava/lang/Object;Ljava/lang/String;)Ljava/lang/Object;",
+                   c.nativeHostGetProperty)
+            && r.findMethod(c.nativeHostClass, "text", "(Ljava/lang/Object;Z)Ljava/lang/String;", c.nativeHostText)
+            && r.findMethod(c.nativeHostClass, "typeOf", "(Ljava/lang/Object;)I", c.nativeHostTypeOf)
+            && r.findMethod(c.nativeHostClass, "apply", "([I[Ljava/lang/Object;)V", c.nativeHostApply)
+
+            && r.findClass("net/swofty/nativebridge/execution/BlockStatement", c.blockStatementClass)
+            && r.findMethod(c.blockStatementClass, "<init>", "()V", c.blockStatementInit)
+            && r.findMethod(c.blockStatementClass, "addStatement",
+                   "(Lnet/swofty/nativebridge/execution/Statement;)V", c.blockStatementAddStatement)
+
+            && r.findClass("net/swofty/nativebridge/execution/commands/SendCommand", c.sendCommandClass)
+            && r.findMethod(c.sendCommandClass, "<init>",
+                   "(Lnet/swofty/nativebridge/execution/Expression;Lnet/swofty/nativebridge/execution/Expression;)V",
+                   c.sendCommandInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/commands/TeleportCommand", c.teleportCommandClass)
+            && r.findMethod(c.teleportCommandClass, "<init>",
+                   "(Lnet/swofty/nativebridge/execution/Expression;Lnet/swofty/nativebridge/execution/Expression;)V",
+                   c.teleportCommandInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/commands/HaltCommand", c.haltCommandClass)
+            && r.findMethod(c.haltCommandClass, "<init>", "()V", c.haltCommandInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/commands/IfStatement", c.ifStatementClass)
+            && r.findMethod(c.ifStatementClass, "<init>",
+                   "(Lnet/swofty/nativebridge/execution/Expression;Lnet/swofty/nativebridge/execution/Statement;"
+                   "Lnet/swofty/nativebridge/execution/Statement;)V",
+                   c.ifStatementInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/Statement", c.statementClass)
+            && r.findClass("net/swofty/nativebridge/execution/commands/SwitchStatement", c.switchStatementClass)
+            && r.findMethod(c.switchStatementClass, "<init>",
+                   "(Lnet/swofty/nativebridge/execution/Expression;[Ljava/lang/String;"
+                   "[Lnet/swofty/nativebridge/execution/Statement;Lnet/swofty/nativebridge/execution/Statement;)V",
+                   c.switchStatementInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/commands/VariableAssignment", c.variableAssignmentClass)
+            && r.findMethod(c.variableAssignmentClass, "<init>",
+                   "(Ljava/lang/String;I[Ljava/lang/String;Lnet/swofty/nativebridge/execution/Expression;)V",
+                   c.variableAssignmentInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/commands/CancelEventStatement", c.cancelEventStatementClass)
+            && r.findMethod(c.cancelEventStatementClass, "<init>", "()V", c.cancelEventStatementInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/StringLiteral", c.stringLiteralClass)
+            && r.findMethod(c.stringLiteralClass, "<init>", "(Ljava/lang/String;)V", c.stringLiteralInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/VariableReference", c.variableReferenceClass)
+            && r.findMethod(c.variableReferenceClass, "<init>", "(Ljava/lang/String;I[Ljava/lang/String;)V",
+                   c.variableReferenceInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/BinaryExpression", c.binaryExpressionClass)
+            && r.findMethod(c.binaryExpressionClass, "<init>",
+                   "(Lnet/swofty/nativebridge/execution/Expression;"
+                   "Lnet/swofty/nativebridge/execution/expressions/BinaryExpression$Operator;"
+                   "Lnet/swofty/nativebridge/execution/Expression;)V",
+                   c.binaryExpressionInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/BinaryExpression$Operator", c.operatorClass)
+            && r.enumConstants(c.operatorClass,
+                   "()[Lnet/swofty/nativebridge/execution/expressions/BinaryExpression$Operator;",
+                   c.operators, BinaryExpression::OPERATOR_COUNT)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/TypeLiteral", c.typeLiteralClass)
+            && r.findMethod(c.typeLiteralClass, "<init>", "(Ljava/lang/String;)V", c.typeLiteralInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/EventAccessExpression",
+                   c.eventAccessExpressionClass)
+            && r.findMethod(c.eventAccessExpressionClass, "<init>", "(Ljava/lang/String;)V",
+                   c.eventAccessExpressionInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/Expression", c.expressionClass)
+            && r.findClass("net/swofty/nativebridge/execution/expressions/InterpolatedString",
+                   c.interpolatedStringClass)
+            && r.findMethod(c.interpolatedStringClass, "<init>",
+                   "([Lnet/swofty/nativebridge/execution/Expression;I)V", c.interpolatedStringInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/BooleanLiteral", c.booleanLiteralClass)
+            && r.findMethod(c.booleanLiteralClass, "<init>", "(Z)V", c.booleanLiteralInit)
+
+            && r.findClass("net/swofty/nativebridge/execution/expressions/Concat", c.concatClass)
+            && r.findMethod(c.concatClass, "<init>",
+                   "([Lnet/swofty/nativebridge/execution/Expression;I)V", c.concatInit);
+    }
+}
+
+const JavaClassCache* JavaClassCache::get(JNIEnv* env) {
+    JavaClassCache* current = cache.load(std::memory_order_acquire);
+    if (current) {
+        return current;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    current = cache.load(std::memory_order_relaxed);
+    if (current) {
+        return current;
+    }
+
+    JavaClassCache* resolved = new JavaClassCache();
+    Resolver resolver(env);
+    if (!resolve(resolver, *resolved)) {
+        resolver.rollback();
+        delete resolved;
+        return NULL;
+    }
+
+    cache.store(resolved, std::memory_order_release);
+    return resolved;
+}
+
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
+    JNIEnv* env;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    // Resolving here runs with the loader that loaded the library. A failure is not
+    // fatal: the FFM entry points do not need the cache, and get() retries on first use.
+    if (!JavaClassCache::get(env)) {
+        checkAndClearJNIException(env, "JNI_OnLoad");
+    }
+    return JNI_VERSION_1_6;
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <jni.h>
+#include <DataType.h>
+#include <BinaryExpression.h>
+
+// Global references to every Java class the bridge instantiates, plus the constructor
+// and method IDs it calls. Resolved once per JVM, so marshalling a node costs a
+// NewObject call instead of FindClass + GetMethodID + NewObject. JNI_OnLoad resolves it
+// up front; get() covers a load that failed there.
+struct JavaClassCache {
+    jclass objectClass;
+    jclass stringClass;
+
+    jclass commandClass;
+    jmethodID commandInit;
+    jmethodID commandSetPermission;
+    jmethodID commandSetDescription;
+    jmethodID commandAddArgument;
+    jmethodID commandSetExecuteBlock;
+
+    jclass eventClass;
+    jmethodID eventInit;
+    jmethodID eventSetPriority;
+    jmethodID eventSetExecuteBlock;
+
+    jclass variableClass;
+    jmethodID variableInit;
+    jmethodID variableSetDefault;
+
+    jclass dataTypeClass;
+    jmethodID dataTypeInit;
+    jmethodID dataTypeAddSubType;
+
+    jclass baseTypeClass;
+    jobject baseTypes[BASE_TYPE_COUNT];
+
+    jclass executeBlockClass;
+    jmethodID executeBlockInit;
+    jmethodID executeBlockAddStatement;
+    jmethodID executeBlockSetSlotNames;
+    jmethodID executeBlockSetEventAccesses;
+    jmethodID executeBlockSetCanHalt;
+    jmethodID executeBlockSetEffects;
+    jmethodID executeBlockSetProgram;
+
+    jclass programClass;
+    jmethodID programInit;
+    jclass switchTableClass;
+    jmethodID switchTableInit;
+    jmethodID switchTableGetLabels;
+    jmethodID switchTableGetTargets;
+    jclass matchTableClass;
+    jmethodID matchTableInit;
+    jmethodID matchTableGetPatterns;
+    jmethodID matchTableGetTargets;
+
+    // Used by the native VM (see JniHost)
+    jclass booleanClass;
+    jmethodID booleanValueOf;       // static
+    jmethodID booleanBooleanValue;
+    jclass numberClass;
+    jmethodID numberDoubleValue;
+    jmethodID objectEquals;
+    jclass throwableClass;
+    jmethodID throwableGetMessage;
+    jclass runtimeExceptionClass;
+    jmethodID runtimeExceptionInit;
+    jclass nativeHostClass;
+    jmethodID nativeHostGetProperty;
+    jmethodID nativeHostText;
+    jmethodID nativeHostTypeOf;
+    jmethodID nativeHostApply;
+
+    jclass blockStatementClass;
+    jmethodID blockStatementInit;
+    jmethodID blockStatementAddStatement;
+
+    jclass sendCommandClass;
+    jmethodID sendCommandInit;
+
+    jclass teleportCommandClass;
+    jmethodID teleportCommandInit;
+
+    jclass haltCommandClass;
+    jmethodID haltCommandInit;
+
+    jclass ifStatementClass;
+    jmethodID ifStatementInit;
+
+    jclass statementClass;
+    jclass switchStatementClass;
+    jmethodID switchStatementInit;
+
+    jclass variableAssignmentClass;
+    jmethodID variableAssignmentInit;
+
+    jclass cancelEventStatementClass;
+    jmethodID cancelEventStatementInit;
+
+    jclass stringLiteralClass;
+    jmethodID stringLiteralInit;
+
+    jclass variableReferenceClass;
+    jmethodID variableReferenceInit;
+
+    jclass binaryExpressionClass;
+    jmethodID binaryExpressionInit;
+
+    jclass operatorClass;
+    jobject operators[BinaryExpression::OPERATOR_COUNT];
+
+    jclass typeLiteralClass;
+    jmethodID typeLiteralInit;
+
+    jclass eventAccessExpressionClass;
+    jmethodID eventAccessExpressionInit;
+
+    jclass expressionClass;
+    jclass interpolatedStringClass;
+    jmethodID interpolatedStringInit;
+
+    jclass booleanLiteralClass;
+    jmethodID booleanLiteralInit;
+
+    jclass concatClass;
+    jmethodID concatInit;
+
+    // Enum constants, indexed by the ordinal of the matching C++ enum. These are global
+    // references and must not be passed to DeleteLocalRef.
+    jobject baseType(BaseType type) const { return baseTypes[static_cast<size_t>(type)]; }
+    jobject binaryOperator(BinaryExpression::Operator op) const { return operators[static_cast<size_t>(op)]; }
+
+    // Returns the cache, resolving it on first use. Returns NULL and leaves the Java
+    // exception (e.g. NoClassDefFoundError) pending if anything could not be resolved;
+    // the next call tries again.
+    static const JavaClassCache* get(JNIEnv* env);
+};
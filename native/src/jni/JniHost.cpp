@@ -0,0 +1,172 @@
+#include "JniHost.h"
+#include <stdexcept>
+
+namespace {
+    // Object types returned by NativeHost.typeOf - must match NativeHost.java
+    Value::ObjectType objectType(jint type) {
+        switch (type) {
+            case 1: return Value::ObjectType::PLAYER;
+            case 2: return Value::ObjectType::LOCATION;
+            default: return Value::ObjectType::OTHER;
+        }
+    }
+}
+
+JniHost::JniHost(JNIEnv* env, const JavaClassCache& classes, jobject host)
+    : env(env), classes(classes), host(host) {}
+
+Value JniHost::toValue(jobject object) {
+    if (!object) {
+        return Value::nil();
+    }
+
+    if (env->IsInstanceOf(object, classes.stringClass)) {
+        Value value = Value::string(toString(static_cast<jstring>(object)));
+        env->DeleteLocalRef(object);
+        return value;
+    }
+
+    if (env->IsInstanceOf(object, classes.booleanClass)) {
+        Value value = Value::boolean(env->CallBooleanMethod(object, classes.booleanBooleanValue) == JNI_TRUE);
+        env->DeleteLocalRef(object);
+        return value;
+    }
+
+    if (env->IsInstanceOf(object, classes.numberClass)) {
+        double number = env->CallDoubleMethod(object, classes.numberDoubleValue);
+        check();
+        return Value::number(number, keep(object));
+    }
+
+    jint type = env->CallIntMethod(host, classes.nativeHostTypeOf, object);
+    check();
+    return Value::object(keep(object), objectType(type));
+}
+
+jobject JniHost::toJava(const Value& value) {
+    switch (value.kind) {
+        case Value::Kind::NIL:
+            return NULL;
+        case Value::Kind::BOOLEAN:
+            return env->CallStaticObjectMethod(classes.booleanClass, classes.booleanValueOf,
+                                               value.flag ? JNI_TRUE : JNI_FALSE);
+        case Value::Kind::STRING:
+            return env->NewStringUTF(value.text.c_str());
+        case Value::Kind::NUMBER:
+        case Value::Kind::OBJECT:
+            return env->NewLocalRef(handles[value.handle]);
+    }
+    return NULL;
+}
+
+Value JniHost::getProperty(const Value& object, const std::string& property) {
+    jobject target = toJava(object);
+    jstring name = env->NewStringUTF(property.c_str());
+    jobject result = env->CallObjectMethod(host, classes.nativeHostGetProperty, target, name);
+    env->DeleteLocalRef(name);
+    env->DeleteLocalRef(target);
+    check();
+    return toValue(result);
+}
+
+std::string JniHost::text(const Value& value, bool display) {
+    jobject object = toJava(value);
+    auto result = static_cast<jstring>(env->CallObjectMethod(host, classes.nativeHostText, object,
+                                                             display ? JNI_TRUE : JNI_FALSE));
+    env->DeleteLocalRef(object);
+    check();
+
+    std::string text = result ? toString(result) : "null";
+    env->DeleteLocalRef(result);
+    return text;
+}
+
+bool JniHost::equals(const Value& first, const Value& second) {
+    jobject left = toJava(first);
+    jobject right = toJava(second);
+    jboolean result = env->CallBooleanMethod(left, classes.objectEquals, right);
+    env->DeleteLocalRef(right);
+    env->DeleteLocalRef(left);
+    check();
+    return result == JNI_TRUE;
+}
+
+bool JniHost::identical(int32_t first, int32_t second) {
+    return env->IsSameObject(handles[first], handles[second]) == JNI_TRUE;
+}
+
+void JniHost::apply(const std::vector<Effect>& effects) {
+    // A flush on the way out of a failed run must not call into Java again
+    if (failure) {
+        return;
+    }
+
+    auto size = static_cast<jsize>(effects.size());
+    jintArray kinds = env->NewIntArray(size);
+    jobjectArray operands = kinds ? env->NewObjectArray(size * 3, classes.objectClass, NULL) : NULL;
+    if (!operands) {
+        env->DeleteLocalRef(kinds);
+        check();
+        return;
+    }
+
+    std::vector<jint> values(effects.size());
+    for (jsize i = 0; i < size; i++) {
+        const Effect& effect = effects[i];
+        values[i] = static_cast<jint>(effect.kind);
+
+        jobject first = toJava(effect.first);
+        jobject second = toJava(effect.second);
+        jobject property = effect.kind == Effect::Kind::SET_PROPERTY ? env->NewStringUTF(effect.property.c_str()) : NULL;
+        env->SetObjectArrayElement(operands, i * 3, first);
+        env->SetObjectArrayElement(operands, i * 3 + 1, second);
+        env->SetObjectArrayElement(operands, i * 3 + 2, property);
+        env->DeleteLocalRef(property);
+        env->DeleteLocalRef(second);
+        env->DeleteLocalRef(first);
+    }
+    env->SetIntArrayRegion(kinds, 0, size, values.data());
+
+    env->CallVoidMethod(host, classes.nativeHostApply, kinds, operands);
+    env->DeleteLocalRef(operands);
+    env->DeleteLocalRef(kinds);
+    check();
+}
+
+int32_t JniHost::keep(jobject object) {
+    handles.push_back(object);
+    return static_cast<int32_t>(handles.size() - 1);
+}
+
+std::string JniHost::toString(jstring string) {
+    const char* chars = env->GetStringUTFChars(string, NULL);
+    if (!chars) {
+        check();
+        return std::string();
+    }
+    std::string text(chars, static_cast<size_t>(env->GetStringUTFLength(string)));
+    env->ReleaseStringUTFChars(string, chars);
+    return text;
+}
+
+void JniHost::check() {
+    if (!env->ExceptionCheck()) {
+        return;
+    }
+
+    jthrowable thrown = env->ExceptionOccurred();
+    env->ExceptionClear();
+    if (!failure) {
+        failure = thrown;
+    }
+
+    auto message = static_cast<jstring>(env->CallObjectMethod(thrown, classes.throwableGetMessage));
+    std::string text = "null";
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+    } else if (message) {
+        text = toString(message);
+    }
+    env->DeleteLocalRef(message);
+    throw std::runtime_error(text);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <jni.h>
+#include <vector>
+#include "Host.h"
+#include "JavaClassCache.h"
+
+// The VM's Host inside the JVM: forwards to a net.swofty.nativebridge.NativeHost.
+//
+// Java values a handler reads become native Values - strings and booleans by value,
+// everything else as a handle into a table of local references, so the objects stay
+// in Java and are passed back as they are. One JniHost serves one run and must live
+// inside a local frame the caller pops afterwards.
+//
+// A Java exception thrown by an upcall is cleared and kept (see getFailure), and its
+// message is rethrown as std::runtime_error so the VM unwinds normally.
+class JniHost : public Host {
+public:
+    JniHost(JNIEnv* env, const JavaClassCache& classes, jobject host);
+
+    // Converts a local reference, which the host then owns
+    Value toValue(jobject object);
+
+    // A new local reference for a value; NULL for NIL
+    jobject toJava(const Value& value);
+
+    // The first Java exception an upcall threw, if any
+    jthrowable getFailure() const { return failure; }
+
+    Value getProperty(const Value& object, const std::string& property) override;
+    std::string text(const Value& value, bool display) override;
+    bool equals(const Value& first, const Value& second) override;
+    bool identical(int32_t first, int32_t second) override;
+    void apply(const std::vector<Effect>& effects) override;
+
+private:
+    JNIEnv* env;
+    const JavaClassCache& classes;
+    jobject host;
+    std::vector<jobject> handles;
+    jthrowable failure = NULL;
+
+    int32_t keep(jobject object);
+    std::string toString(jstring string);
+    void check();
+};
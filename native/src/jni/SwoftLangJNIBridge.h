@@ -2,6 +2,8 @@
 #include <jni.h>
 #include <vector>
 #include <memory>
+#include "JStringInterner.h"
+#include "JavaClassCache.h"
 
 // Include all AST files individually
 #include "ASTNode.h"
@@ -42,30 +44,14 @@ public:
     
 private:
     // Helper methods to convert C++ objects to Java objects
-    static jobject createJavaCommand(JNIEnv* env, const std::shared_ptr<Command>& command);
-    static jobject createJavaVariable(JNIEnv* env, const std::shared_ptr<Variable>& variable);
-    static jobject createJavaDataType(JNIEnv* env, const std::shared_ptr<DataType>& dataType);
-    
-    // AST conversion - fix the function signatures
-    static jobject createJavaExecuteBlock(JNIEnv* env, const std::shared_ptr<ExecuteBlock>& block);
-    static jobject createJavaStatement(JNIEnv* env, const std::shared_ptr<Statement>& statement);
-    static jobject createJavaExpression(JNIEnv* env, const std::shared_ptr<Expression>& expression);
-    
-    // Statement creation methods
-    static jobject createJavaSendCommand(JNIEnv* env, const std::shared_ptr<SendCommand>& command);
-    static jobject createJavaTeleportCommand(JNIEnv* env, const std::shared_ptr<TeleportCommand>& command);
-    static jobject createJavaHaltCommand(JNIEnv* env, const std::shared_ptr<HaltCommand>& command);
-    static jobject createJavaIfStatement(JNIEnv* env, const std::shared_ptr<IfStatement>& statement);
-    static jobject createJavaBlockStatement(JNIEnv* env, const std::shared_ptr<BlockStatement>& statement);
-    static jobject createJavaVariableAssignment(JNIEnv* env, const std::shared_ptr<VariableAssignment>& assignment);
-    
-    // Expression creation methods
-    static jobject createJavaStringLiteral(JNIEnv* env, const std::shared_ptr<StringLiteral>& literal);
-    static jobject createJavaVariableReference(JNIEnv* env, const std::shared_ptr<VariableReference>& reference);
-    static jobject createJavaBinaryExpression(JNIEnv* env, const std::shared_ptr<BinaryExpression>& expression);
-    static jobject createJavaTypeLiteral(JNIEnv* env, const std::shared_ptr<TypeLiteral>& literal);
-    
-    // Event-related methods
-    static jobject createJavaEvent(JNIEnv* env, const std::shared_ptr<Event>& event);
-    static jobject createJavaCancelEventStatement(JNIEnv* env, const std::shared_ptr<CancelEventStatement>& statement);
-};
\ No newline at end of file
+    static jobject createJavaCommand(JNIEnv* env, JStringInterner& strings, const JavaClassCache& classes, const std::shared_ptr<Command>& command);
+    static jobject createJavaVariable(JNIEnv* env, JStringInterner& strings, const JavaClassCache& classes, const std::shared_ptr<Variable>& variable);
+    static jobject createJavaDataType(JNIEnv* env, const JavaClassCache& classes, const std::shared_ptr<DataType>& dataType);
+    static jobject createJavaEvent(JNIEnv* env, JStringInterner& strings, const JavaClassCache& classes, const std::shared_ptr<Event>& event);
+    
+    // AST conversion - see AstMarshaller
+    static jobject createJavaExecuteBlock(JNIEnv* env, JStringInterner& strings, const JavaClassCache& classes, const std::shared_ptr<ExecuteBlock>& block);
+};
+
+// Logs and clears a pending Java exception; returns true if there was one
+bool checkAndClearJNIException(JNIEnv* env, const char* context);
@@ -0,0 +1,221 @@
+// net_swofty_nativebridge_NativeEngine.cpp
+#include <jni.h>
+#include <net_swofty_nativebridge_NativeEngine.h>
+#include <new>
+#include "JavaClassCache.h"
+#include "JniHost.h"
+#include "JvmBackend.h"
+#include "VirtualMachine.h"
+
+namespace {
+    // Local references a run may hold at once before the JVM has to grow the frame
+    const jint RUN_FRAME_CAPACITY = 64;
+
+    bool readStrings(JNIEnv* env, jobjectArray array, std::vector<std::string>& out) {
+        jsize length = env->GetArrayLength(array);
+        for (jsize i = 0; i < length; i++) {
+            auto string = static_cast<jstring>(env->GetObjectArrayElement(array, i));
+            const char* chars = string ? env->GetStringUTFChars(string, NULL) : NULL;
+            if (!chars) {
+                env->DeleteLocalRef(string);
+                return false;
+            }
+            out.emplace_back(chars, static_cast<size_t>(env->GetStringUTFLength(string)));
+            env->ReleaseStringUTFChars(string, chars);
+            env->DeleteLocalRef(string);
+        }
+        return true;
+    }
+
+    // One entry of a Java Program's constant pool (see AstMarshaller::buildProgram)
+    bool readConstant(JNIEnv* env, const JavaClassCache& classes, jobject value, Constant& constant) {
+        if (env->IsInstanceOf(value, classes.stringClass)) {
+            constant.kind = Constant::Kind::STRING;
+            auto string = static_cast<jstring>(value);
+            const char* chars = env->GetStringUTFChars(string, NULL);
+            if (!chars) return false;
+            constant.strings.emplace_back(chars, static_cast<size_t>(env->GetStringUTFLength(string)));
+            env->ReleaseStringUTFChars(string, chars);
+            return true;
+        }
+
+        bool isSwitch = env->IsInstanceOf(value, classes.switchTableClass);
+        if (isSwitch || env->IsInstanceOf(value, classes.matchTableClass)) {
+            // Both tables are strings and the offset each one jumps to
+            constant.kind = isSwitch ? Constant::Kind::SWITCH : Constant::Kind::MATCH;
+            auto labels = static_cast<jobjectArray>(env->CallObjectMethod(value,
+                isSwitch ? classes.switchTableGetLabels : classes.matchTableGetPatterns));
+            auto targets = static_cast<jintArray>(env->CallObjectMethod(value,
+                isSwitch ? classes.switchTableGetTargets : classes.matchTableGetTargets));
+            bool ok = labels && targets && readStrings(env, labels, constant.strings);
+            if (ok) {
+                constant.targets.resize(static_cast<size_t>(env->GetArrayLength(targets)));
+                env->GetIntArrayRegion(targets, 0, static_cast<jsize>(constant.targets.size()), constant.targets.data());
+                ok = constant.targets.size() == constant.strings.size();
+            }
+            env->DeleteLocalRef(targets);
+            env->DeleteLocalRef(labels);
+            return ok;
+        }
+
+        constant.kind = Constant::Kind::PATH;
+        return readStrings(env, static_cast<jobjectArray>(value), constant.strings);
+    }
+
+    // Rebuilds the Program a Java Program was made from. Returns false with a Java
+    // exception pending if it is malformed.
+    bool readProgram(JNIEnv* env, const JavaClassCache& classes, jintArray code, jobjectArray constants,
+                     jintArray lines, jint registerCount, Program& program) {
+        program.registerCount = registerCount;
+        program.code.resize(static_cast<size_t>(env->GetArrayLength(code)));
+        env->GetIntArrayRegion(code, 0, static_cast<jsize>(program.code.size()), program.code.data());
+
+        std::vector<jint> pairs(static_cast<size_t>(env->GetArrayLength(lines)));
+        env->GetIntArrayRegion(lines, 0, static_cast<jsize>(pairs.size()), pairs.data());
+        for (size_t i = 0; i + 1 < pairs.size(); i += 2) {
+            program.lines.emplace_back(pairs[i], pairs[i + 1]);
+        }
+
+        jsize constantCount = env->GetArrayLength(constants);
+        for (jsize i = 0; i < constantCount; i++) {
+            jobject value = env->GetObjectArrayElement(constants, i);
+            Constant constant;
+            bool ok = value && readConstant(env, classes, value, constant);
+            env->DeleteLocalRef(value);
+            if (!ok) {
+                if (!env->ExceptionCheck()) {
+                    env->ThrowNew(classes.runtimeExceptionClass, "Malformed program constant");
+                }
+                return false;
+            }
+            program.constants.push_back(std::move(constant));
+        }
+        return true;
+    }
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    load
+ * Signature: ([I[Ljava/lang/Object;[II)J
+ */
+JNIEXPORT jlong JNICALL Java_net_swofty_nativebridge_NativeEngine_load
+  (JNIEnv* env, jclass clazz, jintArray code, jobjectArray constants, jintArray lines, jint registerCount) {
+    const JavaClassCache* classes = JavaClassCache::get(env);
+    if (!classes) {
+        return 0;
+    }
+
+    Program program;
+    if (!readProgram(env, *classes, code, constants, lines, registerCount, program)) {
+        return 0;
+    }
+
+    auto vm = new (std::nothrow) VirtualMachine(std::move(program));
+    if (!vm) {
+        env->ThrowNew(classes->runtimeExceptionClass, "Out of memory loading a program");
+        return 0;
+    }
+    return reinterpret_cast<jlong>(vm);
+}
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    free
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_net_swofty_nativebridge_NativeEngine_free
+  (JNIEnv* env, jclass clazz, jlong handle) {
+    delete reinterpret_cast<VirtualMachine*>(handle);
+}
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    run
+ * Signature: (J[Ljava/lang/Object;Lnet/swofty/nativebridge/NativeHost;)I
+ */
+JNIEXPORT jint JNICALL Java_net_swofty_nativebridge_NativeEngine_run
+  (JNIEnv* env, jclass clazz, jlong handle, jobjectArray frame, jobject host) {
+    const JavaClassCache* classes = JavaClassCache::get(env);
+    if (!classes || env->PushLocalFrame(RUN_FRAME_CAPACITY) != 0) {
+        return -1;
+    }
+
+    jint result = -1;
+    {
+        JniHost jniHost(env, *classes, host);
+        const auto* vm = reinterpret_cast<const VirtualMachine*>(handle);
+
+        try {
+            std::vector<Value> values;
+            jsize slots = env->GetArrayLength(frame);
+            values.reserve(static_cast<size_t>(vm->getProgram().registerCount));
+            for (jsize i = 0; i < slots; i++) {
+                values.push_back(jniHost.toValue(env->GetObjectArrayElement(frame, i)));
+            }
+
+            result = vm->run(values, jniHost) == VirtualMachine::Outcome::HALTED ? 1 : 0;
+        } catch (const std::exception& e) {
+            // Keeps the Java exception that caused the failure, if there was one
+            jstring message = env->NewStringUTF(e.what());
+            auto exception = static_cast<jthrowable>(env->NewObject(classes->runtimeExceptionClass,
+                                                                    classes->runtimeExceptionInit,
+                                                                    message, jniHost.getFailure()));
+            if (exception) {
+                env->Throw(exception);
+            }
+        }
+    }
+
+    env->PopLocalFrame(NULL);
+    return result;
+}
+
+/*
+ * Class:     net_swofty_nativebridge_NativeEngine
+ * Method:    generateClass
+ * Signature: ([I[Ljava/lang/Object;[IIILjava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_net_swofty_nativebridge_NativeEngine_generateClass
+  (JNIEnv* env, jclass clazz, jintArray code, jobjectArray constants, jintArray lines, jint registerCount,
+   jint slotCount, jstring className) {
+    const JavaClassCache* classes = JavaClassCache::get(env);
+    if (!classes) {
+        return NULL;
+    }
+
+    Program program;
+    if (!readProgram(env, *classes, code, constants, lines, registerCount, program)) {
+        return NULL;
+    }
+
+    const char* nameChars = env->GetStringUTFChars(className, NULL);
+    if (!nameChars) {
+        return NULL;
+    }
+    std::string name(nameChars);
+    env->ReleaseStringUTFChars(className, nameChars);
+
+    std::vector<uint8_t> bytes;
+    try {
+        bytes = JvmBackend::generate(program, static_cast<size_t>(slotCount), name);
+    } catch (const std::exception& e) {
+        env->ThrowNew(classes->runtimeExceptionClass, (std::string("Cannot generate a class: ") + e.what()).c_str());
+        return NULL;
+    }
+
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(bytes.size()));
+    if (result) {
+        env->SetByteArrayRegion(result, 0, static_cast<jsize>(bytes.size()),
+                                reinterpret_cast<const jbyte*>(bytes.data()));
+    }
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
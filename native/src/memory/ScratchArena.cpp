@@ -0,0 +1,84 @@
+#include "ScratchArena.h"
+#include <algorithm>
+#include <cstdint>
+
+struct ThreadArena {
+    ScratchArena* arena = new ScratchArena();
+    int depth = 0;
+
+    ~ThreadArena() {
+        // Drop the owner reference; the arena goes away with its last live node
+        arena->release();
+    }
+
+    void beginParse() {
+        if (arena->refs.load(std::memory_order_acquire) == 1) {
+            arena->rewind();
+            return;
+        }
+
+        // Nodes from an earlier parse are still held somewhere - leave them their arena
+        ScratchArena* previous = arena;
+        arena = new ScratchArena();
+        previous->release();
+    }
+};
+
+static thread_local ThreadArena threadArena;
+
+ScratchArena::Scope::Scope() : outermost(threadArena.depth == 0) {
+    if (outermost) {
+        threadArena.beginParse();
+    }
+    threadArena.depth++;
+}
+
+ScratchArena::Scope::~Scope() {
+    threadArena.depth--;
+}
+
+ScratchArena* ScratchArena::current() {
+    return threadArena.arena;
+}
+
+void* ScratchArena::allocate(size_t size, size_t alignment) {
+    for (;;) {
+        if (blockIndex == blocks.size()) {
+            addBlock(size + alignment);
+        }
+
+        Block& block = blocks[blockIndex];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        size_t end = static_cast<size_t>(aligned - base) + size;
+
+        if (end <= block.size) {
+            offset = end;
+            refs.fetch_add(1, std::memory_order_relaxed);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        blockIndex++;
+        offset = 0;
+    }
+}
+
+void ScratchArena::release() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void ScratchArena::rewind() {
+    blockIndex = 0;
+    offset = 0;
+}
+
+void ScratchArena::addBlock(size_t minSize) {
+    size_t size = blocks.empty() ? FIRST_BLOCK_SIZE : std::min(blocks.back().size * 2, MAX_BLOCK_SIZE);
+    size = std::max(size, minSize);
+
+    blocks.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+    blockIndex = blocks.size() - 1;
+    offset = 0;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Per-thread bump allocator for parse scratch memory (AST nodes, commands, events).
+//
+// Each thread owns one arena. Allocations bump a pointer through a list of blocks and
+// are never freed individually; instead the arena counts outstanding allocations and,
+// when a new parse begins on the owning thread and nothing from the previous parse is
+// still alive, rewinds to the first block so the same memory is reused.
+//
+// Nodes may be released on any thread. If a parse starts while nodes from an earlier
+// one are still held, the old arena is handed off (it deletes itself once the last of
+// those nodes is released) and the thread starts a fresh one.
+class ScratchArena {
+public:
+    // Marks the extent of one parse on this thread. Nested scopes (a parse started
+    // from inside another on the same thread) share the outer scope's arena.
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        // True for the outermost scope on this thread - only it may reuse thread scratch
+        bool isOutermost() const { return outermost; }
+
+    private:
+        bool outermost;
+    };
+
+    // Allocates a T and its shared_ptr control block from this thread's arena
+    template<typename T, typename... Args>
+    static std::shared_ptr<T> make(Args&&... args);
+
+    static ScratchArena* current();
+
+    void* allocate(size_t size, size_t alignment);
+    void release();
+
+    size_t getBlockCount() const { return blocks.size(); }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    static constexpr size_t FIRST_BLOCK_SIZE = 16 * 1024;
+    static constexpr size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+    std::vector<Block> blocks;
+    size_t blockIndex = 0;
+    size_t offset = 0;
+
+    // One reference for the owning thread plus one per live allocation
+    std::atomic<size_t> refs{1};
+
+    ScratchArena() = default;
+
+    void rewind();
+    void addBlock(size_t minSize);
+
+    friend struct ThreadArena;
+};
+
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(ScratchArena* arena) : arena(arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {
+        arena->release();
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    ScratchArena* arena;
+
+    template<typename U>
+    friend class ArenaAllocator;
+};
+
+template<typename T, typename... Args>
+std::shared_ptr<T> ScratchArena::make(Args&&... args) {
+    return std::allocate_shared<T>(ArenaAllocator<T>(current()), std::forward<Args>(args)...);
+}
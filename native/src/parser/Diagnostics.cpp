@@ -0,0 +1,22 @@
+#include "Diagnostics.h"
+#include <iostream>
+
+namespace {
+    thread_local Diagnostics::Scope* currentScope = nullptr;
+}
+
+Diagnostics::Scope::Scope() : previous(currentScope) {
+    currentScope = this;
+}
+
+Diagnostics::Scope::~Scope() {
+    currentScope = previous;
+}
+
+void Diagnostics::note(const std::string& message) {
+    if (currentScope) {
+        currentScope->notes.push_back(message);
+    } else {
+        std::cerr << "SwoftLang: " << message << std::endl;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Informational notes produced while compiling a script, such as how much code an
+// optimisation pass removed. They are not errors - errors are thrown.
+//
+// An entry point that can hand notes back to its caller opens a Scope for the parse;
+// notes made on that thread are collected there. Without a scope they go to std::cerr
+// with the rest of the native log.
+class Diagnostics {
+public:
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        const std::vector<std::string>& getNotes() const { return notes; }
+
+    private:
+        std::vector<std::string> notes;
+        Scope* previous;
+
+        friend class Diagnostics;
+    };
+
+    static void note(const std::string& message);
+};
@@ -101,7 +101,18 @@ Token Lexer::scanToken() {
             return Token(TokenType::RIGHT_ANGLE, ">", line, column - 1);
         case '|': 
             advance();
+            if (peek() == '|') {
+                advance();
+                return Token(TokenType::OR, "||", line, column - 2);
+            }
             return Token(TokenType::PIPE, "|", line, column - 1);
+        case '&':
+            if (position + 1 < source.length() && source[position + 1] == '&') {
+                advance();
+                advance();
+                return Token(TokenType::AND, "&&", line, column - 2);
+            }
+            break;
         case ',': 
             advance();
             return Token(TokenType::COMMA, ",", line, column - 1);
@@ -206,6 +217,12 @@ Token Lexer::scanComment() {
 
 std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
+    tokenize(tokens);
+    return tokens;
+}
+
+void Lexer::tokenize(std::vector<Token>& tokens) {
+    tokens.clear();
     
     while (!isAtEnd()) {
         Token token = scanToken();
@@ -216,5 +233,4 @@ std::vector<Token> Lexer::tokenize() {
     }
     
     tokens.push_back(Token(TokenType::END_OF_FILE, "", line, column));
-    return tokens;
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 class Lexer {
 private:
-    std::string source;
+    const std::string& source;
     size_t position = 0;
     size_t line = 1;
     size_t column = 1;
@@ -23,4 +23,6 @@ private:
 public:
     Lexer(const std::string& source);
     std::vector<Token> tokenize();
+    // Tokenizes into an existing buffer so its capacity can be reused between parses
+    void tokenize(std::vector<Token>& tokens);
 };
\ No newline at end of file
@@ -22,7 +22,7 @@ public:
     const std::vector<std::shared_ptr<Event>>& getEvents() const { return events; }
     
 private:
-    std::vector<Token> tokens;
+    const std::vector<Token>& tokens; // Not copied - the caller keeps the token buffer alive
     size_t current = 0;
     std::vector<std::shared_ptr<Command>> commands;
     std::vector<std::shared_ptr<Event>> events;
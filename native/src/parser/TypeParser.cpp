@@ -1,6 +1,7 @@
 // TypeParser.cpp
 #include "TypeParser.h"
 #include <stdexcept>
+#include <ScratchArena.h>
 
 TypeParser::TypeParser(const std::vector<Token>& tokens) : tokens(tokens) {}
 
@@ -57,7 +58,7 @@ std::shared_ptr<DataType> TypeParser::parseEitherType() {
         throw std::runtime_error("Expected '<' after 'either'");
     }
     
-    auto eitherType = std::make_shared<DataType>(BaseType::EITHER);
+    auto eitherType = ScratchArena::make<DataType>(BaseType::EITHER);
     
     // Parse first subtype
     eitherType->addSubType(parseType());
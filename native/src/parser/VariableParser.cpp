@@ -2,6 +2,7 @@
 #include "VariableParser.h"
 #include "TypeParser.h"
 #include <stdexcept>
+#include <ScratchArena.h>
 #include <iostream>
 
 VariableParser::VariableParser(const std::vector<Token>& tokens) : tokens(tokens) {}
@@ -102,12 +103,6 @@ std::shared_ptr<Variable> VariableParser::parseVariable() {
     std::vector<Token> typeTokens(tokens.begin() + typeStart, tokens.begin() + typeEnd);
     typeTokens.push_back(Token(TokenType::END_OF_FILE, "", 0, 0));
     
-    // Debug: Print the tokens we're sending to TypeParser
-    std::cout << "Type tokens for variable '" << varName << "':" << std::endl;
-    for (const auto& token : typeTokens) {
-        std::cout << "  Type: " << (int)token.type << " Value: '" << token.value << "'" << std::endl;
-    }
-    
     // Parse the type using TypeParser
     TypeParser typeParser(typeTokens);
     std::shared_ptr<DataType> type;
@@ -127,7 +122,7 @@ std::shared_ptr<Variable> VariableParser::parseVariable() {
     current = typeEnd;
     
     // Create the variable
-    auto variable = std::make_shared<Variable>(varName, type);
+    auto variable = ScratchArena::make<Variable>(varName, type);
     
     // Skip whitespace before checking for default value
     while (!isAtEnd() && check(TokenType::WHITESPACE)) {
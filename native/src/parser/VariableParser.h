@@ -7,7 +7,7 @@
 
 class VariableParser {
 private:
-    std::vector<Token> tokens;
+    const std::vector<Token>& tokens;
     size_t current = 0;
     
     Token peek() const;
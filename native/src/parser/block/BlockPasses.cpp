@@ -0,0 +1,14 @@
+#include "BlockPasses.h"
+#include "DeadCodeEliminator.h"
+#include "SlotResolver.h"
+#include "ConditionCompiler.h"
+#include "EffectAnalyzer.h"
+
+void BlockPasses::run(ExecuteBlock& block, const std::vector<std::string>& parameters,
+                      const TypeChecker::Environment& environment, const std::string& label) {
+    DeadCodeEliminator::run(block, label);
+    SlotResolver::resolve(block, parameters);
+    TypeChecker::check(block, environment, label);
+    ConditionCompiler::run(block);
+    EffectAnalyzer::run(block);
+}
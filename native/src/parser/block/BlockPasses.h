@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ExecuteBlock.h"
+#include "TypeChecker.h"
+
+// Every pass a parsed execute block goes through before the runtime sees it, in order:
+// DeadCodeEliminator, SlotResolver, TypeChecker, ConditionCompiler, EffectAnalyzer.
+// Each parser entry point calls this, so a new pass is added here and nowhere else.
+class BlockPasses {
+public:
+    // `parameters` are the names bound to the first slots after the fixed ones (command
+    // arguments); `environment` types the names the host provides; `label` names the
+    // block in diagnostics.
+    static void run(ExecuteBlock& block, const std::vector<std::string>& parameters,
+                    const TypeChecker::Environment& environment, const std::string& label);
+};
@@ -0,0 +1,104 @@
+#include "ColorTags.h"
+#include <cstring>
+#include <ScratchArena.h>
+#include <StringLiteral.h>
+#include <InterpolatedString.h>
+#include <Concat.h>
+
+namespace {
+    struct ColorTag {
+        const char* name;   // between the angle brackets
+        const char* code;
+    };
+
+    // Must match ColorCodes.TAGS on the Java side. Codes are spelled out as UTF-8 so
+    // the section sign survives compilers that do not read sources as UTF-8.
+    #define SECTION_SIGN "\xC2\xA7"
+    const ColorTag COLOR_TAGS[] = {
+        {"red", SECTION_SIGN "c"},
+        {"green", SECTION_SIGN "a"},
+        {"lime", SECTION_SIGN "a"},
+        {"blue", SECTION_SIGN "9"},
+        {"yellow", SECTION_SIGN "e"},
+        {"gold", SECTION_SIGN "6"},
+        {"white", SECTION_SIGN "f"},
+        {"black", SECTION_SIGN "0"},
+        {"reset", SECTION_SIGN "r"},
+    };
+    #undef SECTION_SIGN
+
+    const ColorTag* findTag(const std::string& text, size_t nameStart, size_t nameEnd) {
+        size_t length = nameEnd - nameStart;
+        for (const ColorTag& tag : COLOR_TAGS) {
+            if (std::strlen(tag.name) == length && text.compare(nameStart, length, tag.name) == 0) {
+                return &tag;
+            }
+        }
+        return nullptr;
+    }
+}
+
+std::string ColorTags::translate(const std::string& text) {
+    size_t open = text.find('<');
+    if (open == std::string::npos) {
+        return text;
+    }
+
+    std::string result;
+    result.reserve(text.size());
+    size_t copied = 0;
+
+    while (open != std::string::npos) {
+        size_t close = text.find('>', open + 1);
+        if (close == std::string::npos) {
+            break;
+        }
+
+        // "<<red>" is a stray '<' followed by a tag, so only the last '<' before the
+        // '>' can start one
+        size_t start = text.rfind('<', close);
+        if (const ColorTag* tag = findTag(text, start + 1, close)) {
+            result.append(text, copied, start - copied);
+            result += tag->code;
+            copied = close + 1;
+        }
+        open = text.find('<', close + 1);
+    }
+
+    result.append(text, copied, std::string::npos);
+    return result;
+}
+
+std::shared_ptr<Expression> ColorTags::translateMessage(const std::shared_ptr<Expression>& message) {
+    if (auto literal = dynamic_cast<const StringLiteral*>(message.get())) {
+        return ScratchArena::make<StringLiteral>(translate(literal->getValue()));
+    }
+
+    if (auto interpolated = dynamic_cast<const InterpolatedString*>(message.get())) {
+        auto translated = ScratchArena::make<InterpolatedString>();
+        for (const auto& part : interpolated->getParts()) {
+            if (auto literal = dynamic_cast<const StringLiteral*>(part.get())) {
+                std::string text = translate(literal->getValue());
+                translated->addLiteral(ScratchArena::make<StringLiteral>(text), text.size());
+            } else {
+                translated->addVariable(part);
+            }
+        }
+        return translated;
+    }
+
+    if (auto concat = dynamic_cast<const Concat*>(message.get())) {
+        auto translated = ScratchArena::make<Concat>();
+        for (const auto& part : concat->getParts()) {
+            if (auto literal = dynamic_cast<const StringLiteral*>(part.get())) {
+                std::string text = translate(literal->getValue());
+                translated->addLiteral(ScratchArena::make<StringLiteral>(text), text.size());
+            } else {
+                translated->addOperand(translateMessage(part));
+            }
+        }
+        return translated;
+    }
+
+    return message;
+}
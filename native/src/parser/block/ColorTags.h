@@ -0,0 +1,19 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "Expression.h"
+
+// Translates color tags such as <red> into Minecraft section-sign codes while the
+// script is compiled, so a send with a literal message does no text processing at
+// runtime. Tags live in one table in ColorTags.cpp; ASTExecutor's ColorCodes holds
+// the same table for values that are only known at runtime.
+class ColorTags {
+public:
+    // Replaces every known tag in one pass; unknown tags are left as they are
+    static std::string translate(const std::string& text);
+
+    // Returns the message with its literal text translated: a StringLiteral, or the
+    // literal chunks of an InterpolatedString or Concat. Other expressions are
+    // returned unchanged and translated at runtime.
+    static std::shared_ptr<Expression> translateMessage(const std::shared_ptr<Expression>& message);
+};
@@ -0,0 +1,251 @@
+#include "ConditionCompiler.h"
+#include <ScratchArena.h>
+#include <BlockStatement.h>
+#include <SwitchStatement.h>
+#include <VariableAssignment.h>
+#include <BinaryExpression.h>
+#include <StringLiteral.h>
+#include <InterpolatedString.h>
+#include <Concat.h>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    using Op = BinaryExpression::Operator;
+
+    // Identifies the value a reference reads: its slot plus property segments
+    std::string keyOf(const VariableReference& reference) {
+        std::string key = std::to_string(reference.getSlot());
+        for (const auto& segment : reference.getPath()) {
+            key += '.';
+            key += segment;
+        }
+        return key;
+    }
+
+    // Every variable reference inside an expression, walked without recursion
+    void collectReferences(Expression* expression, std::vector<VariableReference*>& out) {
+        std::vector<Expression*> pending{expression};
+        while (!pending.empty()) {
+            Expression* current = pending.back();
+            pending.pop_back();
+            if (!current) continue;
+
+            if (auto reference = dynamic_cast<VariableReference*>(current)) {
+                out.push_back(reference);
+            } else if (auto binary = dynamic_cast<BinaryExpression*>(current)) {
+                pending.push_back(binary->getRight().get());
+                pending.push_back(binary->getLeft().get());
+            } else if (auto interpolated = dynamic_cast<InterpolatedString*>(current)) {
+                for (const auto& part : interpolated->getParts()) pending.push_back(part.get());
+            } else if (auto concat = dynamic_cast<Concat*>(current)) {
+                for (const auto& part : concat->getParts()) pending.push_back(part.get());
+            }
+        }
+    }
+
+    // Matches `value = "literal"` in either order, returning the value side
+    std::shared_ptr<VariableReference> literalTest(const Expression* condition, std::string& label) {
+        auto binary = dynamic_cast<const BinaryExpression*>(condition);
+        if (!binary || (binary->getOperator() != Op::EQUALS && binary->getOperator() != Op::STRING_EQUALS)) {
+            return nullptr;
+        }
+
+        auto left = binary->getLeft();
+        auto right = binary->getRight();
+        if (dynamic_cast<const StringLiteral*>(left.get())) {
+            std::swap(left, right);
+        }
+
+        auto literal = dynamic_cast<const StringLiteral*>(right.get());
+        auto reference = std::dynamic_pointer_cast<VariableReference>(left);
+        if (!literal || !reference || reference->getSlot() < 0) {
+            return nullptr;
+        }
+        label = literal->getValue();
+        return reference;
+    }
+}
+
+void ConditionCompiler::run(ExecuteBlock& block) {
+    ConditionCompiler compiler(block.getSlotNames());
+    bool changed = false;
+    auto statements = compiler.rewriteList(block.getStatements(), changed);
+    if (changed) {
+        block.setStatements(std::move(statements));
+        block.setSlotNames(std::move(compiler.slotNames));
+    }
+}
+
+ConditionCompiler::ConditionCompiler(std::vector<std::string> slotNames) : slotNames(std::move(slotNames)) {}
+
+std::vector<std::shared_ptr<Statement>> ConditionCompiler::rewriteList(
+        const std::vector<std::shared_ptr<Statement>>& statements, bool& changed) {
+    std::vector<std::shared_ptr<Statement>> out;
+    out.reserve(statements.size());
+
+    for (const auto& statement : statements) {
+        if (auto chain = std::dynamic_pointer_cast<IfStatement>(statement)) {
+            size_t before = out.size();
+            hoist(chain, out);
+            changed |= out.size() != before;
+        }
+
+        auto rewritten = rewrite(statement);
+        changed |= rewritten != statement;
+        out.push_back(rewritten);
+    }
+
+    return out;
+}
+
+std::shared_ptr<Statement> ConditionCompiler::rewrite(const std::shared_ptr<Statement>& statement) {
+    if (auto chain = std::dynamic_pointer_cast<IfStatement>(statement)) {
+        return rewriteIfChain(chain);
+    }
+
+    if (auto block = dynamic_cast<const BlockStatement*>(statement.get())) {
+        bool changed = false;
+        auto statements = rewriteList(block->getStatements(), changed);
+        if (!changed) return statement;
+
+        auto rewritten = ScratchArena::make<BlockStatement>();
+        for (const auto& child : statements) {
+            rewritten->addStatement(child);
+        }
+        return rewritten;
+    }
+
+    return statement;
+}
+
+// Rebuilt from the back like DeadCodeEliminator does, so long chains need no recursion
+std::shared_ptr<Statement> ConditionCompiler::rewriteIfChain(const std::shared_ptr<IfStatement>& chain) {
+    struct Link {
+        std::shared_ptr<Expression> condition;
+        std::shared_ptr<Statement> thenStatement;
+        std::shared_ptr<VariableReference> subject; // set if the condition is `subject = "label"`
+        std::string label;
+        int line;
+    };
+
+    std::vector<Link> links;
+    std::shared_ptr<Statement> tail;
+    bool changed = false;
+
+    std::shared_ptr<Statement> current = chain;
+    while (current) {
+        auto link = std::dynamic_pointer_cast<IfStatement>(current);
+        if (!link) {
+            tail = rewrite(current);
+            changed |= tail != current;
+            break;
+        }
+
+        Link entry{link->getCondition(), rewrite(link->getThenStatement()), nullptr, {}, link->getLine()};
+        changed |= entry.thenStatement != link->getThenStatement();
+        entry.subject = literalTest(entry.condition.get(), entry.label);
+        links.push_back(std::move(entry));
+        current = link->getElseStatement();
+    }
+
+    // Group consecutive links that test the same value into switch runs
+    struct Segment {
+        size_t first;
+        size_t count;
+        bool isSwitch;
+    };
+    std::vector<Segment> segments;
+    for (size_t i = 0; i < links.size();) {
+        size_t end = i + 1;
+        if (links[i].subject) {
+            std::string key = keyOf(*links[i].subject);
+            while (end < links.size() && links[end].subject && keyOf(*links[end].subject) == key) {
+                end++;
+            }
+        }
+
+        if (end - i >= SWITCH_MIN_CASES) {
+            segments.push_back({i, end - i, true});
+            changed = true;
+        } else {
+            for (size_t j = i; j < end; j++) segments.push_back({j, 1, false});
+        }
+        i = end;
+    }
+
+    if (!changed) {
+        return chain;
+    }
+
+    for (auto segment = segments.rbegin(); segment != segments.rend(); ++segment) {
+        if (!segment->isSwitch) {
+            const Link& link = links[segment->first];
+            tail = ScratchArena::make<IfStatement>(link.condition, link.thenStatement, tail);
+            tail->setLine(link.line);
+            continue;
+        }
+
+        // A repeated label can never match after its first occurrence
+        std::vector<std::string> labels;
+        std::vector<std::shared_ptr<Statement>> branches;
+        std::unordered_set<std::string> seen;
+        for (size_t i = segment->first; i < segment->first + segment->count; i++) {
+            if (seen.insert(links[i].label).second) {
+                labels.push_back(links[i].label);
+                branches.push_back(links[i].thenStatement);
+            }
+        }
+        tail = ScratchArena::make<SwitchStatement>(links[segment->first].subject, std::move(labels),
+                                                   std::move(branches), tail);
+        tail->setLine(links[segment->first].line);
+    }
+    return tail;
+}
+
+void ConditionCompiler::hoist(const std::shared_ptr<IfStatement>& chain, std::vector<std::shared_ptr<Statement>>& out) {
+    std::vector<VariableReference*> references;
+    for (const Statement* current = chain.get(); current;) {
+        auto link = dynamic_cast<const IfStatement*>(current);
+        if (!link) break;
+        collectReferences(link->getCondition().get(), references);
+        current = link->getElseStatement().get();
+    }
+
+    // Only property reads are worth a temporary; a bare variable is already one slot read
+    std::unordered_map<std::string, std::vector<VariableReference*>> reads;
+    std::vector<std::string> order;
+    for (VariableReference* reference : references) {
+        if (reference->getSlot() < 0 || reference->getPath().empty()) continue;
+        auto& group = reads[keyOf(*reference)];
+        if (group.empty()) order.push_back(keyOf(*reference));
+        group.push_back(reference);
+    }
+
+    for (const auto& key : order) {
+        const auto& group = reads[key];
+        if (group.size() < 2) continue;
+
+        VariableReference* first = group.front();
+        auto read = ScratchArena::make<VariableReference>(first->getName());
+        read->bind(first->getSlot(), first->getPath());
+        read->setStaticType(first->getStaticType());
+
+        int temporary = newTemporary();
+        auto assignment = ScratchArena::make<VariableAssignment>(slotNames[temporary], read);
+        assignment->bind(temporary, {});
+        assignment->setLine(chain->getLine());
+        out.push_back(assignment);
+
+        for (VariableReference* reference : group) {
+            reference->bind(temporary, {});
+        }
+    }
+}
+
+int ConditionCompiler::newTemporary() {
+    // '$' cannot start an identifier, so no script variable shares the name
+    int slot = static_cast<int>(slotNames.size());
+    slotNames.push_back("$" + std::to_string(slot));
+    return slot;
+}
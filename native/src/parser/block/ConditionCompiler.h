@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ExecuteBlock.h"
+#include "Statement.h"
+#include "Expression.h"
+#include "IfStatement.h"
+#include "VariableReference.h"
+
+// Rewrites the conditions of if/else-if chains once slots and types are known:
+//   - property reads that appear more than once in a chain's conditions, such as
+//     `event.message` in a moderation filter, are read once into a temporary slot
+//     just before the chain
+//   - a run of SWITCH_MIN_CASES or more links that each compare the same value with a
+//     string literal becomes a SwitchStatement, a table lookup instead of a test per
+//     link
+// Conditions in a chain run back to back with no statement in between, so reading a
+// property early gives the value every test would have seen.
+class ConditionCompiler {
+public:
+    static constexpr size_t SWITCH_MIN_CASES = 3;
+
+    static void run(ExecuteBlock& block);
+
+private:
+    explicit ConditionCompiler(std::vector<std::string> slotNames);
+
+    std::vector<std::string> slotNames;
+
+    std::vector<std::shared_ptr<Statement>> rewriteList(const std::vector<std::shared_ptr<Statement>>& statements,
+                                                        bool& changed);
+    std::shared_ptr<Statement> rewrite(const std::shared_ptr<Statement>& statement);
+    std::shared_ptr<Statement> rewriteIfChain(const std::shared_ptr<IfStatement>& chain);
+
+    void hoist(const std::shared_ptr<IfStatement>& chain, std::vector<std::shared_ptr<Statement>>& out);
+    int newTemporary();
+};
@@ -0,0 +1,153 @@
+#include "ConstantFolder.h"
+#include <algorithm>
+#include <string>
+#include <ScratchArena.h>
+#include <StringLiteral.h>
+#include <BooleanLiteral.h>
+#include <TypeLiteral.h>
+#include <Concat.h>
+
+namespace {
+    struct Constant {
+        bool isBoolean;
+        bool flag;
+        std::string text;   // display text - the value for strings, "true"/"false" for booleans
+    };
+
+    bool constantOf(const Expression* expression, Constant& out) {
+        if (auto literal = dynamic_cast<const StringLiteral*>(expression)) {
+            out = {false, false, literal->getValue()};
+            return true;
+        }
+        if (auto literal = dynamic_cast<const BooleanLiteral*>(expression)) {
+            out = {true, literal->getValue(), literal->getValue() ? "true" : "false"};
+            return true;
+        }
+        return false;
+    }
+
+    bool isAscii(const std::string& text) {
+        return std::all_of(text.begin(), text.end(), [](char c) { return (c & 0x80) == 0; });
+    }
+
+    std::string asciiLower(std::string text) {
+        for (char& c : text) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        return text;
+    }
+
+    bool truthy(const Constant& constant) {
+        return constant.isBoolean ? constant.flag : !constant.text.empty();
+    }
+
+    // Evaluates `left op right` for two constants; false if the result must be left
+    // to the runtime
+    bool evaluate(const Constant& left, BinaryExpression::Operator op, const Constant& right, bool& result) {
+        using Op = BinaryExpression::Operator;
+        switch (op) {
+            case Op::EQUALS:
+            case Op::NOT_EQUALS: {
+                bool equal = left.isBoolean == right.isBoolean && left.text == right.text;
+                result = op == Op::EQUALS ? equal : !equal;
+                return true;
+            }
+            case Op::LESS_THAN:
+            case Op::GREATER_THAN:
+            case Op::LESS_EQUALS:
+            case Op::GREATER_EQUALS: {
+                // Booleans do not compare at runtime, they raise an error there
+                if (left.isBoolean || right.isBoolean || !isAscii(left.text) || !isAscii(right.text)) {
+                    return false;
+                }
+                int order = left.text.compare(right.text);
+                result = op == Op::LESS_THAN ? order < 0
+                       : op == Op::GREATER_THAN ? order > 0
+                       : op == Op::LESS_EQUALS ? order <= 0
+                       : order >= 0;
+                return true;
+            }
+            case Op::AND:
+                result = truthy(left) && truthy(right);
+                return true;
+            case Op::OR:
+                result = truthy(left) || truthy(right);
+                return true;
+            case Op::CONTAINS:
+                if (!isAscii(left.text) || !isAscii(right.text)) {
+                    return false;
+                }
+                result = asciiLower(left.text).find(asciiLower(right.text)) != std::string::npos;
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+std::shared_ptr<Expression> ConstantFolder::binary(std::shared_ptr<Expression> left, BinaryExpression::Operator op,
+                                                   std::shared_ptr<Expression> right) {
+    if (op == BinaryExpression::Operator::CONCATENATE) {
+        return concat({left, right});
+    }
+
+    Constant leftValue;
+    if (constantOf(left.get(), leftValue)) {
+        bool result;
+        Constant rightValue;
+
+        if (op == BinaryExpression::Operator::IS_TYPE || op == BinaryExpression::Operator::IS_NOT_TYPE) {
+            if (auto type = dynamic_cast<const TypeLiteral*>(right.get())) {
+                bool matches = type->getTypeName() == (leftValue.isBoolean ? "Boolean" : "String");
+                return ScratchArena::make<BooleanLiteral>(op == BinaryExpression::Operator::IS_TYPE ? matches : !matches);
+            }
+        } else if (constantOf(right.get(), rightValue) && evaluate(leftValue, op, rightValue, result)) {
+            return ScratchArena::make<BooleanLiteral>(result);
+        }
+    }
+
+    return ScratchArena::make<BinaryExpression>(left, op, right);
+}
+
+std::shared_ptr<Expression> ConstantFolder::concat(const std::vector<std::shared_ptr<Expression>>& operands) {
+    auto result = ScratchArena::make<Concat>();
+    std::string pending;
+    bool hasPending = false;
+    size_t nonConstant = 0;
+
+    auto flush = [&]() {
+        if (hasPending) {
+            result->addLiteral(ScratchArena::make<StringLiteral>(pending), pending.size());
+            pending.clear();
+            hasPending = false;
+        }
+    };
+    auto append = [&](const std::shared_ptr<Expression>& operand) {
+        Constant value;
+        if (constantOf(operand.get(), value)) {
+            pending += value.text;
+            hasPending = true;
+        } else {
+            flush();
+            result->addOperand(operand);
+            nonConstant++;
+        }
+    };
+
+    for (const auto& operand : operands) {
+        // A parenthesised chain joins the outer one; string concatenation is associative
+        if (auto nested = dynamic_cast<const Concat*>(operand.get())) {
+            for (const auto& part : nested->getParts()) {
+                append(part);
+            }
+        } else {
+            append(operand);
+        }
+    }
+
+    if (nonConstant == 0) {
+        return ScratchArena::make<StringLiteral>(pending);
+    }
+    flush();
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "Expression.h"
+#include "BinaryExpression.h"
+
+// Builds expression nodes for ExecuteBlockParser, evaluating whatever the runtime
+// would compute the same way on every run. AST nodes are immutable once built, so
+// folding happens as each operator is parsed rather than in a rewrite afterwards;
+// the parser's loops already hold every operand of a chain.
+//
+// Only results that are certain to match ASTExecutor are folded. Relational
+// comparisons and `contains` on non-ASCII text, for example, are left to the runtime
+// because Java compares UTF-16 and lowercases by locale.
+class ConstantFolder {
+public:
+    // A BooleanLiteral if both operands are constant, otherwise a BinaryExpression
+    static std::shared_ptr<Expression> binary(std::shared_ptr<Expression> left, BinaryExpression::Operator op,
+                                              std::shared_ptr<Expression> right);
+
+    // One Concat node for a whole '+' chain with adjacent constants merged, or a
+    // StringLiteral if every operand is constant
+    static std::shared_ptr<Expression> concat(const std::vector<std::shared_ptr<Expression>>& operands);
+};
@@ -0,0 +1,148 @@
+#include "DeadCodeEliminator.h"
+#include <Diagnostics.h>
+#include <PostOrder.h>
+#include <ScratchArena.h>
+#include <BlockStatement.h>
+#include <HaltCommand.h>
+#include <BooleanLiteral.h>
+
+void DeadCodeEliminator::run(ExecuteBlock& block, const std::string& label) {
+    DeadCodeEliminator eliminator;
+    bool changed = false;
+    auto statements = eliminator.pruneList(block.getStatements(), changed);
+    if (changed) {
+        block.setStatements(std::move(statements));
+    }
+
+    bool canHalt = false;
+    for (const FlatNode& flat : PostOrder::flatten(block).nodes) {
+        if (flat.kind == NodeKind::HALT) {
+            canHalt = true;
+            break;
+        }
+    }
+    block.setCanHalt(canHalt);
+
+    if (eliminator.removedStatements > 0 || eliminator.foldedBranches > 0) {
+        Diagnostics::note(label + ": removed " + std::to_string(eliminator.removedStatements) +
+                          " unreachable statement(s), folded " + std::to_string(eliminator.foldedBranches) +
+                          " constant branch(es)");
+    }
+}
+
+std::vector<std::shared_ptr<Statement>> DeadCodeEliminator::pruneList(
+        const std::vector<std::shared_ptr<Statement>>& statements, bool& changed) {
+    std::vector<std::shared_ptr<Statement>> kept;
+    kept.reserve(statements.size());
+
+    for (size_t i = 0; i < statements.size(); i++) {
+        auto statement = prune(statements[i]);
+        changed |= statement != statements[i];
+        if (!statement) continue;
+
+        kept.push_back(statement);
+        if (alwaysHalts(statement.get()) && i + 1 < statements.size()) {
+            removedStatements += statements.size() - i - 1;
+            changed = true;
+            break;
+        }
+    }
+
+    return kept;
+}
+
+std::shared_ptr<Statement> DeadCodeEliminator::prune(const std::shared_ptr<Statement>& statement) {
+    if (auto chain = std::dynamic_pointer_cast<IfStatement>(statement)) {
+        return pruneIfChain(chain);
+    }
+
+    if (auto block = dynamic_cast<const BlockStatement*>(statement.get())) {
+        bool changed = false;
+        auto statements = pruneList(block->getStatements(), changed);
+        if (!changed) return statement;
+
+        auto pruned = ScratchArena::make<BlockStatement>();
+        for (const auto& kept : statements) {
+            pruned->addStatement(kept);
+        }
+        return pruned;
+    }
+
+    return statement;
+}
+
+// Else-if chains can be thousands of links long, so they are walked in a loop and
+// rebuilt from the back rather than pruned recursively
+std::shared_ptr<Statement> DeadCodeEliminator::pruneIfChain(const std::shared_ptr<IfStatement>& chain) {
+    struct Link {
+        std::shared_ptr<Expression> condition;
+        std::shared_ptr<Statement> thenStatement;
+        int line;
+    };
+
+    std::vector<Link> links;
+    std::shared_ptr<Statement> tail;
+    std::shared_ptr<Statement> current = chain;
+    bool changed = false;
+
+    while (current) {
+        auto link = std::dynamic_pointer_cast<IfStatement>(current);
+        if (!link) {
+            tail = prune(current);
+            changed |= tail != current;
+            break;
+        }
+
+        auto constant = dynamic_cast<const BooleanLiteral*>(link->getCondition().get());
+        if (constant) {
+            foldedBranches++;
+            changed = true;
+            if (constant->getValue()) {
+                // Taken unconditionally - everything after it in the chain is dead
+                if (link->getElseStatement()) removedStatements++;
+                tail = prune(link->getThenStatement());
+                break;
+            }
+            removedStatements++;
+            current = link->getElseStatement();
+            continue;
+        }
+
+        auto thenStatement = prune(link->getThenStatement());
+        changed |= thenStatement != link->getThenStatement();
+        links.push_back({link->getCondition(), thenStatement, link->getLine()});
+        current = link->getElseStatement();
+    }
+
+    if (!changed) {
+        return chain;
+    }
+
+    for (auto it = links.rbegin(); it != links.rend(); ++it) {
+        tail = ScratchArena::make<IfStatement>(it->condition, it->thenStatement, tail);
+        tail->setLine(it->line);
+    }
+    return tail;
+}
+
+bool DeadCodeEliminator::alwaysHalts(const Statement* statement) {
+    // An if halts only if every branch does, including a final else
+    while (auto link = dynamic_cast<const IfStatement*>(statement)) {
+        if (!alwaysHalts(link->getThenStatement().get())) {
+            return false;
+        }
+        statement = link->getElseStatement().get();
+    }
+
+    if (dynamic_cast<const HaltCommand*>(statement)) {
+        return true;
+    }
+
+    if (auto block = dynamic_cast<const BlockStatement*>(statement)) {
+        for (const auto& child : block->getStatements()) {
+            if (alwaysHalts(child.get())) return true;
+        }
+    }
+
+    return false;
+}
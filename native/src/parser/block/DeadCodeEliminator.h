@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ExecuteBlock.h"
+#include "Statement.h"
+#include "IfStatement.h"
+
+// Control-flow cleanup run on a parsed execute block before slots are bound:
+//   - statements after one that always halts are dropped
+//   - `if` on a condition ConstantFolder already decided keeps only the branch taken
+//   - the block records whether any halt is left, so the runtime can skip its
+//     halted checks for handlers that never halt
+// What was removed is reported through Diagnostics under the given label.
+class DeadCodeEliminator {
+public:
+    static void run(ExecuteBlock& block, const std::string& label);
+
+private:
+    size_t removedStatements = 0;
+    size_t foldedBranches = 0;
+
+    std::vector<std::shared_ptr<Statement>> pruneList(const std::vector<std::shared_ptr<Statement>>& statements,
+                                                      bool& changed);
+    std::shared_ptr<Statement> prune(const std::shared_ptr<Statement>& statement);
+    std::shared_ptr<Statement> pruneIfChain(const std::shared_ptr<IfStatement>& chain);
+
+    static bool alwaysHalts(const Statement* statement);
+};
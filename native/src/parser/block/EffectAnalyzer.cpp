@@ -0,0 +1,43 @@
+#include "EffectAnalyzer.h"
+#include <SlotResolver.h>
+#include <VariableReference.h>
+#include <VariableAssignment.h>
+
+void EffectAnalyzer::run(ExecuteBlock& block) {
+    int32_t effects = PURE;
+    for (const FlatNode& flat : PostOrder::flatten(block).nodes) {
+        effects |= effectsOf(flat);
+    }
+    block.setEffects(effects);
+}
+
+int32_t EffectAnalyzer::effectsOf(const FlatNode& node) {
+    switch (node.kind) {
+        case NodeKind::SEND:
+            return SENDS;
+        case NodeKind::TELEPORT:
+            return TELEPORTS;
+        case NodeKind::CANCEL_EVENT:
+            return CANCELS;
+        case NodeKind::EVENT_ACCESS:
+            return READS_STATE;
+        case NodeKind::VARIABLE_REFERENCE: {
+            // Reading a slot itself is local; following a path asks the host
+            auto reference = static_cast<const VariableReference*>(node.node);
+            return reference->getPath().empty() ? PURE : READS_STATE;
+        }
+        case NodeKind::ASSIGN: {
+            auto assignment = static_cast<const VariableAssignment*>(node.node);
+            const auto& path = assignment->getPath();
+            if (path.empty()) {
+                return PURE;
+            }
+            // Segments before the last are read to find the object that is written
+            int32_t reads = path.size() > 1 ? READS_STATE : PURE;
+            bool ownsProperty = assignment->getSlot() == SlotResolver::EVENT_SLOT && path.size() == 1;
+            return reads | (ownsProperty ? WRITES_EVENT : WRITES_STATE);
+        }
+        default:
+            return PURE;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include "ExecuteBlock.h"
+#include "PostOrder.h"
+
+// Classifies what an execute block can do outside its own frame, once slots are bound,
+// so the runtime can tell handlers that only look from handlers that change something:
+//   READS_STATE    reads a property of a host object ("event.player.name", EventAccess)
+//   SENDS          sends a message
+//   WRITES_EVENT   assigns a property of the event ("set event.message")
+//   WRITES_STATE   assigns a property of any other object
+//   CANCELS        cancels the event
+//   TELEPORTS      teleports an entity
+// A node with none of these is PURE: literals, operators, locals and control flow. A
+// statement has the effects of the nodes it contains, and the block those of all of its
+// statements; what dead-code elimination removed is not counted.
+class EffectAnalyzer {
+public:
+    enum Effect : int32_t {
+        PURE = 0,
+        READS_STATE = 1,
+        SENDS = 2,
+        WRITES_EVENT = 4,
+        WRITES_STATE = 8,
+        CANCELS = 16,
+        TELEPORTS = 32
+    };
+
+    // A handler with none of these only observes the world
+    static constexpr int32_t MUTATES = WRITES_EVENT | WRITES_STATE | CANCELS | TELEPORTS;
+
+    static void run(ExecuteBlock& block);
+
+    static int32_t effectsOf(const FlatNode& node);
+};
@@ -1,5 +1,8 @@
 #include "ExecuteBlockParser.h"
 #include <stdexcept>
+#include <ScratchArena.h>
+#include "ConstantFolder.h"
+#include "ColorTags.h"
 #include <HaltCommand.h>
 #include <iostream>
 #include <IfStatement.h>
@@ -7,6 +10,7 @@
 #include <VariableAssignment.h>
 #include <TypeLiteral.h>
 #include <StringLiteral.h>
+#include <InterpolatedString.h>
 #include <VariableReference.h>
 #include <BlockStatement.h>
 #include <TeleportCommand.h>
@@ -63,7 +67,7 @@ void ExecuteBlockParser::skipWhitespace() {
 }
 
 std::shared_ptr<ExecuteBlock> ExecuteBlockParser::parseExecuteBlock() {
-    auto block = std::make_shared<ExecuteBlock>();
+    auto block = ScratchArena::make<ExecuteBlock>();
     
     skipWhitespace();
     
@@ -85,13 +89,23 @@ std::shared_ptr<ExecuteBlock> ExecuteBlockParser::parseExecuteBlock() {
 
 std::shared_ptr<Statement> ExecuteBlockParser::parseStatement() {
     skipWhitespace();
+    int line = peek().line;
+    
+    auto statement = parseStatementBody();
+    if (statement) {
+        statement->setLine(line);
+    }
+    return statement;
+}
+
+std::shared_ptr<Statement> ExecuteBlockParser::parseStatementBody() {
     
     // Handle cancel event statement - simplify to a CancelEventStatement (no special logic)
     if (match(TokenType::CANCEL) || (match(TokenType::IDENTIFIER) && tokens[current - 1].value == "cancel")) {
         skipWhitespace();
         if (match(TokenType::EVENT) || (match(TokenType::IDENTIFIER) && tokens[current - 1].value == "event")) {
             skipWhitespace();
-            return std::make_shared<CancelEventStatement>();
+            return ScratchArena::make<CancelEventStatement>();
         }
         throw std::runtime_error("Expected 'event' after 'cancel'");
     }
@@ -155,7 +169,7 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseStatement() {
         
         skipWhitespace();
         
-        return std::make_shared<VariableAssignment>(variablePath, value);
+        return ScratchArena::make<VariableAssignment>(variablePath, value);
     }
     
     // Existing if statement
@@ -176,7 +190,7 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseStatement() {
     // Existing halt command
     if (match(TokenType::HALT)) {
         skipWhitespace();
-        return std::make_shared<HaltCommand>();
+        return ScratchArena::make<HaltCommand>();
     }
     
     // Existing block statement
@@ -194,39 +208,55 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseStatement() {
 }
 
 std::shared_ptr<Statement> ExecuteBlockParser::parseIfStatement() {
-    skipWhitespace();
-    
-    auto condition = parseExpression();
-    
-    skipWhitespace();
-    consume(TokenType::LEFT_BRACE, "Expected '{' after if condition");
-    
-    auto thenStatement = parseBlockStatement();
-    
+    // An else-if chain is read in a loop rather than by recursing once per link, so
+    // long chains cannot exhaust the native stack
+    std::vector<std::pair<std::shared_ptr<Expression>, std::shared_ptr<Statement>>> branches;
+    std::vector<int> lines; // The first link's line is set by parseStatement
     std::shared_ptr<Statement> elseStatement = nullptr;
     
-    skipWhitespace();
-    if (match(TokenType::ELSE)) {
+    while (true) {
+        lines.push_back(tokens[current - 1].line); // the `if` just matched
+        skipWhitespace();
+        
+        auto condition = parseExpression();
+        
+        skipWhitespace();
+        consume(TokenType::LEFT_BRACE, "Expected '{' after if condition");
+        
+        branches.emplace_back(condition, parseBlockStatement());
+        
+        skipWhitespace();
+        if (!match(TokenType::ELSE)) {
+            break;
+        }
+        
         skipWhitespace();
         
         if (match(TokenType::IF)) {
             // else if
-            elseStatement = parseIfStatement();
+            continue;
         } else if (match(TokenType::LEFT_BRACE)) {
             // else block
             elseStatement = parseBlockStatement();
+            break;
         } else {
             throw std::runtime_error("Expected '{' or 'if' after 'else'");
         }
     }
     
-    return std::make_shared<IfStatement>(condition, thenStatement, elseStatement);
+    // Link the chain from the last branch back to the first
+    for (size_t i = branches.size(); i-- > 0;) {
+        elseStatement = ScratchArena::make<IfStatement>(branches[i].first, branches[i].second, elseStatement);
+        elseStatement->setLine(lines[i]);
+    }
+    return elseStatement;
 }
 
 std::shared_ptr<Statement> ExecuteBlockParser::parseSendCommand() {
     skipWhitespace();
     
-    auto message = parseExpression();
+    // Color tags in the message's literal text are translated now rather than per send
+    auto message = ColorTags::translateMessage(parseExpression());
     
     std::shared_ptr<Expression> target = nullptr;
     
@@ -238,7 +268,7 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseSendCommand() {
     
     skipWhitespace();
     
-    return std::make_shared<SendCommand>(message, target);
+    return ScratchArena::make<SendCommand>(message, target);
 }
 
 std::shared_ptr<Statement> ExecuteBlockParser::parseTeleportCommand() {
@@ -254,7 +284,7 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseTeleportCommand() {
     
     skipWhitespace();
     
-    return std::make_shared<TeleportCommand>(entity, target);
+    return ScratchArena::make<TeleportCommand>(entity, target);
 }
 
 std::shared_ptr<Statement> ExecuteBlockParser::parseVariableAssignment() {
@@ -268,11 +298,16 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseVariableAssignment() {
     
     skipWhitespace();
     
-    return std::make_shared<VariableAssignment>(name.value, value);
+    return ScratchArena::make<VariableAssignment>(name.value, value);
 }
 
 std::shared_ptr<Statement> ExecuteBlockParser::parseBlockStatement() {
-    auto block = std::make_shared<BlockStatement>();
+    if (blockDepth >= MAX_BLOCK_DEPTH) {
+        throw std::runtime_error("Blocks nested more than " + std::to_string(MAX_BLOCK_DEPTH) + " deep");
+    }
+    blockDepth++;
+    
+    auto block = ScratchArena::make<BlockStatement>();
     
     while (!isAtEnd() && !check(TokenType::RIGHT_BRACE)) {
         skipWhitespace();
@@ -289,6 +324,7 @@ std::shared_ptr<Statement> ExecuteBlockParser::parseBlockStatement() {
     
     consume(TokenType::RIGHT_BRACE, "Expected '}' to close block");
     
+    blockDepth--;
     return block;
 }
 
@@ -302,7 +338,7 @@ std::shared_ptr<Expression> ExecuteBlockParser::parseLogicalOr() {
     while (match(TokenType::OR)) {
         skipWhitespace();
         auto right = parseLogicalAnd();
-        expr = std::make_shared<BinaryExpression>(expr, BinaryExpression::Operator::OR, right);
+        expr = ConstantFolder::binary(expr, BinaryExpression::Operator::OR, right);
     }
     
     return expr;
@@ -314,7 +350,7 @@ std::shared_ptr<Expression> ExecuteBlockParser::parseLogicalAnd() {
     while (match(TokenType::AND)) {
         skipWhitespace();
         auto right = parseComparison();
-        expr = std::make_shared<BinaryExpression>(expr, BinaryExpression::Operator::AND, right);
+        expr = ConstantFolder::binary(expr, BinaryExpression::Operator::AND, right);
     }
     
     return expr;
@@ -344,7 +380,7 @@ std::shared_ptr<Expression> ExecuteBlockParser::parseComparison() {
         
         skipWhitespace();
         auto right = parseAdditive();
-        expr = std::make_shared<BinaryExpression>(expr, op, right);
+        expr = ConstantFolder::binary(expr, op, right);
     }
     
     return expr;
@@ -352,14 +388,19 @@ std::shared_ptr<Expression> ExecuteBlockParser::parseComparison() {
 
 std::shared_ptr<Expression> ExecuteBlockParser::parseAdditive() {
     auto expr = parseContainsExpression();
+    if (!check(TokenType::PLUS)) {
+        return expr;
+    }
     
+    // Collect the whole chain so it becomes one Concat node rather than a nested
+    // BinaryExpression per '+'
+    std::vector<std::shared_ptr<Expression>> operands{expr};
     while (match(TokenType::PLUS)) {
         skipWhitespace();
-        auto right = parseContainsExpression();
-        expr = std::make_shared<BinaryExpression>(expr, BinaryExpression::Operator::CONCATENATE, right);
+        operands.push_back(parseContainsExpression());
     }
     
-    return expr;
+    return ConstantFolder::concat(operands);
 }
 
 std::shared_ptr<Expression> ExecuteBlockParser::parseContainsExpression() {
@@ -369,7 +410,7 @@ std::shared_ptr<Expression> ExecuteBlockParser::parseContainsExpression() {
     if (match(TokenType::CONTAINS)) {
         skipWhitespace();
         auto right = parsePrimary();
-        expr = std::make_shared<BinaryExpression>(expr, BinaryExpression::Operator::CONTAINS, right);
+        expr = ConstantFolder::binary(expr, BinaryExpression::Operator::CONTAINS, right);
     }
     
     return expr;
@@ -396,10 +437,10 @@ std::shared_ptr<Expression> ExecuteBlockParser::parseIsExpression() {
         skipWhitespace();
         Token typeName = consume(TokenType::IDENTIFIER, "Expected type name after 'is a'");
         
-        auto typeLiteral = std::make_shared<TypeLiteral>(typeName.value);
+        auto typeLiteral = ScratchArena::make<TypeLiteral>(typeName.value);
         
         auto op = isNot ? BinaryExpression::Operator::IS_NOT_TYPE : BinaryExpression::Operator::IS_TYPE;
-        expr = std::make_shared<BinaryExpression>(expr, op, typeLiteral);
+        expr = ConstantFolder::binary(expr, op, typeLiteral);
     }
     
     return expr;
@@ -409,7 +450,7 @@ std::shared_ptr<Expression> ExecuteBlockParser::parsePrimary() {
     skipWhitespace();
     
     if (match(TokenType::STRING_LITERAL)) {
-        return std::make_shared<StringLiteral>(tokens[current - 1].value);
+        return parseStringLiteral(tokens[current - 1].value);
     }
     
     if (match(TokenType::IDENTIFIER) || 
@@ -438,33 +479,15 @@ std::shared_ptr<Expression> ExecuteBlockParser::parsePrimary() {
                 
                 // If parsePropertyPath extracted a full path with at least one dot
                 if (!lastComponent.empty()) {
-                    return std::make_shared<VariableReference>(basePath + "." + lastComponent);
+                    return ScratchArena::make<VariableReference>(basePath + "." + lastComponent);
                 } else {
                     // Just a simple identifier
-                    return std::make_shared<VariableReference>(basePath);
+                    return ScratchArena::make<VariableReference>(basePath);
                 }
             }
             
-            // Handle string interpolation (e.g., ${variable})
-            if (identifier == "$" && match(TokenType::LEFT_BRACE)) {
-                // Save starting position for error reporting
-                size_t interpolationStart = current - 2;
-                
-                // Parse the variable reference inside the braces
-                auto [basePath, lastComponent] = parsePropertyPath();
-                std::string fullPath = lastComponent.empty() ? basePath : basePath + "." + lastComponent;
-                
-                if (!match(TokenType::RIGHT_BRACE)) {
-                    throw std::runtime_error("Expected '}' after variable name in interpolation at line " + 
-                                           std::to_string(tokens[interpolationStart].line) + 
-                                           ", column " + std::to_string(tokens[interpolationStart].column));
-                }
-                
-                return std::make_shared<VariableReference>(fullPath);
-            }
-            
             // Just a simple identifier
-            return std::make_shared<VariableReference>(identifier);
+            return ScratchArena::make<VariableReference>(identifier);
         }
         
         if (match(TokenType::LEFT_PAREN)) {
@@ -477,6 +500,51 @@ std::shared_ptr<Expression> ExecuteBlockParser::parsePrimary() {
                                ", column " + std::to_string(peek().column));
     }
 
+// The lexer keeps ${...} inside the string token, so interpolation is split out here.
+// An unterminated ${ is left as literal text.
+std::shared_ptr<Expression> ExecuteBlockParser::parseStringLiteral(const std::string& text) {
+    size_t open = text.find("${");
+    if (open == std::string::npos) {
+        return ScratchArena::make<StringLiteral>(text);
+    }
+    
+    auto interpolated = ScratchArena::make<InterpolatedString>();
+    std::string literalText;
+    bool hasVariables = false;
+    size_t start = 0;
+    
+    auto addLiteral = [&](size_t from, size_t to) {
+        if (to > from) {
+            std::string chunk = text.substr(from, to - from);
+            literalText += chunk;
+            interpolated->addLiteral(ScratchArena::make<StringLiteral>(chunk), chunk.size());
+        }
+    };
+    
+    while (open != std::string::npos) {
+        size_t close = text.find('}', open + 2);
+        if (close == std::string::npos) {
+            break;
+        }
+        
+        addLiteral(start, open);
+        std::string path = text.substr(open + 2, close - open - 2);
+        if (!path.empty()) {
+            interpolated->addVariable(ScratchArena::make<VariableReference>(path));
+            hasVariables = true;
+        }
+        
+        start = close + 1;
+        open = text.find("${", start);
+    }
+    addLiteral(start, text.size());
+    
+    if (!hasVariables) {
+        return ScratchArena::make<StringLiteral>(literalText);
+    }
+    return interpolated;
+}
+
 // Helper method to extract object and property path for property assignments
 std::pair<std::string, std::string> ExecuteBlockParser::parsePropertyPath() {
     // The first component can be ANY token that could be an identifier
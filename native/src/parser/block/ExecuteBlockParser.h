@@ -9,8 +9,9 @@
 
 class ExecuteBlockParser {
 private:
-    std::vector<Token> tokens;
+    const std::vector<Token>& tokens;
     size_t current = 0;
+    size_t blockDepth = 0;
     
     Token peek() const;
     Token advance();
@@ -22,6 +23,7 @@ private:
     
     // Statement parsing methods
     std::shared_ptr<Statement> parseStatement();
+    std::shared_ptr<Statement> parseStatementBody();
     std::shared_ptr<Statement> parseIfStatement();
     std::shared_ptr<Statement> parseSendCommand();
     std::shared_ptr<Statement> parseTeleportCommand();
@@ -37,9 +39,14 @@ private:
     std::shared_ptr<Expression> parseContainsExpression();
     std::shared_ptr<Expression> parseIsExpression();
     std::shared_ptr<Expression> parsePrimary();
+    std::shared_ptr<Expression> parseStringLiteral(const std::string& text);
     std::pair<std::string, std::string> parsePropertyPath();
 
 public:
+    // Statement blocks are parsed recursively, so nesting is capped well below what
+    // the native stack of a JVM thread can hold
+    static constexpr size_t MAX_BLOCK_DEPTH = 256;
+
     ExecuteBlockParser(const std::vector<Token>& tokens);
     std::shared_ptr<ExecuteBlock> parseExecuteBlock();
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "SlotResolver.h"
+#include <PostOrder.h>
+#include <VariableReference.h>
+#include <VariableAssignment.h>
+#include <EventAccessExpression.h>
+#include <algorithm>
+
+void SlotResolver::resolve(ExecuteBlock& block, const std::vector<std::string>& parameters) {
+    SlotResolver resolver;
+    resolver.slotFor("sender");
+    resolver.slotFor("event");
+    for (const auto& parameter : parameters) {
+        resolver.slotFor(parameter);
+        resolver.argsDeclared |= parameter == "args";
+    }
+
+    // The flattened tree only hands out const nodes; binding is the one place that
+    // writes to a freshly parsed tree, which nothing else has seen yet
+    FlatTree tree = PostOrder::flatten(block);
+    for (const FlatNode& flat : tree.nodes) {
+        if (flat.kind == NodeKind::VARIABLE_REFERENCE) {
+            auto reference = const_cast<VariableReference*>(static_cast<const VariableReference*>(flat.node));
+            auto binding = resolver.bindPath(reference->getName());
+            if (binding.first == EVENT_SLOT && !binding.second.empty()) {
+                noteProperty(resolver.eventReads, binding.second.front());
+            }
+            reference->bind(binding.first, std::move(binding.second));
+        } else if (flat.kind == NodeKind::ASSIGN) {
+            auto assignment = const_cast<VariableAssignment*>(static_cast<const VariableAssignment*>(flat.node));
+            auto binding = resolver.bindPath(assignment->getVariableName());
+            if (binding.first == EVENT_SLOT && !binding.second.empty()) {
+                // Only a one-segment path stores into the event; longer ones read through it
+                noteProperty(binding.second.size() == 1 ? resolver.eventWrites : resolver.eventReads,
+                             binding.second.front());
+            }
+            assignment->bind(binding.first, std::move(binding.second));
+        } else if (flat.kind == NodeKind::EVENT_ACCESS) {
+            noteProperty(resolver.eventReads, static_cast<const EventAccessExpression*>(flat.node)->getProperty());
+        }
+    }
+
+    block.setSlotNames(std::move(resolver.slotNames));
+    block.setEventAccesses(std::move(resolver.eventReads), std::move(resolver.eventWrites));
+}
+
+void SlotResolver::noteProperty(std::vector<std::string>& properties, const std::string& property) {
+    if (std::find(properties.begin(), properties.end(), property) == properties.end()) {
+        properties.push_back(property);
+    }
+}
+
+int SlotResolver::slotFor(const std::string& name) {
+    auto it = slotIndex.find(name);
+    if (it != slotIndex.end()) {
+        return it->second;
+    }
+
+    int slot = static_cast<int>(slotNames.size());
+    slotNames.push_back(name);
+    slotIndex.emplace(name, slot);
+    return slot;
+}
+
+std::pair<int, std::vector<std::string>> SlotResolver::bindPath(const std::string& path) {
+    std::vector<std::string> segments;
+    size_t start = 0;
+    for (;;) {
+        size_t dot = path.find('.', start);
+        segments.push_back(path.substr(start, dot - start));
+        if (dot == std::string::npos) break;
+        start = dot + 1;
+    }
+
+    // "args.player" names the argument itself unless a command really declares "args"
+    if (segments.size() > 1 && segments.front() == "args" && !argsDeclared) {
+        segments.erase(segments.begin());
+    }
+
+    int slot = slotFor(segments.front());
+    segments.erase(segments.begin());
+    return {slot, std::move(segments)};
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ExecuteBlock.h"
+
+// Runs over an execute block once ExecuteBlockParser is done and binds every variable
+// reference and assignment to a slot in the frame the runtime builds for each run.
+// Reading "args.player" or "event.player.name" then costs an array index plus a walk
+// over pre-split segments instead of a split and a map lookup per evaluation.
+//
+// Frame layout:
+//   SENDER_SLOT, EVENT_SLOT       always present, even if the block never uses them
+//   parameters                    command arguments, in declaration order
+//   everything else               `set` locals and host-provided names such as an
+//                                 event's "player", in order of first use
+//
+// The layout is stored on the block as a list of slot names; the runtime fills each
+// slot from its variables by that name when it starts executing the block.
+//
+// Alongside, the first segment of every path on the event slot is recorded as an event
+// property the block reads or writes ("set event.message" writes message, "event.player
+// .name" reads player). Together with the slot names this is everything a handler can
+// take from its host, so an event wrapper only has to provide those.
+class SlotResolver {
+public:
+    static constexpr int SENDER_SLOT = 0;
+    static constexpr int EVENT_SLOT = 1;
+
+    static void resolve(ExecuteBlock& block, const std::vector<std::string>& parameters);
+
+private:
+    std::vector<std::string> slotNames;
+    std::unordered_map<std::string, int> slotIndex;
+    std::vector<std::string> eventReads;
+    std::vector<std::string> eventWrites;
+    bool argsDeclared = false;
+
+    int slotFor(const std::string& name);
+    std::pair<int, std::vector<std::string>> bindPath(const std::string& path);
+    static void noteProperty(std::vector<std::string>& properties, const std::string& property);
+};
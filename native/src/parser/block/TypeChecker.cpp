@@ -0,0 +1,238 @@
+#include "TypeChecker.h"
+#include <Diagnostics.h>
+#include <PostOrder.h>
+#include <SlotResolver.h>
+#include <VariableReference.h>
+#include <VariableAssignment.h>
+#include <EventAccessExpression.h>
+#include <TypeLiteral.h>
+#include <stdexcept>
+
+namespace {
+    using Op = BinaryExpression::Operator;
+
+    // What each event wrapper on the Java side (net.swofty.event.events) puts into the
+    // frame and exposes as getters on `event`
+    const std::unordered_map<std::string, TypeChecker::Environment> EVENT_SCHEMAS = {
+        {"PlayerChat", {
+            {"player", BaseType::PLAYER},
+            {"message", BaseType::STRING},
+            {"event.player", BaseType::PLAYER},
+            {"event.message", BaseType::STRING},
+        }},
+        {"PlayerJoin", {
+            {"player", BaseType::PLAYER},
+            {"name", BaseType::STRING},
+            {"event.player", BaseType::PLAYER},
+            {"event.name", BaseType::STRING},
+        }},
+    };
+
+    // Type names ASTExecutor.isType recognises
+    const char* const TYPE_NAMES[] = {"Player", "Location", "String", "Number", "Boolean"};
+
+    bool isNumber(BaseType type) {
+        return type == BaseType::INTEGER || type == BaseType::DOUBLE;
+    }
+
+    bool isOrdering(Op op) {
+        return op == Op::LESS_THAN || op == Op::GREATER_THAN || op == Op::LESS_EQUALS || op == Op::GREATER_EQUALS;
+    }
+
+    BaseType join(BaseType a, BaseType b) {
+        return a == b ? a : BaseType::UNKNOWN;
+    }
+
+    BaseType typeOf(const Expression* expression) {
+        return expression ? expression->getStaticType() : BaseType::UNKNOWN;
+    }
+}
+
+void TypeChecker::check(ExecuteBlock& block, const Environment& environment, const std::string& label) {
+    TypeChecker checker(block, environment, label);
+
+    // Assignments can only widen a variable's type, so this settles within a few passes
+    while (checker.infer(block)) {
+    }
+
+    for (const FlatNode& flat : PostOrder::flatten(block).nodes) {
+        if (flat.kind == NodeKind::BINARY) {
+            checker.specialize(*static_cast<BinaryExpression*>(const_cast<ASTNode*>(flat.node)));
+        }
+    }
+}
+
+TypeChecker::Environment TypeChecker::forArguments(const std::vector<std::string>& names,
+                                                   const std::vector<BaseType>& types) {
+    Environment environment;
+    for (size_t i = 0; i < names.size() && i < types.size(); i++) {
+        environment[names[i]] = types[i] == BaseType::EITHER ? BaseType::UNKNOWN : types[i];
+    }
+    return environment;
+}
+
+TypeChecker::Environment TypeChecker::forEvent(const std::string& eventName) {
+    auto schema = EVENT_SCHEMAS.find(eventName);
+    return schema != EVENT_SCHEMAS.end() ? schema->second : Environment{};
+}
+
+TypeChecker::TypeChecker(const ExecuteBlock& block, const Environment& environment, const std::string& label)
+    : slotNames(block.getSlotNames()), types(environment), reassigned(block.getSlotNames().size(), false),
+      label(label) {}
+
+// One pass over the block in post-order, so every operand is typed before the node
+// that uses it. Returns true if an assignment changed a variable's type.
+bool TypeChecker::infer(const ExecuteBlock& block) {
+    bool changed = false;
+
+    for (const FlatNode& flat : PostOrder::flatten(block).nodes) {
+        auto node = const_cast<ASTNode*>(flat.node);
+        switch (flat.kind) {
+            case NodeKind::STRING_LITERAL:
+            case NodeKind::INTERPOLATED_STRING:
+            case NodeKind::CONCAT:
+                static_cast<Expression*>(node)->setStaticType(BaseType::STRING);
+                break;
+
+            case NodeKind::BOOLEAN_LITERAL:
+                static_cast<Expression*>(node)->setStaticType(BaseType::BOOLEAN);
+                break;
+
+            case NodeKind::BINARY: {
+                auto binary = static_cast<BinaryExpression*>(node);
+                binary->setStaticType(binary->getOperator() == Op::CONCATENATE ? BaseType::STRING : BaseType::BOOLEAN);
+                break;
+            }
+
+            case NodeKind::VARIABLE_REFERENCE: {
+                auto reference = static_cast<VariableReference*>(node);
+                reference->setStaticType(typeOfPath(reference->getSlot(), reference->getPath()));
+                break;
+            }
+
+            case NodeKind::EVENT_ACCESS: {
+                auto access = static_cast<EventAccessExpression*>(node);
+                access->setStaticType(typeOfPath(SlotResolver::EVENT_SLOT, {access->getProperty()}));
+                break;
+            }
+
+            case NodeKind::ASSIGN: {
+                auto assignment = static_cast<const VariableAssignment*>(node);
+                assign(assignment->getSlot(), assignment->getPath(), typeOf(assignment->getValue().get()), changed);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return changed;
+}
+
+BaseType TypeChecker::typeOfPath(int slot, const std::vector<std::string>& path) const {
+    if (slot < 0 || static_cast<size_t>(slot) >= slotNames.size()) {
+        return BaseType::UNKNOWN;
+    }
+    if (!path.empty() && reassigned[slot]) {
+        return BaseType::UNKNOWN;
+    }
+
+    auto type = types.find(keyFor(slot, path));
+    return type != types.end() ? type->second : BaseType::UNKNOWN;
+}
+
+void TypeChecker::assign(int slot, const std::vector<std::string>& path, BaseType type, bool& changed) {
+    if (slot < 0 || static_cast<size_t>(slot) >= slotNames.size()) {
+        return;
+    }
+
+    if (path.empty() && !reassigned[slot]) {
+        reassigned[slot] = true;
+        changed = true;
+    }
+
+    // A property only keeps its type if the host declared it: setters may convert
+    // the value, so what reads back is not necessarily what was assigned
+    std::string key = keyFor(slot, path);
+    auto current = types.find(key);
+    if (current == types.end()) {
+        if (path.empty()) {
+            types.emplace(key, type);
+            changed = true;
+        }
+        return;
+    }
+
+    BaseType joined = join(current->second, type);
+    if (joined != current->second) {
+        current->second = joined;
+        changed = true;
+    }
+}
+
+void TypeChecker::specialize(BinaryExpression& binary) const {
+    Op op = binary.getOperator();
+    BaseType left = typeOf(binary.getLeft().get());
+    BaseType right = typeOf(binary.getRight().get());
+    bool bothKnown = left != BaseType::UNKNOWN && right != BaseType::UNKNOWN;
+
+    if (op == Op::IS_TYPE || op == Op::IS_NOT_TYPE) {
+        auto type = dynamic_cast<const TypeLiteral*>(binary.getRight().get());
+        if (type) {
+            for (const char* name : TYPE_NAMES) {
+                if (type->getTypeName() == name) return;
+            }
+            throw std::runtime_error(label + ": unknown type '" + type->getTypeName() + "' after 'is a'");
+        }
+        return;
+    }
+
+    if (op == Op::EQUALS || op == Op::NOT_EQUALS) {
+        bool equals = op == Op::EQUALS;
+        if (isNumber(left) && isNumber(right)) {
+            binary.specialize(equals ? Op::NUMBER_EQUALS : Op::NUMBER_NOT_EQUALS);
+        } else if (left == BaseType::STRING || right == BaseType::STRING) {
+            binary.specialize(equals ? Op::STRING_EQUALS : Op::STRING_NOT_EQUALS);
+        } else if (left == BaseType::PLAYER && right == BaseType::PLAYER) {
+            binary.specialize(equals ? Op::IDENTITY_EQUALS : Op::IDENTITY_NOT_EQUALS);
+        }
+
+        if (bothKnown && left != right && !(isNumber(left) && isNumber(right))) {
+            Diagnostics::note(label + ": warning: comparing " + describe(left) + " with " + describe(right) +
+                              ", which are never equal");
+        }
+        return;
+    }
+
+    if (isOrdering(op)) {
+        // The runtime orders two numbers or two strings and throws for anything else
+        auto orderable = [](BaseType type) {
+            return type == BaseType::UNKNOWN || type == BaseType::STRING || isNumber(type);
+        };
+        bool mismatched = bothKnown && isNumber(left) != isNumber(right);
+        if (!orderable(left) || !orderable(right) || mismatched) {
+            throw std::runtime_error(label + ": cannot order " + describe(left) + " and " + describe(right));
+        }
+
+        if (isNumber(left) && isNumber(right)) {
+            binary.specialize(op == Op::LESS_THAN ? Op::NUMBER_LESS_THAN
+                            : op == Op::GREATER_THAN ? Op::NUMBER_GREATER_THAN
+                            : op == Op::LESS_EQUALS ? Op::NUMBER_LESS_EQUALS
+                            : Op::NUMBER_GREATER_EQUALS);
+        }
+    }
+}
+
+std::string TypeChecker::keyFor(int slot, const std::vector<std::string>& path) const {
+    std::string key = slotNames[slot];
+    for (const auto& segment : path) {
+        key += '.';
+        key += segment;
+    }
+    return key;
+}
+
+std::string TypeChecker::describe(BaseType type) {
+    return DataType(type).toString();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ExecuteBlock.h"
+#include "BinaryExpression.h"
+#include "DataType.h"
+
+// Infers a static type for every expression of an execute block once SlotResolver has
+// bound its variables, then uses the types to:
+//   - swap comparison operators for typed variants (string equality, number
+//     comparison, player identity) so the runtime skips its instanceof dispatch
+//   - reject comparisons that can only fail at runtime and unknown `is a` types,
+//     by throwing std::runtime_error like the parser does for syntax errors
+//   - note comparisons whose operand types can never be equal
+//
+// Types come from an environment of names the host puts into the frame (command
+// arguments, an event's variables and properties) and from `set` statements. A name
+// assigned values of different types is UNKNOWN. Typed values may still be null, so
+// the typed operator variants keep the generic behaviour for null operands.
+class TypeChecker {
+public:
+    // Keyed by variable name, or by dotted path for properties ("event.message")
+    using Environment = std::unordered_map<std::string, BaseType>;
+
+    static void check(ExecuteBlock& block, const Environment& environment, const std::string& label);
+
+    // Types of command arguments; either<...> is UNKNOWN
+    static Environment forArguments(const std::vector<std::string>& names, const std::vector<BaseType>& types);
+
+    // Variables and properties the runtime provides to handlers of the named event
+    static Environment forEvent(const std::string& eventName);
+
+private:
+    TypeChecker(const ExecuteBlock& block, const Environment& environment, const std::string& label);
+
+    const std::vector<std::string>& slotNames;
+    Environment types;
+    std::vector<bool> reassigned; // per slot: a `set` replaced the root, so its property types are stale
+    std::string label;
+
+    bool infer(const ExecuteBlock& block);
+    BaseType typeOfPath(int slot, const std::vector<std::string>& path) const;
+    void assign(int slot, const std::vector<std::string>& path, BaseType type, bool& changed);
+    void specialize(BinaryExpression& binary) const;
+
+    std::string keyFor(int slot, const std::vector<std::string>& path) const;
+    static std::string describe(BaseType type);
+};
@@ -2,10 +2,12 @@
 #include "CommandParser.h"
 #include "VariableParser.h"
 #include <stdexcept>
+#include <ScratchArena.h>
 #include <sstream>
 #include <iostream>
 #include <Lexer.h>
 #include "ExecuteBlockParser.h"
+#include "BlockPasses.h"
 #include "ExecuteBlock.h"
 
 CommandParser::CommandParser(const std::vector<Token>& tokens) : tokens(tokens) {}
@@ -47,7 +49,7 @@ std::shared_ptr<Command> CommandParser::parseCommand() {
     }
     
     std::string commandName = tokens[current - 1].value;
-    auto command = std::make_shared<Command>(commandName);
+    auto command = ScratchArena::make<Command>(commandName);
     
     // Check if this is the start of a command group (next token is comma or left brace)
     size_t savedPosition = current;
@@ -112,6 +114,19 @@ void CommandParser::parseCommandProperties(std::shared_ptr<Command> command) {
             advance(); // Skip unexpected token
         }
     }
+    
+    // Arguments may be declared after the execute block, so slots are bound only once
+    // every property has been read
+    if (command->getExecuteBlock()) {
+        std::vector<std::string> argumentNames;
+        std::vector<BaseType> argumentTypes;
+        for (const auto& arg : command->getArguments()) {
+            argumentNames.push_back(arg->getName());
+            argumentTypes.push_back(arg->getType() ? arg->getType()->getBaseType() : BaseType::UNKNOWN);
+        }
+        BlockPasses::run(*command->getExecuteBlock(), argumentNames,
+                         TypeChecker::forArguments(argumentNames, argumentTypes), "command " + command->getName());
+    }
 }
 
 void CommandParser::parseArgumentsBlock(std::shared_ptr<Command> command) {
@@ -397,7 +412,7 @@ std::vector<std::shared_ptr<Command>> CommandParser::parseCommandsWithAliases()
     }
     
     // Create a temporary command to parse the properties
-    auto templateCommand = std::make_shared<Command>(commandNames[0]);
+    auto templateCommand = ScratchArena::make<Command>(commandNames[0]);
     parseCommandProperties(templateCommand);
     
     if (!match(TokenType::RIGHT_BRACE)) {
@@ -407,7 +422,7 @@ std::vector<std::shared_ptr<Command>> CommandParser::parseCommandsWithAliases()
     // Create all command variants with the same properties
     std::vector<std::shared_ptr<Command>> commands;
     for (const auto& name : commandNames) {
-        auto command = std::make_shared<Command>(name);
+        auto command = ScratchArena::make<Command>(name);
         
         // Copy all properties from the template
         command->setPermission(templateCommand->getPermission());
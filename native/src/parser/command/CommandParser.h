@@ -15,7 +15,7 @@ public:
     std::vector<std::shared_ptr<Command>> parseCommandsWithAliases();
     
 private:
-    std::vector<Token> tokens;
+    const std::vector<Token>& tokens;
     size_t current = 0;
     
     // Token navigation methods
@@ -1,6 +1,8 @@
 #include "EventParser.h"
 #include "ExecuteBlockParser.h"
+#include "BlockPasses.h"
 #include <stdexcept>
+#include <ScratchArena.h>
 
 EventParser::EventParser(const std::vector<Token>& tokens) : tokens(tokens) {}
 
@@ -47,7 +49,7 @@ std::shared_ptr<Event> EventParser::parseEvent() {
     }
     
     std::string eventName = tokens[current - 1].value;
-    auto event = std::make_shared<Event>(eventName);
+    auto event = ScratchArena::make<Event>(eventName);
     
     if (!match(TokenType::LEFT_BRACE)) {
         throw std::runtime_error("Expected '{' after event name");
@@ -115,6 +117,7 @@ void EventParser::parseEventProperties(std::shared_ptr<Event> event) {
                 // Create an execute block parser and parse the statements
                 ExecuteBlockParser executeParser(blockTokens);
                 auto executeBlock = executeParser.parseExecuteBlock();
+                BlockPasses::run(*executeBlock, {}, TypeChecker::forEvent(event->getName()), "event " + event->getName());
                 
                 event->setExecuteBlock(executeBlock);
             }
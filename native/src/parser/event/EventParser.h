@@ -11,7 +11,7 @@ public:
     bool isAtEnd() const;
     
 private:
-    std::vector<Token> tokens;
+    const std::vector<Token>& tokens;
     size_t current = 0;
     
     Token peek() const;
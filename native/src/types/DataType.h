@@ -11,9 +11,11 @@ enum class BaseType {
     PLAYER,
     LOCATION,
     EITHER,
-    UNKNOWN
+    UNKNOWN     // Keep last, BASE_TYPE_COUNT depends on it
 };
 
+constexpr size_t BASE_TYPE_COUNT = static_cast<size_t>(BaseType::UNKNOWN) + 1;
+
 class DataType {
 private:
     BaseType baseType;
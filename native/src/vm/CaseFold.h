@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Lower case as the Java executors see it, for CONTAINS and MATCH. Java lowers each UTF-16
+// char with Character.toLowerCase, so characters of the Basic Multilingual Plane follow
+// the Unicode simple lowercase mappings and characters past it (surrogate pairs in Java)
+// are left alone.
+//
+// Text is UTF-8 as the VM holds it - modified UTF-8 when it came through JNI. Bytes that
+// do not form a sequence are kept as they are.
+class CaseFold {
+public:
+    static uint32_t lower(uint32_t codePoint);
+
+    static bool isAscii(const std::string& text);
+
+    // Appends `text`, lowered, to `out`. A lowered text can be shorter or longer in bytes.
+    static void foldInto(const std::string& text, std::string& out);
+
+    static unsigned char foldAscii(unsigned char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+    }
+};
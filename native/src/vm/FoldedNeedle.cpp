@@ -0,0 +1,112 @@
+#include "FoldedNeedle.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SWOFT_FOLDED_NEEDLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Bytes 1..m-2 of the needle against the text at `at`; the ends are already known to match
+    template <bool NeedleFolded>
+    bool middleMatches(const unsigned char* at, const unsigned char* needle, size_t m) {
+        for (size_t j = 1; j + 1 < m; j++) {
+            unsigned char expected = NeedleFolded ? needle[j] : FoldedNeedle::fold(needle[j]);
+            if (FoldedNeedle::fold(at[j]) != expected) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+#ifdef SWOFT_FOLDED_NEEDLE_SSE2
+    // Lowers the ASCII capitals among 16 bytes; bytes >= 0x80 compare as negative and stay
+    __m128i foldBlock(__m128i bytes) {
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('A' - 1)),
+                                      _mm_cmplt_epi8(bytes, _mm_set1_epi8('Z' + 1)));
+        return _mm_or_si128(bytes, _mm_and_si128(upper, _mm_set1_epi8('a' - 'A')));
+    }
+#endif
+
+    template <bool NeedleFolded>
+    bool search(const std::string& haystack, const std::string& pattern) {
+        size_t m = pattern.size();
+        size_t n = haystack.size();
+        if (m == 0) return true;
+        if (m > n) return false;
+
+        auto text = reinterpret_cast<const unsigned char*>(haystack.data());
+        auto needle = reinterpret_cast<const unsigned char*>(pattern.data());
+        unsigned char first = NeedleFolded ? needle[0] : FoldedNeedle::fold(needle[0]);
+        unsigned char last = NeedleFolded ? needle[m - 1] : FoldedNeedle::fold(needle[m - 1]);
+        size_t end = n - m + 1; // positions a match can start at
+        size_t i = 0;
+
+#ifdef SWOFT_FOLDED_NEEDLE_SSE2
+        __m128i firsts = _mm_set1_epi8(static_cast<char>(first));
+        __m128i lasts = _mm_set1_epi8(static_cast<char>(last));
+        for (; i + 16 <= end; i += 16) {
+            __m128i starts = foldBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i)));
+            __m128i ends = foldBlock(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + m - 1)));
+            auto candidates = static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(starts, firsts), _mm_cmpeq_epi8(ends, lasts))));
+            for (size_t bit = 0; candidates != 0; bit++, candidates >>= 1) {
+                if ((candidates & 1) && middleMatches<NeedleFolded>(text + i + bit, needle, m)) {
+                    return true;
+                }
+            }
+        }
+#endif
+
+        for (; i < end; i++) {
+            if (FoldedNeedle::fold(text[i]) == first && FoldedNeedle::fold(text[i + m - 1]) == last &&
+                middleMatches<NeedleFolded>(text + i, needle, m)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Lowered copies of non-ASCII strings, reused from one search to the next
+    std::string& foldedText(const std::string& text) {
+        static thread_local std::string buffer;
+        buffer.clear();
+        CaseFold::foldInto(text, buffer);
+        return buffer;
+    }
+
+    std::string& foldedNeedle(const std::string& needle) {
+        static thread_local std::string buffer;
+        buffer.clear();
+        CaseFold::foldInto(needle, buffer);
+        return buffer;
+    }
+}
+
+FoldedNeedle::FoldedNeedle(const std::string& needle) {
+    CaseFold::foldInto(needle, folded);
+    matchesRawText = searchesRaw(folded);
+}
+
+bool FoldedNeedle::searchesRaw(const std::string& needle) {
+    for (unsigned char c : needle) {
+        c = fold(c);
+        if (c >= 0x80 || c == 'i' || c == 'k') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FoldedNeedle::foundIn(const std::string& text) const {
+    if (matchesRawText || CaseFold::isAscii(text)) {
+        return search<true>(text, folded);
+    }
+    return search<true>(foldedText(text), folded);
+}
+
+bool FoldedNeedle::contains(const std::string& text, const std::string& needle) {
+    if (searchesRaw(needle) || (CaseFold::isAscii(text) && CaseFold::isAscii(needle))) {
+        return search<false>(text, needle);
+    }
+    return search<true>(foldedText(text), foldedNeedle(needle));
+}
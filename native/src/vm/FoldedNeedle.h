@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "CaseFold.h"
+
+// Case-insensitive substring search for CONTAINS, folding case as CaseFold does. When
+// both strings are ASCII no lowered copy of either is built; otherwise the text is
+// lowered into a per-thread buffer first, and a lowered UTF-8 needle can only match it
+// at character boundaries.
+//
+// Candidate positions are found by comparing the needle's first and last bytes against
+// sixteen positions of the text at a time (SSE2, where available); only positions where
+// both agree are compared in full. A FoldedNeedle keeps the needle lowered once, for
+// needles known before the search - CONTAINS against a string literal.
+class FoldedNeedle {
+public:
+    explicit FoldedNeedle(const std::string& needle);
+
+    bool foundIn(const std::string& text) const;
+
+    // For a needle only known at runtime
+    static bool contains(const std::string& text, const std::string& needle);
+
+    // Whether `needle`, lowered, can be searched for in a text that was not lowered first.
+    // Besides ASCII letters only U+0130 and U+212A lower to ASCII, to i and k; other
+    // non-ASCII text cannot match an ASCII needle's bytes.
+    static bool searchesRaw(const std::string& needle);
+
+    static unsigned char fold(unsigned char c) {
+        return CaseFold::foldAscii(c);
+    }
+
+private:
+    std::string folded;
+    bool matchesRawText; // see searchesRaw
+};
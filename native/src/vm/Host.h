@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Value.h"
+
+// A side effect the VM asks the host to perform. Effects are queued in program order
+// and handed over in batches (see Host::apply), so a handler that only reads a few
+// properties and then sends or cancels crosses into the host a handful of times.
+struct Effect {
+    enum class Kind : int32_t {
+        SEND = 0,           // first: message (STRING), second: target (NIL = the sender)
+        TELEPORT = 1,       // first: entity, second: target
+        CANCEL = 2,         // cancel the event in slot 1
+        SET_PROPERTY = 3    // first: object, second: value, property: the name to set
+    };
+
+    Kind kind;
+    Value first;
+    Value second;
+    std::string property;
+};
+
+// What the VM needs from the runtime it is embedded in. The JNI host forwards to the
+// Java executor; LocalHost is an in-memory stand-in for running handlers without a
+// server.
+class Host {
+public:
+    virtual ~Host() = default;
+
+    // Value of one property of a host object, NIL if it has none
+    virtual Value getProperty(const Value& object, const std::string& property) = 0;
+
+    // Text of a host value (OBJECT or NUMBER): its display form as used in string
+    // building, or its plain toString form when `display` is false
+    virtual std::string text(const Value& value, bool display) = 0;
+
+    // equals() between two host values (OBJECT or NUMBER)
+    virtual bool equals(const Value& first, const Value& second) = 0;
+
+    // Whether two handles refer to the same host object
+    virtual bool identical(int32_t first, int32_t second) = 0;
+
+    // Perform queued effects, in order. Called before every property read, so a read
+    // sees earlier writes, and once when the program ends.
+    virtual void apply(const std::vector<Effect>& effects) = 0;
+};
@@ -0,0 +1,87 @@
+#include "LocalHost.h"
+
+Value LocalHost::addObject(Value::ObjectType type, const std::string& text) {
+    objects.push_back({text, {}});
+    return Value::object(static_cast<int32_t>(objects.size() - 1), type);
+}
+
+Value LocalHost::addNumber(double value, const std::string& text) {
+    objects.push_back({text, {}});
+    return Value::number(value, static_cast<int32_t>(objects.size() - 1));
+}
+
+void LocalHost::setProperty(const Value& object, const std::string& property, Value value) {
+    if (object.handle >= 0 && static_cast<size_t>(object.handle) < objects.size()) {
+        objects[object.handle].properties[property] = std::move(value);
+    }
+}
+
+Value LocalHost::getProperty(const Value& object, const std::string& property) {
+    calls++;
+    if (object.handle < 0 || static_cast<size_t>(object.handle) >= objects.size()) {
+        return Value::nil();
+    }
+
+    const auto& properties = objects[object.handle].properties;
+    auto it = properties.find(property);
+    return it != properties.end() ? it->second : Value::nil();
+}
+
+std::string LocalHost::text(const Value& value, bool) {
+    calls++;
+    return describe(value);
+}
+
+bool LocalHost::equals(const Value& first, const Value& second) {
+    calls++;
+    if (first.handle == second.handle) {
+        return true;
+    }
+    // Boxed numbers are equal when they have the same class and value, which the
+    // printed form stands in for
+    return first.kind == Value::Kind::NUMBER && second.kind == Value::Kind::NUMBER &&
+           first.numeric == second.numeric && describe(first) == describe(second);
+}
+
+bool LocalHost::identical(int32_t first, int32_t second) {
+    calls++;
+    return first == second;
+}
+
+void LocalHost::apply(const std::vector<Effect>& effects) {
+    calls++;
+    for (const Effect& effect : effects) {
+        switch (effect.kind) {
+            case Effect::Kind::SEND:
+                log.push_back("send " + (effect.second.isNil() ? std::string("sender") : describe(effect.second)) +
+                              ": " + effect.first.text);
+                break;
+            case Effect::Kind::TELEPORT:
+                log.push_back("teleport " + describe(effect.first) + " to " + describe(effect.second));
+                break;
+            case Effect::Kind::CANCEL:
+                log.push_back("cancel");
+                break;
+            case Effect::Kind::SET_PROPERTY:
+                setProperty(effect.first, effect.property, effect.second);
+                log.push_back("set " + describe(effect.first) + "." + effect.property + " = " +
+                              describe(effect.second));
+                break;
+        }
+    }
+}
+
+std::string LocalHost::describe(const Value& value) {
+    switch (value.kind) {
+        case Value::Kind::NIL: return "null";
+        case Value::Kind::BOOLEAN: return value.flag ? "true" : "false";
+        case Value::Kind::STRING: return value.text;
+        case Value::Kind::NUMBER:
+        case Value::Kind::OBJECT:
+            if (value.handle >= 0 && static_cast<size_t>(value.handle) < objects.size()) {
+                return objects[value.handle].text;
+            }
+            return "?";
+    }
+    return "";
+}
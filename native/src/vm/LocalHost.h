@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Host.h"
+
+// An in-memory Host for running handlers without a server, e.g. from swoftc. Objects
+// are plain property maps with a display text; effects are applied to those maps and
+// recorded as readable lines, and every upcall is counted so the cost of a handler in
+// host crossings can be measured.
+class LocalHost : public Host {
+public:
+    // Create an object and return it as a value
+    Value addObject(Value::ObjectType type, const std::string& text);
+
+    // Create a number; `text` is what the host would print for it ("5" or "5.0")
+    Value addNumber(double value, const std::string& text);
+
+    void setProperty(const Value& object, const std::string& property, Value value);
+
+    // Each applied effect, in order, e.g. "send Steve: hello"
+    const std::vector<std::string>& getLog() const { return log; }
+
+    // Number of calls made into this host, batches of effects counting once
+    size_t getCalls() const { return calls; }
+
+    Value getProperty(const Value& object, const std::string& property) override;
+    std::string text(const Value& value, bool display) override;
+    bool equals(const Value& first, const Value& second) override;
+    bool identical(int32_t first, int32_t second) override;
+    void apply(const std::vector<Effect>& effects) override;
+
+private:
+    struct Object {
+        std::string text;
+        std::unordered_map<std::string, Value> properties;
+    };
+
+    std::vector<Object> objects;
+    std::vector<std::string> log;
+    size_t calls = 0;
+
+    std::string describe(const Value& value);
+};
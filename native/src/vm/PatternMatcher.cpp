@@ -0,0 +1,99 @@
+#include "PatternMatcher.h"
+#include <algorithm>
+#include <cstring>
+#include "CaseFold.h"
+
+PatternMatcher::PatternMatcher(const std::vector<std::string>& sources) {
+    std::vector<std::string> patterns(sources.size());
+    for (size_t i = 0; i < sources.size(); i++) {
+        CaseFold::foldInto(sources[i], patterns[i]);
+    }
+
+    std::memset(classes, 0, sizeof(classes));
+    for (const auto& pattern : patterns) {
+        for (unsigned char c : pattern) {
+            uint8_t folded = fold(c);
+            if (classes[folded] == 0) {
+                classes[folded] = static_cast<uint8_t>(classCount++);
+            }
+        }
+    }
+
+    // Folding leaves at most 230 distinct bytes, so every class fits in a byte
+    const size_t width = static_cast<size_t>(classCount);
+
+    // Trie of the folded patterns; -1 marks a missing edge until failure links fill it
+    next.assign(width, -1);
+    best.assign(1, NO_MATCH);
+    for (size_t i = 0; i < patterns.size(); i++) {
+        size_t state = 0;
+        for (unsigned char c : patterns[i]) {
+            size_t slot = state * width + classes[fold(c)];
+            if (next[slot] < 0) {
+                next[slot] = static_cast<int32_t>(best.size());
+                next.resize(next.size() + width, -1);
+                best.push_back(NO_MATCH);
+            }
+            state = static_cast<size_t>(next[slot]);
+        }
+        if (best[state] == NO_MATCH) {
+            best[state] = static_cast<int32_t>(i);
+        }
+    }
+
+    // Breadth-first, so a state's failure target is complete before the state is
+    std::vector<int32_t> failure(best.size(), 0);
+    std::vector<int32_t> queue;
+    for (size_t c = 0; c < width; c++) {
+        if (next[c] < 0) {
+            next[c] = 0;
+        } else {
+            queue.push_back(next[c]);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        size_t state = static_cast<size_t>(queue[head]);
+        size_t fallback = static_cast<size_t>(failure[state]);
+        if (best[fallback] != NO_MATCH && (best[state] == NO_MATCH || best[fallback] < best[state])) {
+            best[state] = best[fallback];
+        }
+
+        for (size_t c = 0; c < width; c++) {
+            int32_t& target = next[state * width + c];
+            if (target < 0) {
+                target = next[fallback * width + c];
+            } else {
+                failure[target] = next[fallback * width + c];
+                queue.push_back(target);
+            }
+        }
+    }
+}
+
+int32_t PatternMatcher::firstMatch(const std::string& source) const {
+    static thread_local std::string lowered;
+    const std::string* folded = &source;
+    if (!CaseFold::isAscii(source)) {
+        lowered.clear();
+        CaseFold::foldInto(source, lowered);
+        folded = &lowered;
+    }
+    const std::string& text = *folded;
+
+    int32_t found = best[0]; // an empty pattern occurs in every text
+    size_t state = 0;
+    for (unsigned char c : text) {
+        if (found == 0) break; // nothing can come before the first pattern
+        state = static_cast<size_t>(next[state * static_cast<size_t>(classCount) + classes[fold(c)]]);
+        int32_t match = best[state];
+        if (match != NO_MATCH && (found == NO_MATCH || match < found)) {
+            found = match;
+        }
+    }
+    return found;
+}
+
+uint8_t PatternMatcher::fold(unsigned char c) {
+    return CaseFold::foldAscii(c);
+}
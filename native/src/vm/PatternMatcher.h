@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Finds which of a set of patterns occur in a text, ignoring case as the VM's CONTAINS
+// does (CaseFold), in one pass over the text however many patterns there are. Patterns
+// are kept lowered; a text that is not ASCII is lowered into a per-thread buffer first.
+//
+// The patterns are built into an Aho-Corasick automaton whose failure links are folded
+// into a full transition table, so each byte of text costs one table lookup. Bytes are
+// first mapped to classes - one per distinct byte the patterns use, plus one for every
+// other byte - which keeps the table at patterns' total length x classes entries.
+class PatternMatcher {
+public:
+    static constexpr int32_t NO_MATCH = -1;
+
+    explicit PatternMatcher(const std::vector<std::string>& patterns);
+
+    // Index of the first pattern, in the order given, that occurs in `text`
+    int32_t firstMatch(const std::string& text) const;
+
+private:
+    uint8_t classes[256];          // folded byte -> class; 0 for bytes no pattern uses
+    int32_t classCount = 1;
+    std::vector<int32_t> next;     // state * classCount + class -> state
+    std::vector<int32_t> best;     // lowest pattern index ending at a state or a suffix of it
+
+    static uint8_t fold(unsigned char c);
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// A register of the native VM. Strings and booleans live natively; anything else the
+// script reads - players, positions, events - stays with the host and is referred to
+// by a handle the host hands out. Numbers only ever come from the host, so they keep
+// the handle of the original object next to their double value; displaying one asks
+// the host, which prints 5 for an Integer and 5.0 for a Double, as the JVM does.
+struct Value {
+    enum class Kind : uint8_t {
+        NIL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        OBJECT
+    };
+
+    // What a host object is, as far as `is a` checks are concerned
+    enum class ObjectType : uint8_t {
+        OTHER,
+        PLAYER,
+        LOCATION
+    };
+
+    Kind kind = Kind::NIL;
+    ObjectType objectType = ObjectType::OTHER;
+    bool flag = false;
+    double numeric = 0;
+    int32_t handle = -1;    // host object for NUMBER and OBJECT
+    std::string text;
+
+    static Value nil() { return Value(); }
+
+    static Value boolean(bool value) {
+        Value v;
+        v.kind = Kind::BOOLEAN;
+        v.flag = value;
+        return v;
+    }
+
+    static Value string(std::string value) {
+        Value v;
+        v.kind = Kind::STRING;
+        v.text = std::move(value);
+        return v;
+    }
+
+    static Value number(double value, int32_t handle) {
+        Value v;
+        v.kind = Kind::NUMBER;
+        v.numeric = value;
+        v.handle = handle;
+        return v;
+    }
+
+    static Value object(int32_t handle, ObjectType type) {
+        Value v;
+        v.kind = Kind::OBJECT;
+        v.handle = handle;
+        v.objectType = type;
+        return v;
+    }
+
+    bool isNil() const { return kind == Kind::NIL; }
+};
@@ -0,0 +1,388 @@
+#include "VirtualMachine.h"
+#include <BinaryExpression.h>
+#include <ColorTags.h>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+    using Op = BinaryExpression::Operator;
+
+    bool isHostValue(const Value& value) {
+        return value.kind == Value::Kind::OBJECT || value.kind == Value::Kind::NUMBER;
+    }
+
+    const char* kindName(const Value& value) {
+        switch (value.kind) {
+            case Value::Kind::NIL: return "null";
+            case Value::Kind::BOOLEAN: return "Boolean";
+            case Value::Kind::NUMBER: return "Number";
+            case Value::Kind::STRING: return "String";
+            case Value::Kind::OBJECT:
+                switch (value.objectType) {
+                    case Value::ObjectType::PLAYER: return "Player";
+                    case Value::ObjectType::LOCATION: return "Pos";
+                    case Value::ObjectType::OTHER: break;
+                }
+                return "Object";
+        }
+        return "Object";
+    }
+
+    // Text of a value inside a built string, like ASTExecutor.getDisplayString
+    std::string display(const Value& value, Host& host) {
+        switch (value.kind) {
+            case Value::Kind::NIL: return "null";
+            case Value::Kind::BOOLEAN: return value.flag ? "true" : "false";
+            case Value::Kind::STRING: return value.text;
+            case Value::Kind::NUMBER:
+            case Value::Kind::OBJECT: return host.text(value, true);
+        }
+        return "";
+    }
+
+    bool toBoolean(const Value& value) {
+        switch (value.kind) {
+            case Value::Kind::NIL: return false;
+            case Value::Kind::BOOLEAN: return value.flag;
+            case Value::Kind::NUMBER: return value.numeric != 0;
+            case Value::Kind::STRING: return !value.text.empty();
+            case Value::Kind::OBJECT: return true;
+        }
+        return false;
+    }
+
+    // Objects.equals: same kind and value, host values by their equals()
+    bool strictEquals(const Value& left, const Value& right, Host& host) {
+        if (left.kind != right.kind) {
+            return false;
+        }
+        switch (left.kind) {
+            case Value::Kind::NIL: return true;
+            case Value::Kind::BOOLEAN: return left.flag == right.flag;
+            case Value::Kind::STRING: return left.text == right.text;
+            case Value::Kind::NUMBER:
+            case Value::Kind::OBJECT: return host.equals(left, right);
+        }
+        return false;
+    }
+
+    // The untyped `=`: numbers of any class compare by value
+    bool looseEquals(const Value& left, const Value& right, Host& host) {
+        if (left.kind == Value::Kind::NUMBER && right.kind == Value::Kind::NUMBER) {
+            return left.numeric == right.numeric;
+        }
+        return strictEquals(left, right, host);
+    }
+
+    bool numbersEqual(const Value& left, const Value& right) {
+        if (left.isNil() || right.isNil()) {
+            return left.isNil() && right.isNil();
+        }
+        if (left.kind != Value::Kind::NUMBER || right.kind != Value::Kind::NUMBER) {
+            throw std::runtime_error(std::string("Cannot compare ") + kindName(left) + " and " +
+                                     kindName(right) + " as numbers");
+        }
+        return left.numeric == right.numeric;
+    }
+
+    bool identical(const Value& left, const Value& right, Host& host) {
+        if (isHostValue(left) && isHostValue(right)) {
+            return host.identical(left.handle, right.handle);
+        }
+        return left.kind == right.kind && strictEquals(left, right, host);
+    }
+
+    int compare(const Value& left, const Value& right) {
+        if (left.kind == Value::Kind::NUMBER && right.kind == Value::Kind::NUMBER) {
+            return left.numeric < right.numeric ? -1 : (left.numeric > right.numeric ? 1 : 0);
+        }
+        if (left.kind == Value::Kind::STRING && right.kind == Value::Kind::STRING) {
+            int result = left.text.compare(right.text);
+            return result < 0 ? -1 : (result > 0 ? 1 : 0);
+        }
+        throw std::runtime_error(std::string("Cannot compare objects of types: ") + kindName(left) + " and " +
+                                 kindName(right));
+    }
+
+    bool isType(const Value& value, const std::string& typeName) {
+        if (typeName == "Player") return value.kind == Value::Kind::OBJECT && value.objectType == Value::ObjectType::PLAYER;
+        if (typeName == "Location") return value.kind == Value::Kind::OBJECT && value.objectType == Value::ObjectType::LOCATION;
+        if (typeName == "String") return value.kind == Value::Kind::STRING;
+        if (typeName == "Number") return value.kind == Value::Kind::NUMBER;
+        if (typeName == "Boolean") return value.kind == Value::Kind::BOOLEAN;
+        return false;
+    }
+
+    // The text CONTAINS searches for or in; strings are used in place, anything else
+    // is rendered into `scratch`
+    const std::string& searchText(const Value& value, Host& host, std::string& scratch) {
+        if (value.kind == Value::Kind::STRING) {
+            return value.text;
+        }
+        if (!value.isNil()) {
+            scratch = display(value, host);
+        }
+        return scratch;
+    }
+
+    Value applyOperator(Op op, const Value& left, const Value& right, Host& host) {
+        switch (op) {
+            case Op::EQUALS: return Value::boolean(looseEquals(left, right, host));
+            case Op::NOT_EQUALS: return Value::boolean(!looseEquals(left, right, host));
+            case Op::LESS_THAN:
+            case Op::NUMBER_LESS_THAN: return Value::boolean(compare(left, right) < 0);
+            case Op::GREATER_THAN:
+            case Op::NUMBER_GREATER_THAN: return Value::boolean(compare(left, right) > 0);
+            case Op::LESS_EQUALS:
+            case Op::NUMBER_LESS_EQUALS: return Value::boolean(compare(left, right) <= 0);
+            case Op::GREATER_EQUALS:
+            case Op::NUMBER_GREATER_EQUALS: return Value::boolean(compare(left, right) >= 0);
+            case Op::STRING_EQUALS: return Value::boolean(strictEquals(left, right, host));
+            case Op::STRING_NOT_EQUALS: return Value::boolean(!strictEquals(left, right, host));
+            case Op::NUMBER_EQUALS: return Value::boolean(numbersEqual(left, right));
+            case Op::NUMBER_NOT_EQUALS: return Value::boolean(!numbersEqual(left, right));
+            case Op::IDENTITY_EQUALS: return Value::boolean(identical(left, right, host));
+            case Op::IDENTITY_NOT_EQUALS: return Value::boolean(!identical(left, right, host));
+            case Op::IS_TYPE: return Value::boolean(isType(left, right.text));
+            case Op::IS_NOT_TYPE: return Value::boolean(!isType(left, right.text));
+            case Op::CONTAINS: {
+                std::string leftText;
+                std::string rightText;
+                return Value::boolean(FoldedNeedle::contains(searchText(left, host, leftText),
+                                                             searchText(right, host, rightText)));
+            }
+            case Op::CONCATENATE: return Value::string(display(left, host) + display(right, host));
+            case Op::AND:
+            case Op::OR:
+                break;
+        }
+        throw std::runtime_error("Unknown operator " + std::to_string(static_cast<int>(op)));
+    }
+
+    // Hands the queue over before applying it, so a host that fails part way is not
+    // given the same effects again when run() flushes on the way out
+    void flush(Host& host, std::vector<Effect>& effects) {
+        if (!effects.empty()) {
+            std::vector<Effect> batch;
+            batch.swap(effects);
+            host.apply(batch);
+        }
+    }
+
+    Value readProperty(const Value& object, const std::string& property, Host& host, std::vector<Effect>& effects) {
+        flush(host, effects);
+        return host.getProperty(object, property);
+    }
+}
+
+VirtualMachine::VirtualMachine(Program compiled) : program(std::move(compiled)) {
+    constants.resize(program.constants.size());
+    switchTables.resize(program.constants.size());
+    matchers.resize(program.constants.size());
+    needles.resize(program.constants.size());
+
+    for (size_t i = 0; i < program.constants.size(); i++) {
+        const Constant& constant = program.constants[i];
+        if (constant.kind == Constant::Kind::STRING) {
+            constants[i] = Value::string(constant.strings[0]);
+        } else if (constant.kind == Constant::Kind::SWITCH) {
+            for (size_t j = 0; j < constant.strings.size(); j++) {
+                switchTables[i].emplace(constant.strings[j], constant.targets[j]);
+            }
+        } else if (constant.kind == Constant::Kind::MATCH) {
+            matchers[i] = std::make_unique<PatternMatcher>(constant.strings);
+        }
+    }
+
+    // String literals searched for with CONTAINS are lowered once, here
+    for (size_t pc = 0; pc < program.code.size(); pc += 1 + Bytecode::operandCount(program.code, pc)) {
+        if (static_cast<Opcode>(program.code[pc]) != Opcode::BINARY) {
+            continue;
+        }
+        const int32_t* a = &program.code[pc + 1];
+        if (a[1] == static_cast<int32_t>(Op::CONTAINS) && a[3] < 0 && !needles[-(a[3] + 1)]) {
+            needles[-(a[3] + 1)] = std::make_unique<FoldedNeedle>(constants[-(a[3] + 1)].text);
+        }
+    }
+}
+
+VirtualMachine::Outcome VirtualMachine::run(std::vector<Value>& frame, Host& host) const {
+    frame.resize(static_cast<size_t>(program.registerCount));
+    std::vector<Effect> effects;
+    size_t pc = 0;
+
+    try {
+        Outcome outcome = execute(frame, host, effects, pc);
+        flush(host, effects);
+        return outcome;
+    } catch (const std::exception& e) {
+        flush(host, effects);
+        int32_t line = Bytecode::lineAt(program, pc);
+        throw std::runtime_error((line > 0 ? "Line " + std::to_string(line) + ": " : std::string()) + e.what());
+    }
+}
+
+const Value& VirtualMachine::operand(int32_t rk, const std::vector<Value>& frame) const {
+    return rk >= 0 ? frame[rk] : constants[-(rk + 1)];
+}
+
+VirtualMachine::Outcome VirtualMachine::execute(std::vector<Value>& frame, Host& host, std::vector<Effect>& effects,
+                                                size_t& pc) const {
+    const int32_t* code = program.code.data();
+
+    while (true) {
+        const int32_t* a = code + pc + 1;
+        switch (static_cast<Opcode>(code[pc])) {
+            case Opcode::LOAD_CONST:
+                frame[a[0]] = constants[a[1]];
+                pc += 3;
+                break;
+
+            case Opcode::LOAD_BOOL:
+                frame[a[0]] = Value::boolean(a[1] != 0);
+                pc += 3;
+                break;
+
+            case Opcode::MOVE:
+                frame[a[0]] = frame[a[1]];
+                pc += 3;
+                break;
+
+            case Opcode::GET_PATH: {
+                Value current = frame[a[1]];
+                for (const auto& segment : program.constants[a[2]].strings) {
+                    if (current.isNil()) break;
+                    current = readProperty(current, segment, host, effects);
+                }
+                frame[a[0]] = std::move(current);
+                pc += 4;
+                break;
+            }
+
+            case Opcode::SET_PATH: {
+                const auto& path = program.constants[a[1]].strings;
+                Value object = frame[a[0]];
+                if (object.isNil()) {
+                    std::cerr << "Error: Cannot set property on non-existent object: "
+                              << program.constants[a[3]].strings[0] << std::endl;
+                    pc += 5;
+                    break;
+                }
+                for (size_t i = 0; i + 1 < path.size() && !object.isNil(); i++) {
+                    object = readProperty(object, path[i], host, effects);
+                }
+                if (!object.isNil()) {
+                    effects.push_back({Effect::Kind::SET_PROPERTY, std::move(object), frame[a[2]], path.back()});
+                }
+                pc += 5;
+                break;
+            }
+
+            case Opcode::BINARY:
+                if (a[1] == static_cast<int32_t>(Op::CONTAINS) && a[3] < 0) {
+                    std::string scratch;
+                    frame[a[0]] = Value::boolean(needles[-(a[3] + 1)]->foundIn(
+                        searchText(operand(a[2], frame), host, scratch)));
+                } else {
+                    frame[a[0]] = applyOperator(static_cast<Op>(a[1]), operand(a[2], frame), operand(a[3], frame),
+                                                host);
+                }
+                pc += 5;
+                break;
+
+            case Opcode::CONCAT: {
+                std::string result;
+                result.reserve(static_cast<size_t>(a[2]));
+                for (int32_t i = 0; i < a[3]; i++) {
+                    int32_t part = a[4 + i];
+                    if (part < 0) {
+                        result += constants[-(part + 1)].text;
+                        continue;
+                    }
+                    const Value& value = frame[part];
+                    if (value.isNil() && (a[1] & CONCAT_SKIP_NULL)) {
+                        continue;
+                    }
+                    result += (a[1] & CONCAT_TRANSLATE) ? ColorTags::translate(display(value, host)) : display(value, host);
+                }
+                frame[a[0]] = Value::string(std::move(result));
+                pc += 5 + static_cast<size_t>(a[3]);
+                break;
+            }
+
+            case Opcode::TO_MESSAGE: {
+                const Value& value = frame[a[1]];
+                std::string text;
+                if (value.kind == Value::Kind::STRING) {
+                    text = value.text;
+                } else if (isHostValue(value)) {
+                    text = host.text(value, false);
+                } else if (!value.isNil()) {
+                    text = display(value, host);
+                }
+                frame[a[0]] = Value::string(ColorTags::translate(text));
+                pc += 3;
+                break;
+            }
+
+            case Opcode::JUMP:
+                pc = static_cast<size_t>(a[0]);
+                break;
+
+            case Opcode::JUMP_IF_FALSE:
+                pc = toBoolean(frame[a[0]]) ? pc + 3 : static_cast<size_t>(a[1]);
+                break;
+
+            case Opcode::JUMP_IF_TRUE:
+                pc = toBoolean(frame[a[0]]) ? static_cast<size_t>(a[1]) : pc + 3;
+                break;
+
+            case Opcode::SWITCH: {
+                const Value& subject = frame[a[0]];
+                pc = static_cast<size_t>(a[2]);
+                if (subject.kind == Value::Kind::STRING) {
+                    const auto& table = switchTables[a[1]];
+                    auto it = table.find(subject.text);
+                    if (it != table.end()) {
+                        pc = static_cast<size_t>(it->second);
+                    }
+                }
+                break;
+            }
+
+            case Opcode::MATCH: {
+                // The subject as CONTAINS renders its left operand
+                std::string scratch;
+                int32_t match = matchers[a[1]]->firstMatch(searchText(frame[a[0]], host, scratch));
+                pc = static_cast<size_t>(match != PatternMatcher::NO_MATCH ? program.constants[a[1]].targets[match]
+                                                                          : a[2]);
+                break;
+            }
+
+            case Opcode::SEND:
+                effects.push_back({Effect::Kind::SEND, operand(a[0], frame),
+                                   a[1] >= 0 ? frame[a[1]] : Value::nil(), {}});
+                pc += 3;
+                break;
+
+            case Opcode::TELEPORT:
+                effects.push_back({Effect::Kind::TELEPORT, frame[a[0]], frame[a[1]], {}});
+                pc += 3;
+                break;
+
+            case Opcode::CANCEL:
+                effects.push_back({Effect::Kind::CANCEL, Value::nil(), Value::nil(), {}});
+                pc += 1;
+                break;
+
+            case Opcode::HALT:
+                return Outcome::HALTED;
+
+            case Opcode::RETURN:
+                return Outcome::FINISHED;
+
+            default:
+                throw std::runtime_error("Unknown opcode " + std::to_string(code[pc]) + " at " + std::to_string(pc));
+        }
+    }
+}
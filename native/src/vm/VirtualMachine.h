@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Bytecode.h"
+#include "FoldedNeedle.h"
+#include "Host.h"
+#include "PatternMatcher.h"
+#include "Value.h"
+
+// Runs a compiled Program natively (see Bytecode.h for the instruction set).
+//
+// Control flow, string building, switch lookups and comparisons all happen on native
+// Values. The host is only called for property reads, text of host objects, and the
+// effects a handler has - sends, teleports, cancels and property writes - which are
+// queued and applied in batches: before each property read and once at the end.
+//
+// One VirtualMachine is built per program and can run it any number of times, also
+// concurrently: run() keeps all of its state on the caller's stack.
+class VirtualMachine {
+public:
+    enum class Outcome {
+        FINISHED,
+        HALTED
+    };
+
+    explicit VirtualMachine(Program program);
+
+    const Program& getProgram() const { return program; }
+
+    // Runs the program over `frame`, which holds the block's slots on entry and is
+    // resized to the program's register count. Throws std::runtime_error, prefixed with
+    // the source line when known, if an operation fails; effects queued before the
+    // failure are still applied.
+    Outcome run(std::vector<Value>& frame, Host& host) const;
+
+private:
+    Program program;
+    std::vector<Value> constants;                                         // STRING constants as values
+    std::vector<std::unordered_map<std::string, int32_t>> switchTables;  // SWITCH constants, by index
+    std::vector<std::unique_ptr<PatternMatcher>> matchers;               // MATCH constants, by index
+    std::vector<std::unique_ptr<FoldedNeedle>> needles;                  // literals CONTAINS searches for
+
+    Outcome execute(std::vector<Value>& frame, Host& host, std::vector<Effect>& effects, size_t& pc) const;
+    const Value& operand(int32_t rk, const std::vector<Value>& frame) const;
+};
@@ -0,0 +1,119 @@
+// AstMarshaller against the fake JNIEnv in FakeJni.h: the tree it builds has every node
+// of the block, the number of local references it holds at once does not grow with the
+// script, and a node that fails to build fails the whole marshal.
+#include "Test.h"
+#include "FakeJni.h"
+#include "AstMarshaller.h"
+#include "SwoftLangParser.h"
+#include "ExecuteBlockParser.h"
+#include "ConditionCompiler.h"
+#include <unordered_set>
+
+namespace {
+    // The Java statement and expression nodes reachable from a marshalled block
+    size_t countNodes(fakejni::Object* root) {
+        std::unordered_set<fakejni::Object*> seen;
+        std::vector<fakejni::Object*> pending{root};
+        size_t nodes = 0;
+        while (!pending.empty()) {
+            fakejni::Object* current = pending.back();
+            pending.pop_back();
+            if (!current || !seen.insert(current).second) continue;
+
+            const std::string& name = current->className;
+            if (name[0] != '[' && name != "java/lang/String" && name.find("$Operator") == std::string::npos) {
+                nodes++;
+            }
+            pending.insert(pending.end(), current->objects.begin(), current->objects.end());
+        }
+        return nodes;
+    }
+
+    size_t countFlatNodes(const ExecuteBlock& block) {
+        size_t nodes = 0;
+        for (const FlatNode& flat : PostOrder::flatten(block).nodes) {
+            if (flat.kind != NodeKind::NONE) nodes++;
+        }
+        return nodes;
+    }
+
+    struct Marshalled {
+        fakejni::Object* root;
+        size_t peakLocals; // the most local references live at once during the marshal
+    };
+
+    // Marshals a block the way the bridge does, in a frame of its own
+    Marshalled marshal(const ExecuteBlock& block) {
+        fakejni::Env& fake = fakejni::Env::get();
+        JNIEnv* env = fake.env();
+        const JavaClassCache& cache = fakejni::classCache();
+        size_t before = fake.liveLocals();
+
+        JStringInterner strings(env);
+        fake.resetCounts();
+        jobject result = AstMarshaller(env, strings, cache).marshal(block);
+        Marshalled marshalled{fake.deref(result), fake.peakLocals() - before};
+        env->DeleteLocalRef(result);
+
+        SWOFT_CHECK(fake.errors() == 0);
+        SWOFT_CHECK(fake.liveLocals() == before);
+        return marshalled;
+    }
+
+    std::string chain(int branches) {
+        std::string code;
+        for (int i = 0; i < branches; i++) {
+            code += (i == 0 ? "if" : "} else if");
+            code += " event.message contains \"" + std::to_string(i) + "\" {\n    send \"" + std::to_string(i) + "\"\n";
+        }
+        return code + "} else {\n    send \"none\"\n}\n";
+    }
+
+    std::string nested(size_t depth) {
+        std::string code;
+        for (size_t i = 0; i < depth; i++) {
+            code += "if event.message contains \"" + std::to_string(i) + "\" {\n";
+        }
+        code += "send \"deep\"\n";
+        for (size_t i = 0; i < depth; i++) {
+            code += "}\n";
+        }
+        return code;
+    }
+}
+
+SWOFT_TEST(marshalKeepsEveryNode) {
+    for (const std::string& body : {chain(3), nested(3), std::string("send \"a\" + event.message + \"b\"\n")}) {
+        auto block = SwoftLangParser::parseExecuteBlock(body);
+        Marshalled marshalled = marshal(*block);
+        SWOFT_CHECK(marshalled.root != nullptr);
+        SWOFT_CHECK(countNodes(marshalled.root) == countFlatNodes(*block));
+    }
+}
+
+SWOFT_TEST(marshalLocalsDoNotGrowWithDepth) {
+    swofttest::runWithStack(1024 * 1024, [] {
+        // Three branches already compile to a match table, the program's largest constant
+        size_t shallow = marshal(*SwoftLangParser::parseExecuteBlock(chain(3))).peakLocals;
+        for (const std::string& body : {chain(10000), nested(ExecuteBlockParser::MAX_BLOCK_DEPTH)}) {
+            auto block = SwoftLangParser::parseExecuteBlock(body);
+            Marshalled marshalled = marshal(*block);
+            SWOFT_CHECK(countNodes(marshalled.root) == countFlatNodes(*block));
+            SWOFT_CHECK(marshalled.peakLocals <= shallow);
+        }
+    });
+}
+
+SWOFT_TEST(marshalFailsWhenSwitchBranchesFail) {
+    // An else-if chain on one value becomes a switch, whose branches go into a Statement[]
+    std::string body;
+    for (size_t i = 0; i < ConditionCompiler::SWITCH_MIN_CASES; i++) {
+        body += (i == 0 ? "if" : "} else if");
+        body += " event.message = \"" + std::to_string(i) + "\" {\n    send \"" + std::to_string(i) + "\"\n";
+    }
+    auto block = SwoftLangParser::parseExecuteBlock(body + "}\nsend \"after\"\n");
+    fakejni::Env::get().failNextArrayOf("net/swofty/nativebridge/execution/Statement");
+    Marshalled marshalled = marshal(*block);
+    SWOFT_CHECK(marshalled.root == nullptr);
+    SWOFT_CHECK(!fakejni::Env::get().env()->ExceptionCheck());
+}
@@ -0,0 +1,220 @@
+// CONTAINS and MATCH in the native VM must fold case exactly as the Java executors do
+// with Character.toLowerCase, one UTF-16 char at a time. foldedNeedleTimings prints what
+// the search costs against lowering copies of both strings first, and matcherTimings what
+// one PatternMatcher pass costs against a CONTAINS per pattern.
+#include "Test.h"
+#include "CaseFold.h"
+#include "FoldedNeedle.h"
+#include "PatternMatcher.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace {
+    bool contains(const std::string& text, const std::string& needle) {
+        bool literal = FoldedNeedle(needle).foundIn(text);
+        bool runtime = FoldedNeedle::contains(text, needle);
+        SWOFT_CHECK(literal == runtime);
+        return literal;
+    }
+
+    // What CONTAINS did before FoldedNeedle: lower both strings, then search
+    bool containsLowered(const std::string& text, const std::string& needle) {
+        std::string loweredText;
+        std::string loweredNeedle;
+        CaseFold::foldInto(text, loweredText);
+        CaseFold::foldInto(needle, loweredNeedle);
+        return loweredText.find(loweredNeedle) != std::string::npos;
+    }
+
+    // Nanoseconds per call, the best of five rounds of `runs` calls
+    template <typename Search>
+    double time(long runs, Search search) {
+        volatile bool sink = false;
+        double best = 1e300;
+        for (int round = 0; round < 5; round++) {
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < runs; i++) {
+                sink = search();
+            }
+            best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / runs);
+        }
+        (void) sink;
+        return best;
+    }
+
+    // What a chain of CONTAINS checks finds: the first pattern, in order, the text contains
+    int32_t firstContained(const std::vector<FoldedNeedle>& needles, const std::string& text) {
+        for (size_t i = 0; i < needles.size(); i++) {
+            if (needles[i].foundIn(text)) return static_cast<int32_t>(i);
+        }
+        return PatternMatcher::NO_MATCH;
+    }
+
+    std::vector<FoldedNeedle> needlesOf(const std::vector<std::string>& patterns) {
+        return std::vector<FoldedNeedle>(patterns.begin(), patterns.end());
+    }
+
+    // 400 two-word phrases, as a moderation script's banned list
+    std::vector<std::string> phrases() {
+        const char* firsts[] = {"free", "cheap", "buy", "sell", "join", "visit", "click", "get", "win", "best",
+                                "hack", "dupe", "fly", "kill", "grief", "spam", "scam", "trade", "rank", "op"};
+        const char* seconds[] = {"diamonds", "gold", "netherite", "elytra", "ranks", "coins", "accounts", "server",
+                                 "discord", "client", "mods", "items", "keys", "spawners", "beacons", "totems",
+                                 "shulkers", "emeralds", "cash", "gems"};
+        std::vector<std::string> phrases;
+        for (const char* first : firsts) {
+            for (const char* second : seconds) {
+                phrases.push_back(std::string(first) + " " + second);
+            }
+        }
+        return phrases;
+    }
+
+    // Chat lines of the length players type, two of them holding a phrase
+    std::vector<std::string> chatLines() {
+        return {
+            "Anyone Selling Diamond Pickaxes? Meet Me At Spawn In 5 Mins",
+            "gg everyone, that was a close one",
+            "Does anybody know where the nearest village is?",
+            "LOL my house just burned down again",
+            "Click here for FREE DIAMONDS at example dot com",
+            "Trading two stacks of iron for a mending book",
+            "who wants to start a new town by the river",
+            "brb dinner",
+            "How do I get to the End? I have 12 eyes",
+            "Is the nether hub connected to the ice road yet",
+            "thanks for the help earlier, the farm works now",
+            "Join our Discord Server for giveaways every week",
+            "Can someone tp me back to base please",
+            "Why is the creeper farm not spawning anything",
+            "Good morning from the other side of the world",
+            "Lag is really bad today, is the server OK?",
+        };
+    }
+
+    std::string repeated(const std::string& sentence, size_t length) {
+        std::string text;
+        while (text.size() < length) {
+            text += sentence;
+        }
+        return text;
+    }
+}
+
+SWOFT_TEST(caseFoldLowersLikeJava) {
+    SWOFT_CHECK(CaseFold::lower('A') == 'a');
+    SWOFT_CHECK(CaseFold::lower(0x00C9) == 0x00E9); // É
+    SWOFT_CHECK(CaseFold::lower(0x00DF) == 0x00DF); // ß has no single-char lower form
+    SWOFT_CHECK(CaseFold::lower(0x0130) == 'i');    // İ
+    SWOFT_CHECK(CaseFold::lower(0x212A) == 'k');    // Kelvin sign
+    SWOFT_CHECK(CaseFold::lower(0x03A3) == 0x03C3); // Σ
+    SWOFT_CHECK(CaseFold::lower(0x0410) == 0x0430); // А
+    SWOFT_CHECK(CaseFold::lower(0x1E9E) == 0x00DF); // ẞ
+    SWOFT_CHECK(CaseFold::lower(0xFF21) == 0xFF41); // Ａ
+    SWOFT_CHECK(CaseFold::lower(0x10400) == 0x10400); // past the BMP Java lowers nothing
+}
+
+SWOFT_TEST(containsFoldsNonAscii) {
+    SWOFT_CHECK(contains("\xC3\x89vian", "\xC3\xA9"));                      // Évian, é
+    SWOFT_CHECK(contains("Stra\xC3\x9F" "e", "STRA\xC3\x9F" "E"));          // Straße, STRAßE
+    SWOFT_CHECK(!contains("STRASSE", "stra\xC3\x9F" "e"));
+    SWOFT_CHECK(contains("\xCE\xA3\xCE\x9F\xCE\xA6\xCE\x8A\xCE\x91", "\xCF\x83\xCE\xBF\xCF\x86\xCE\xAF\xCE\xB1")); // ΣΟΦΊΑ, σοφία
+    SWOFT_CHECK(contains("\xE2\x84\xAA" "elvin", "kelvin"));                // Kelvin sign
+    SWOFT_CHECK(contains("\xC4\xB0stanbul", "istanbul"));                   // İstanbul
+    SWOFT_CHECK(!contains("\xF0\x90\x90\x80", "\xF0\x90\x90\xA8"));         // Deseret 𐐀, 𐐨
+    SWOFT_CHECK(!contains("\xED\xA0\x81\xED\xB0\x80", "\xED\xA0\x81\xED\xB0\xA8")); // the same, modified UTF-8
+    SWOFT_CHECK(contains("caf\xC3\xA9 CAF\xC3\x89", "\xC3\xA9 c"));
+    SWOFT_CHECK(!contains("\xC3\xA9", "e"));
+    SWOFT_CHECK(contains("SAY HELLO TO THE WORLD \xC3\x89T\xC3\x89 AND MORE", "the world \xC3\xA9t\xC3\xA9 and"));
+    SWOFT_CHECK(contains("\xFF\xFE bytes", "BYTES"));                       // not UTF-8 at all
+}
+
+SWOFT_TEST(matchFoldsNonAscii) {
+    PatternMatcher matcher({"\xC3\xA9t\xC3\xA9", "stra\xC3\x9F" "e", "k"});
+    SWOFT_CHECK(matcher.firstMatch("\xC3\x89T\xC3\x89") == 0);               // ÉTÉ
+    SWOFT_CHECK(matcher.firstMatch("STRA\xC3\x9F" "E") == 1);
+    SWOFT_CHECK(matcher.firstMatch("\xE2\x84\xAA") == 2);                    // Kelvin sign
+    SWOFT_CHECK(matcher.firstMatch("ete") == PatternMatcher::NO_MATCH);
+}
+
+SWOFT_TEST(foldedNeedleTimings) {
+    // A needle none of the texts contain, so each search runs to the end
+    const std::string needle = "Discord Server";
+    const std::pair<const char*, std::string> texts[] = {
+        {"chat", "Anyone Selling Diamond Pickaxes? Meet Me At Spawn In 5 Mins"},
+        {"book", repeated("The Old Mill By The River Was Rebuilt After The Flood Of The Third Winter. ", 4096)},
+        {"book, accented", repeated("L'\xC3\x89t\xC3\xA9 O\xC3\xB9 Le Vieux Moulin Fut Reb\xC3\xA2ti Apr\xC3\xA8s La Crue. ", 4096)},
+    };
+
+    FoldedNeedle literal(needle);
+    for (const auto& [name, text] : texts) {
+        SWOFT_CHECK(!containsLowered(text, needle) && !contains(text, needle));
+        long runs = text.size() < 100 ? 200000 : 5000;
+        double lowered = time(runs, [&] { return containsLowered(text, needle); });
+        double runtime = time(runs, [&] { return FoldedNeedle::contains(text, needle); });
+        double folded = time(runs, [&] { return literal.foundIn(text); });
+        std::printf("%-15s %5zu bytes: lowered copies %9.1f ns, FoldedNeedle::contains %9.1f ns, literal %9.1f ns\n",
+                    name, text.size(), lowered, runtime, folded);
+    }
+    std::fflush(stdout);
+}
+
+SWOFT_TEST(matchAgreesWithContains) {
+    // Patterns that overlap, share prefixes and suffixes, nest inside each other and differ
+    // only in case; the first one in order must win wherever it ends in the text
+    const std::vector<std::string> patterns = {
+        "hers", "HE", "she", "his", "s", "bAdWoRd", "badword", "word", "\xC3\x89t\xC3\xA9", "stra\xC3\x9F" "e", "",
+    };
+    const std::vector<std::string> fragments = {
+        "h", "H", "e", "E", "r", "s", "S", "i", "BAD", "bad", "Wor", "WORD", "d", " ", "x",
+        "\xC3\x89", "\xC3\xA9", "t", "T", "STRA", "\xC3\x9F", "\xE1\xBA\x9E", "\xC4\xB0",
+    };
+
+    std::mt19937 random(49);
+    for (size_t skip = 0; skip < patterns.size(); skip++) {
+        // Every pattern but one, so the empty pattern does not always win
+        std::vector<std::string> used;
+        for (size_t i = 0; i < patterns.size(); i++) {
+            if (i != skip && !patterns[i].empty()) used.push_back(patterns[i]);
+        }
+        PatternMatcher matcher(used);
+        std::vector<FoldedNeedle> needles = needlesOf(used);
+        for (int run = 0; run < 2000; run++) {
+            std::string text;
+            for (size_t length = random() % 12; length > 0; length--) {
+                text += fragments[random() % fragments.size()];
+            }
+            SWOFT_CHECK(matcher.firstMatch(text) == firstContained(needles, text));
+        }
+    }
+
+    PatternMatcher withEmpty(patterns);
+    SWOFT_CHECK(withEmpty.firstMatch("USHERS") == 0);
+    SWOFT_CHECK(withEmpty.firstMatch("ushe") == 1);
+    SWOFT_CHECK(withEmpty.firstMatch("xyz") == 10);
+
+    const std::vector<std::string> banned = phrases();
+    PatternMatcher chat(banned);
+    std::vector<FoldedNeedle> needles = needlesOf(banned);
+    for (const std::string& line : chatLines()) {
+        SWOFT_CHECK(chat.firstMatch(line) == firstContained(needles, line));
+    }
+}
+
+SWOFT_TEST(matcherTimings) {
+    const std::vector<std::string> banned = phrases();
+    const std::vector<std::string> lines = chatLines();
+    for (size_t count : {size_t(10), size_t(100), banned.size()}) {
+        std::vector<std::string> some(banned.begin(), banned.begin() + static_cast<long>(count));
+        PatternMatcher fewer(some);
+        std::vector<FoldedNeedle> fewerNeedles = needlesOf(some);
+        size_t line = 0;
+        double sequential = time(20000, [&] { return firstContained(fewerNeedles, lines[line++ % lines.size()]) >= 0; });
+        line = 0;
+        double automaton = time(20000, [&] { return fewer.firstMatch(lines[line++ % lines.size()]) >= 0; });
+        std::printf("%3zu phrases, %zu chat lines: CONTAINS per phrase %9.1f ns/line, PatternMatcher %6.1f ns/line\n",
+                    count, lines.size(), sequential, automaton);
+    }
+    std::fflush(stdout);
+}
@@ -0,0 +1,165 @@
+// Scripts at the parser's limits: a long else-if chain, which is parsed, analysed and
+// flattened without recursing per branch, and blocks nested to MAX_BLOCK_DEPTH. Each runs
+// on a 1 MB stack through the passes and the post-order walk AstMarshaller shares with
+// ScriptSerializer. deepScriptsScale times both at increasing sizes.
+#include "Test.h"
+#include "FakeJni.h"
+#include "AstMarshaller.h"
+#include "SwoftLangParser.h"
+#include "ScriptSerializer.h"
+#include "ExecuteBlockParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr size_t STACK = 1024 * 1024;
+    constexpr int CHAIN = 10000;
+
+    std::string chain(int branches) {
+        std::string code;
+        for (int i = 0; i < branches; i++) {
+            code += (i == 0 ? "if" : "} else if");
+            code += " event.message = \"" + std::to_string(i) + "\" {\n    send \"" + std::to_string(i) + "\"\n";
+        }
+        return code + "} else {\n    send \"none\"\n}\n";
+    }
+
+    std::string nested(size_t depth) {
+        std::string code;
+        for (size_t i = 0; i < depth; i++) {
+            code += "if event.message contains \"" + std::to_string(i) + "\" {\n";
+        }
+        code += "send \"deep\"\n";
+        for (size_t i = 0; i < depth; i++) {
+            code += "}\n";
+        }
+        return code;
+    }
+
+    std::string event(const std::string& body) {
+        return "event PlayerChat {\n    execute {\n" + body + "    }\n}\n";
+    }
+
+    // Parses a whole script and encodes it, failing unless it gives exactly one event
+    void parseEvent(const std::string& code) {
+        auto parsed = SwoftLangParser::parseAll(code);
+        SWOFT_CHECK(parsed.second.size() == 1);
+        SWOFT_CHECK(parsed.second[0]->getExecuteBlock() != nullptr);
+        SWOFT_CHECK(!ScriptSerializer::serialize(parsed.first, parsed.second).empty());
+    }
+
+    // Resident set size in bytes, or 0 where it is not sampled
+    size_t residentBytes() {
+#ifdef __linux__
+        long pages = 0;
+        long resident = 0;
+        FILE* statm = std::fopen("/proc/self/statm", "r");
+        if (!statm) return 0;
+        int read = std::fscanf(statm, "%ld %ld", &pages, &resident);
+        std::fclose(statm);
+        return read == 2 ? static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    struct Sample {
+        double parseMillis;   // parse and serialize the whole script, best of three
+        double marshalMillis; // marshal its execute block through the fake JNIEnv, best of three
+        double residentMiB;   // resident growth while the parsed script is alive
+        size_t peakLocals;    // most local references live at once during the marshal
+    };
+
+    double millisSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Sample measure(const std::string& body) {
+        std::string code = event(body);
+        Sample sample{1e300, 1e300, 0, 0};
+        for (int run = 0; run < 3; run++) {
+            size_t before = residentBytes();
+            auto start = std::chrono::steady_clock::now();
+            auto parsed = SwoftLangParser::parseAll(code);
+            SWOFT_CHECK(!ScriptSerializer::serialize(parsed.first, parsed.second).empty());
+            sample.parseMillis = std::min(sample.parseMillis, millisSince(start));
+            size_t after = residentBytes();
+            sample.residentMiB = std::max(sample.residentMiB,
+                                          after > before ? (after - before) / (1024.0 * 1024.0) : 0.0);
+        }
+
+        fakejni::Env& fake = fakejni::Env::get();
+        const JavaClassCache& classes = fakejni::classCache();
+        auto block = SwoftLangParser::parseExecuteBlock(body);
+        for (int run = 0; run < 3; run++) {
+            JStringInterner strings(fake.env());
+            fake.resetCounts();
+            size_t baseline = fake.liveLocals();
+            auto start = std::chrono::steady_clock::now();
+            jobject result = AstMarshaller(fake.env(), strings, classes).marshal(*block);
+            sample.marshalMillis = std::min(sample.marshalMillis, millisSince(start));
+            SWOFT_CHECK(result != nullptr);
+            sample.peakLocals = std::max(sample.peakLocals, fake.peakLocals() - baseline);
+            fake.env()->DeleteLocalRef(result);
+        }
+        return sample;
+    }
+
+    // Measures each size and checks that time per node stays within a factor of the
+    // smallest measured size's at the largest, and that the local reference bound holds
+    void checkScaling(const char* name, const std::vector<size_t>& sizes,
+                      const std::function<std::string(size_t)>& generate) {
+        std::vector<Sample> samples;
+        for (size_t size : sizes) {
+            samples.push_back(measure(generate(size)));
+            const Sample& sample = samples.back();
+            std::printf("%s %5zu: parse %8.3f ms, marshal %8.3f ms, %+6.2f MiB resident, %zu live locals\n",
+                        name, size, sample.parseMillis, sample.marshalMillis, sample.residentMiB, sample.peakLocals);
+        }
+        std::fflush(stdout);
+
+        // The first size only warms up; noise swamps per-node time on tiny scripts
+        const Sample& small = samples[1];
+        const Sample& large = samples.back();
+        double scale = static_cast<double>(sizes.back()) / static_cast<double>(sizes[1]);
+        SWOFT_CHECK(large.parseMillis <= small.parseMillis * scale * 4);
+        SWOFT_CHECK(large.marshalMillis <= small.marshalMillis * scale * 4);
+        for (const Sample& sample : samples) {
+            SWOFT_CHECK(sample.peakLocals <= samples.back().peakLocals);
+        }
+        SWOFT_CHECK(large.peakLocals == small.peakLocals);
+    }
+}
+
+SWOFT_TEST(deepElseIfChain) {
+    swofttest::runWithStack(STACK, [] { parseEvent(event(chain(CHAIN))); });
+}
+
+SWOFT_TEST(nestedToBlockDepthLimit) {
+    swofttest::runWithStack(STACK, [] { parseEvent(event(nested(ExecuteBlockParser::MAX_BLOCK_DEPTH))); });
+}
+
+SWOFT_TEST(nestedPastBlockDepthLimit) {
+    swofttest::runWithStack(STACK, [] {
+        std::string error;
+        try {
+            SwoftLangParser::parseExecuteBlock(nested(ExecuteBlockParser::MAX_BLOCK_DEPTH + 1));
+        } catch (const std::runtime_error& e) {
+            error = e.what();
+        }
+        SWOFT_CHECK(error == "Blocks nested more than 256 deep");
+    });
+}
+
+// Else-if chains up to CHAIN branches and nesting up to MAX_BLOCK_DEPTH, which is as deep as
+// the parser accepts; deeper nesting is rejected above rather than measured
+SWOFT_TEST(deepScriptsScale) {
+    swofttest::runWithStack(STACK, [] {
+        checkScaling("chain", {10, 100, 1000, CHAIN}, [](size_t size) { return chain(static_cast<int>(size)); });
+        checkScaling("nested", {4, 16, 64, ExecuteBlockParser::MAX_BLOCK_DEPTH}, nested);
+    });
+}
@@ -0,0 +1,306 @@
+#include "FakeJni.h"
+#include "BinaryExpression.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace fakejni {
+    Env& Env::get() {
+        static Env instance;
+        return instance;
+    }
+
+    Env::Env() {
+        table.GetVersion = GetVersion;
+        table.FindClass = FindClass;
+        table.ThrowNew = ThrowNew;
+        table.ExceptionCheck = ExceptionCheck;
+        table.ExceptionOccurred = ExceptionOccurred;
+        table.ExceptionDescribe = ExceptionDescribe;
+        table.ExceptionClear = ExceptionClear;
+        table.PushLocalFrame = PushLocalFrame;
+        table.PopLocalFrame = PopLocalFrame;
+        table.EnsureLocalCapacity = EnsureLocalCapacity;
+        table.NewGlobalRef = NewGlobalRef;
+        table.DeleteGlobalRef = DeleteGlobalRef;
+        table.NewLocalRef = NewLocalRef;
+        table.DeleteLocalRef = DeleteLocalRef;
+        table.IsSameObject = IsSameObject;
+        table.IsInstanceOf = IsInstanceOf;
+        table.GetMethodID = GetMethodID;
+        table.GetStaticMethodID = GetMethodID;
+        table.NewObjectV = NewObjectV;
+        table.CallVoidMethodV = CallVoidMethodV;
+        table.CallStaticObjectMethodV = CallStaticObjectMethodV;
+        table.NewStringUTF = NewStringUTF;
+        table.GetStringUTFLength = GetStringUTFLength;
+        table.GetStringUTFChars = GetStringUTFChars;
+        table.ReleaseStringUTFChars = ReleaseStringUTFChars;
+        table.GetArrayLength = GetArrayLength;
+        table.NewObjectArray = NewObjectArray;
+        table.GetObjectArrayElement = GetObjectArrayElement;
+        table.SetObjectArrayElement = SetObjectArrayElement;
+        table.NewIntArray = NewIntArray;
+        table.SetIntArrayRegion = SetIntArrayRegion;
+        table.GetIntArrayRegion = GetIntArrayRegion;
+        jniEnv.functions = &table;
+        frames.emplace_back(); // the frame a native method is called in
+    }
+
+    Env& Env::of(JNIEnv* env) {
+        (void) env;
+        return get();
+    }
+
+    void Env::resetCounts() {
+        peak = live;
+        misuse = 0;
+    }
+
+    Object* Env::create(const std::string& className) {
+        objects.push_back(Object{className, {}, {}, {}, {}});
+        return &objects.back();
+    }
+
+    jobject Env::local(Object* target) {
+        if (!target) return NULL;
+        refs.push_back(Ref{target, false, true});
+        frames.back().push_back(&refs.back());
+        peak = std::max(peak, ++live);
+        return reinterpret_cast<jobject>(&refs.back());
+    }
+
+    jobject Env::global(Object* target) {
+        if (!target) return NULL;
+        refs.push_back(Ref{target, true, true});
+        return reinterpret_cast<jobject>(&refs.back());
+    }
+
+    void Env::release(Ref* ref) {
+        if (!ref->alive) {
+            misuse++;
+            return;
+        }
+        ref->alive = false;
+        if (!ref->global) live--;
+    }
+
+    Object* Env::deref(jobject ref) {
+        if (!ref) return NULL;
+        Ref* entry = reinterpret_cast<Ref*>(ref);
+        if (!entry->alive) {
+            misuse++;
+        }
+        return entry->target;
+    }
+
+    // Reads call arguments by the method's signature: objects into `objects`, ints and
+    // booleans into the target's ints
+    void Env::arguments(Object* target, const std::string& signature, va_list args, std::vector<Object*>& out) {
+        for (size_t i = 1; i < signature.size() && signature[i] != ')'; i++) {
+            char type = signature[i];
+            while (signature[i] == '[') i++;
+            if (signature[i] == 'L') i = signature.find(';', i);
+            if (type == '[' || type == 'L') {
+                out.push_back(deref(va_arg(args, jobject)));
+            } else if (type == 'J') {
+                va_arg(args, jlong);
+            } else if (type == 'D' || type == 'F') {
+                va_arg(args, jdouble);
+            } else {
+                target->ints.push_back(va_arg(args, jint));
+            }
+        }
+    }
+
+    jint JNICALL Env::GetVersion(JNIEnv*) {
+        return JNI_VERSION_1_6;
+    }
+
+    jclass JNICALL Env::FindClass(JNIEnv* env, const char* name) {
+        Env& self = of(env);
+        Object* cls = self.create("java/lang/Class");
+        cls->text = name;
+        return static_cast<jclass>(self.local(cls));
+    }
+
+    jint JNICALL Env::ThrowNew(JNIEnv* env, jclass, const char*) {
+        of(env).pending = true;
+        return 0;
+    }
+
+    jboolean JNICALL Env::ExceptionCheck(JNIEnv* env) {
+        return of(env).pending ? JNI_TRUE : JNI_FALSE;
+    }
+
+    jthrowable JNICALL Env::ExceptionOccurred(JNIEnv* env) {
+        Env& self = of(env);
+        return self.pending ? static_cast<jthrowable>(self.local(self.create("java/lang/OutOfMemoryError"))) : NULL;
+    }
+
+    void JNICALL Env::ExceptionDescribe(JNIEnv*) {
+    }
+
+    void JNICALL Env::ExceptionClear(JNIEnv* env) {
+        of(env).pending = false;
+    }
+
+    jint JNICALL Env::PushLocalFrame(JNIEnv* env, jint) {
+        of(env).frames.emplace_back();
+        return 0;
+    }
+
+    jobject JNICALL Env::PopLocalFrame(JNIEnv* env, jobject result) {
+        Env& self = of(env);
+        Object* kept = self.deref(result);
+        for (Ref* ref : self.frames.back()) {
+            if (ref->alive) {
+                ref->alive = false;
+                self.live--;
+            }
+        }
+        self.frames.pop_back();
+        return self.local(kept);
+    }
+
+    jint JNICALL Env::EnsureLocalCapacity(JNIEnv*, jint) {
+        return 0;
+    }
+
+    jobject JNICALL Env::NewGlobalRef(JNIEnv* env, jobject ref) {
+        Env& self = of(env);
+        return self.global(self.deref(ref));
+    }
+
+    void JNICALL Env::DeleteGlobalRef(JNIEnv* env, jobject ref) {
+        if (ref) of(env).release(reinterpret_cast<Ref*>(ref));
+    }
+
+    jobject JNICALL Env::NewLocalRef(JNIEnv* env, jobject ref) {
+        Env& self = of(env);
+        return self.local(self.deref(ref));
+    }
+
+    void JNICALL Env::DeleteLocalRef(JNIEnv* env, jobject ref) {
+        if (ref) of(env).release(reinterpret_cast<Ref*>(ref));
+    }
+
+    jboolean JNICALL Env::IsSameObject(JNIEnv* env, jobject a, jobject b) {
+        Env& self = of(env);
+        return self.deref(a) == self.deref(b) ? JNI_TRUE : JNI_FALSE;
+    }
+
+    jboolean JNICALL Env::IsInstanceOf(JNIEnv* env, jobject obj, jclass cls) {
+        Env& self = of(env);
+        Object* target = self.deref(obj);
+        return target && target->className == self.deref(cls)->text ? JNI_TRUE : JNI_FALSE;
+    }
+
+    jmethodID JNICALL Env::GetMethodID(JNIEnv* env, jclass, const char* name, const char* signature) {
+        Env& self = of(env);
+        self.methods.push_back(Method{name, signature});
+        return reinterpret_cast<jmethodID>(&self.methods.back());
+    }
+
+    jobject JNICALL Env::NewObjectV(JNIEnv* env, jclass cls, jmethodID id, va_list args) {
+        Env& self = of(env);
+        Object* created = self.create(self.deref(cls)->text);
+        self.arguments(created, self.method(id)->signature, args, created->objects);
+        return self.local(created);
+    }
+
+    jobject JNICALL Env::CallStaticObjectMethodV(JNIEnv* env, jclass cls, jmethodID id, va_list) {
+        Env& self = of(env);
+        const std::string& className = self.deref(cls)->text;
+        if (self.method(id)->name != "values") {
+            return NULL;
+        }
+        Object* constants = self.create("[L" + className + ";");
+        for (size_t i = 0; i < self.enumSizes[className]; i++) {
+            constants->objects.push_back(self.create(className));
+        }
+        return self.local(constants);
+    }
+
+    void JNICALL Env::CallVoidMethodV(JNIEnv* env, jobject obj, jmethodID id, va_list args) {
+        Env& self = of(env);
+        Object* target = self.deref(obj);
+        const Method* called = self.method(id);
+        std::vector<Object*>& out = called->name.rfind("add", 0) == 0 ? target->objects : target->calls[called->name];
+        self.arguments(target, called->signature, args, out);
+    }
+
+    jstring JNICALL Env::NewStringUTF(JNIEnv* env, const char* utf) {
+        Env& self = of(env);
+        Object* string = self.create("java/lang/String");
+        string->text = utf;
+        return static_cast<jstring>(self.local(string));
+    }
+
+    jsize JNICALL Env::GetStringUTFLength(JNIEnv* env, jstring str) {
+        return static_cast<jsize>(of(env).deref(str)->text.size());
+    }
+
+    const char* JNICALL Env::GetStringUTFChars(JNIEnv* env, jstring str, jboolean* isCopy) {
+        if (isCopy) *isCopy = JNI_FALSE;
+        return of(env).deref(str)->text.c_str();
+    }
+
+    void JNICALL Env::ReleaseStringUTFChars(JNIEnv*, jstring, const char*) {
+    }
+
+    jsize JNICALL Env::GetArrayLength(JNIEnv* env, jarray array) {
+        Object* target = of(env).deref(array);
+        return static_cast<jsize>(target->className == "[I" ? target->ints.size() : target->objects.size());
+    }
+
+    jobjectArray JNICALL Env::NewObjectArray(JNIEnv* env, jsize length, jclass cls, jobject init) {
+        Env& self = of(env);
+        const std::string& elementClass = self.deref(cls)->text;
+        if (!self.failingArray.empty() && self.failingArray == elementClass) {
+            self.failingArray.clear();
+            self.pending = true;
+            return NULL;
+        }
+        Object* array = self.create("[L" + elementClass + ";");
+        array->objects.assign(static_cast<size_t>(length), self.deref(init));
+        return static_cast<jobjectArray>(self.local(array));
+    }
+
+    jobject JNICALL Env::GetObjectArrayElement(JNIEnv* env, jobjectArray array, jsize index) {
+        Env& self = of(env);
+        return self.local(self.deref(array)->objects.at(static_cast<size_t>(index)));
+    }
+
+    void JNICALL Env::SetObjectArrayElement(JNIEnv* env, jobjectArray array, jsize index, jobject value) {
+        Env& self = of(env);
+        self.deref(array)->objects.at(static_cast<size_t>(index)) = self.deref(value);
+    }
+
+    jintArray JNICALL Env::NewIntArray(JNIEnv* env, jsize length) {
+        Env& self = of(env);
+        Object* array = self.create("[I");
+        array->ints.assign(static_cast<size_t>(length), 0);
+        return static_cast<jintArray>(self.local(array));
+    }
+
+    void JNICALL Env::SetIntArrayRegion(JNIEnv* env, jintArray array, jsize start, jsize length, const jint* values) {
+        std::copy(values, values + length, of(env).deref(array)->ints.begin() + start);
+    }
+
+    void JNICALL Env::GetIntArrayRegion(JNIEnv* env, jintArray array, jsize start, jsize length, jint* values) {
+        const std::vector<jint>& ints = of(env).deref(array)->ints;
+        std::copy(ints.begin() + start, ints.begin() + start + length, values);
+    }
+
+    const JavaClassCache& classCache() {
+        Env& fake = Env::get();
+        fake.setEnumSize("net/swofty/nativebridge/representation/BaseType", BASE_TYPE_COUNT);
+        fake.setEnumSize("net/swofty/nativebridge/execution/expressions/BinaryExpression$Operator",
+                         BinaryExpression::OPERATOR_COUNT);
+        const JavaClassCache* cache = JavaClassCache::get(fake.env());
+        if (!cache) {
+            throw std::runtime_error("JavaClassCache failed against the fake JNIEnv");
+        }
+        return *cache;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <jni.h>
+#include "JavaClassCache.h"
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// A JNIEnv backed by plain C++ objects, for testing the JNI bridge without a JVM. Local
+// references live in frames as they do in the JVM, so a test can see how many are live
+// at once, and a use or delete of one already released is counted as an error. Classes,
+// methods and objects are created on demand from the names the bridge asks for.
+//
+// There is one fake for the whole process, as there is one JVM: JavaClassCache and the
+// interner's well-known strings keep global references from the first parse to the last.
+namespace fakejni {
+    struct Object {
+        std::string className;        // "java/lang/Class" for a class, "[..." for an array
+        std::string text;             // a string's value, or the name of a class
+        std::vector<Object*> objects; // array elements, constructor object arguments, added children
+        std::vector<jint> ints;       // int and byte array elements, constructor int and boolean arguments
+        std::map<std::string, std::vector<Object*>> calls; // object arguments of other void calls, by method
+    };
+
+    class Env {
+    public:
+        static Env& get();
+
+        JNIEnv* env() { return &jniEnv; }
+
+        // The Object a reference points to; NULL for NULL
+        Object* deref(jobject ref);
+
+        // Local references created and not yet deleted or popped
+        size_t liveLocals() const { return live; }
+        // The most local references live at once since resetCounts()
+        size_t peakLocals() const { return peak; }
+        // Uses and deletes of released references since resetCounts()
+        size_t errors() const { return misuse; }
+        void resetCounts();
+
+        // Make the next NewObjectArray of this element class fail as an OutOfMemoryError would
+        void failNextArrayOf(const std::string& elementClass) { failingArray = elementClass; }
+
+        // How many constants values() returns for an enum class
+        void setEnumSize(const std::string& className, size_t size) { enumSizes[className] = size; }
+
+    private:
+        struct Ref {
+            Object* target;
+            bool global;
+            bool alive;
+        };
+
+        struct Method {
+            std::string name;
+            std::string signature;
+        };
+
+        JNINativeInterface_ table{};
+        JNIEnv jniEnv{};
+        std::deque<Object> objects;
+        std::deque<Ref> refs;
+        std::deque<Method> methods;
+        std::vector<std::vector<Ref*>> frames;
+        std::map<std::string, size_t> enumSizes;
+        std::string failingArray;
+        bool pending = false;
+        size_t live = 0;
+        size_t peak = 0;
+        size_t misuse = 0;
+
+        Env();
+
+        static Env& of(JNIEnv* env);
+        Object* create(const std::string& className);
+        jobject local(Object* target);
+        jobject global(Object* target);
+        void release(Ref* ref);
+        Method* method(jmethodID id) { return reinterpret_cast<Method*>(id); }
+        void arguments(Object* target, const std::string& signature, va_list args, std::vector<Object*>& objects);
+
+        static jint JNICALL GetVersion(JNIEnv*);
+        static jclass JNICALL FindClass(JNIEnv* env, const char* name);
+        static jint JNICALL ThrowNew(JNIEnv* env, jclass, const char*);
+        static jboolean JNICALL ExceptionCheck(JNIEnv* env);
+        static jthrowable JNICALL ExceptionOccurred(JNIEnv* env);
+        static void JNICALL ExceptionDescribe(JNIEnv*);
+        static void JNICALL ExceptionClear(JNIEnv* env);
+        static jint JNICALL PushLocalFrame(JNIEnv* env, jint);
+        static jobject JNICALL PopLocalFrame(JNIEnv* env, jobject result);
+        static jint JNICALL EnsureLocalCapacity(JNIEnv*, jint);
+        static jobject JNICALL NewGlobalRef(JNIEnv* env, jobject ref);
+        static void JNICALL DeleteGlobalRef(JNIEnv* env, jobject ref);
+        static jobject JNICALL NewLocalRef(JNIEnv* env, jobject ref);
+        static void JNICALL DeleteLocalRef(JNIEnv* env, jobject ref);
+        static jboolean JNICALL IsSameObject(JNIEnv* env, jobject a, jobject b);
+        static jboolean JNICALL IsInstanceOf(JNIEnv* env, jobject obj, jclass cls);
+        static jmethodID JNICALL GetMethodID(JNIEnv* env, jclass, const char* name, const char* signature);
+        static jobject JNICALL NewObjectV(JNIEnv* env, jclass cls, jmethodID id, va_list args);
+        static void JNICALL CallVoidMethodV(JNIEnv* env, jobject obj, jmethodID id, va_list args);
+        static jobject JNICALL CallStaticObjectMethodV(JNIEnv* env, jclass cls, jmethodID id, va_list args);
+        static jstring JNICALL NewStringUTF(JNIEnv* env, const char* utf);
+        static jsize JNICALL GetStringUTFLength(JNIEnv* env, jstring str);
+        static const char* JNICALL GetStringUTFChars(JNIEnv* env, jstring str, jboolean* isCopy);
+        static void JNICALL ReleaseStringUTFChars(JNIEnv*, jstring, const char*);
+        static jsize JNICALL GetArrayLength(JNIEnv* env, jarray array);
+        static jobjectArray JNICALL NewObjectArray(JNIEnv* env, jsize length, jclass cls, jobject init);
+        static jobject JNICALL GetObjectArrayElement(JNIEnv* env, jobjectArray array, jsize index);
+        static void JNICALL SetObjectArrayElement(JNIEnv* env, jobjectArray array, jsize index, jobject value);
+        static jintArray JNICALL NewIntArray(JNIEnv* env, jsize length);
+        static void JNICALL SetIntArrayRegion(JNIEnv* env, jintArray array, jsize start, jsize length, const jint* values);
+        static void JNICALL GetIntArrayRegion(JNIEnv* env, jintArray array, jsize start, jsize length, jint* values);
+    };
+
+    // The bridge's class cache, resolved against the fake
+    const JavaClassCache& classCache();
+}
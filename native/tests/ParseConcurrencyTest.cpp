@@ -0,0 +1,90 @@
+// Parses on many threads at once must give the same result as one parse on its own: the
+// parser's per-thread scratch (token buffer, ScratchArena) must never leak between threads
+// or between parses. Build with SWOFTLANG_SANITIZE_THREAD=ON to run this under TSan.
+#include "Test.h"
+#include "SwoftLangParser.h"
+#include "ScriptSerializer.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int THREADS = 8;
+    constexpr int ROUNDS = 200;
+
+    const char* const BLOCKS[] = {
+        "set x to \"a\"\nif x = \"a\" {\n    send \"first ${x}\" to sender\n} else {\n    send \"other\" to sender\n}\n",
+        "set name to \"bob\"\nif name contains \"O\" {\n    send \"found\"\n    halt\n}\nsend \"missing\"\n",
+        "send \"hello\" to all\n",
+    };
+
+    std::vector<uint8_t> wire(const std::string& source) {
+        auto parsed = SwoftLangParser::parseAll(source);
+        return ScriptSerializer::serialize(parsed.first, parsed.second);
+    }
+
+    std::vector<uint8_t> blockWire(const std::string& source) {
+        auto command = std::make_shared<Command>("block");
+        command->setExecuteBlock(SwoftLangParser::parseExecuteBlock(source));
+        return ScriptSerializer::serialize({command}, {});
+    }
+}
+
+SWOFT_TEST(parseConcurrency) {
+    std::vector<std::string> scripts = {swofttest::readScript("command.sw"), swofttest::readScript("event.sw")};
+    std::vector<std::vector<uint8_t>> expectedScripts;
+    for (const auto& script : scripts) {
+        expectedScripts.push_back(wire(script));
+    }
+    std::vector<std::vector<uint8_t>> expectedBlocks;
+    for (const char* block : BLOCKS) {
+        expectedBlocks.push_back(blockWire(block));
+    }
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t] {
+            // Each thread walks the inputs from a different start, so different parses overlap
+            for (int round = 0; round < ROUNDS; round++) {
+                size_t script = (t + round) % scripts.size();
+                if (wire(scripts[script]) != expectedScripts[script]) {
+                    mismatches++;
+                }
+                size_t block = (t + round) % expectedBlocks.size();
+                if (blockWire(BLOCKS[block]) != expectedBlocks[block]) {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    SWOFT_CHECK(mismatches == 0);
+}
+
+SWOFT_TEST(parseKeepsResultsAcrossThreads) {
+    // Nodes from one thread's parse stay valid after that thread parses again and after
+    // they are released on another thread
+    std::string script = swofttest::readScript("event.sw");
+    std::vector<uint8_t> expected = wire(script);
+
+    auto kept = SwoftLangParser::parseAll(script);
+    std::atomic<int> mismatches{0};
+    std::thread other([&] {
+        for (int i = 0; i < ROUNDS; i++) {
+            if (wire(script) != expected) {
+                mismatches++;
+            }
+        }
+        kept = {};
+    });
+    for (int i = 0; i < ROUNDS; i++) {
+        if (wire(script) != expected) {
+            mismatches++;
+        }
+    }
+    other.join();
+    SWOFT_CHECK(mismatches == 0);
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Minimal test registry for swoft_tests. Each test registers itself by name and fails by
+// throwing; `swoft_tests <name>` runs one test and `swoft_tests` runs all of them.
+namespace swofttest {
+    using TestFunction = void (*)();
+
+    inline std::map<std::string, TestFunction>& registry() {
+        static std::map<std::string, TestFunction> tests;
+        return tests;
+    }
+
+    struct Registration {
+        Registration(const char* name, TestFunction test) { registry()[name] = test; }
+    };
+
+    [[noreturn]] inline void fail(const char* file, int line, const std::string& message) {
+        throw std::runtime_error(std::string(file) + ":" + std::to_string(line) + ": " + message);
+    }
+
+    // A script from the repository's scripts/ directory
+    inline std::string readScript(const std::string& name) {
+        std::ifstream in(std::string(SWOFT_SCRIPTS_DIR) + "/" + name, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot open script " + name);
+        }
+        std::ostringstream out;
+        out << in.rdbuf();
+        return out.str();
+    }
+
+    struct StackContext {
+        const std::function<void()>& work;
+        std::exception_ptr error;
+
+        void run() {
+            try {
+                work();
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    // Runs work on a new thread with a stack of the given size, like the stack a JVM gives
+    // the thread a script is parsed on, and rethrows anything it throws
+    inline void runWithStack(size_t bytes, const std::function<void()>& work) {
+        StackContext context{work, nullptr};
+#ifdef _WIN32
+        HANDLE thread = CreateThread(nullptr, bytes, [](LPVOID argument) -> DWORD {
+            static_cast<StackContext*>(argument)->run();
+            return 0;
+        }, &context, STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+        WaitForSingleObject(thread, INFINITE);
+        CloseHandle(thread);
+#else
+        pthread_attr_t attributes;
+        pthread_attr_init(&attributes);
+        pthread_attr_setstacksize(&attributes, bytes);
+        pthread_t thread;
+        pthread_create(&thread, &attributes, [](void* argument) -> void* {
+            static_cast<StackContext*>(argument)->run();
+            return nullptr;
+        }, &context);
+        pthread_join(thread, nullptr);
+        pthread_attr_destroy(&attributes);
+#endif
+        if (context.error) {
+            std::rethrow_exception(context.error);
+        }
+    }
+}
+
+#define SWOFT_TEST(name)                                                  \
+    static void name();                                                   \
+    static swofttest::Registration name##Registration(#name, name);       \
+    static void name()
+
+#define SWOFT_CHECK(condition)                                            \
+    do {                                                                  \
+        if (!(condition)) swofttest::fail(__FILE__, __LINE__, #condition); \
+    } while (0)
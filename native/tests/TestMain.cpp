@@ -0,0 +1,25 @@
+#include "Test.h"
+#include <iostream>
+
+int main(int argc, char** argv) {
+    int failures = 0;
+    int run = 0;
+    for (const auto& [name, test] : swofttest::registry()) {
+        if (argc > 1 && name != argv[1]) {
+            continue;
+        }
+        run++;
+        try {
+            test();
+            std::cout << "PASS " << name << std::endl;
+        } catch (const std::exception& e) {
+            failures++;
+            std::cout << "FAIL " << name << ": " << e.what() << std::endl;
+        }
+    }
+    if (run == 0) {
+        std::cerr << "No test named " << (argc > 1 ? argv[1] : "") << std::endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
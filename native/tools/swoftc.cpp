@@ -0,0 +1,279 @@
+// swoftc - parses SwoftLang scripts and prints the bytecode of every handler.
+//
+//   swoftc [--emit-class <dir>] [--run <command|event> <name>] [--set path=value]...
+//          [--player path=Name]... [--repeat N] <script.sw>...
+//
+// Each command and event is run through the same passes as the runtime, then its
+// execute block is compiled and disassembled (see Disassembler.h). A block the
+// compiler cannot express is reported as running on the tree walker. --emit-class
+// also writes the JVM class JvmBackend generates for each block to
+// <dir>/<command|event>_<name>.class, for javap.
+//
+// With --run, the named handler is instead executed on the native VM against a
+// LocalHost. --set and --player build its variables (`--set event.message=hi`,
+// `--player event.player=Steve`); values that parse as numbers or true/false get
+// those types. The effects of the first run are printed, then the time and host
+// calls per run over --repeat runs.
+#include <SwoftLangParser.h>
+#include <Compiler.h>
+#include <Disassembler.h>
+#include <Diagnostics.h>
+#include <JvmBackend.h>
+#include <LocalHost.h>
+#include <VirtualMachine.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+    struct RunOptions {
+        std::string kind;   // "command" or "event", empty to disassemble
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> values;   // path, value
+        std::vector<std::pair<std::string, std::string>> players;  // path, name
+        long repeat = 1;
+        std::string classDirectory;   // where --emit-class writes, empty for none
+    };
+
+    bool splitAssignment(const std::string& argument, std::pair<std::string, std::string>& out) {
+        size_t equals = argument.find('=');
+        if (equals == std::string::npos || equals == 0) {
+            return false;
+        }
+        out = {argument.substr(0, equals), argument.substr(equals + 1)};
+        return true;
+    }
+
+    Value parseValue(LocalHost& host, const std::string& text) {
+        if (text == "true" || text == "false") {
+            return Value::boolean(text == "true");
+        }
+        char* end = nullptr;
+        double number = std::strtod(text.c_str(), &end);
+        if (!text.empty() && end == text.c_str() + text.size()) {
+            return host.addNumber(number, text);
+        }
+        return Value::string(text);
+    }
+
+    // Store `value` at a dotted path, creating the objects along it
+    void assign(LocalHost& host, std::map<std::string, Value>& variables, const std::string& path, Value value) {
+        size_t dot = path.find('.');
+        std::string root = path.substr(0, dot);
+        if (dot == std::string::npos) {
+            variables[root] = std::move(value);
+            return;
+        }
+
+        Value& object = variables[root];
+        if (object.kind != Value::Kind::OBJECT) {
+            object = host.addObject(Value::ObjectType::OTHER, root);
+        }
+        Value current = object;
+        std::string walked = root;
+
+        while (true) {
+            size_t next = path.find('.', dot + 1);
+            std::string segment = path.substr(dot + 1, next == std::string::npos ? std::string::npos : next - dot - 1);
+            walked += "." + segment;
+            if (next == std::string::npos) {
+                host.setProperty(current, segment, std::move(value));
+                return;
+            }
+
+            Value child = host.getProperty(current, segment);
+            if (child.kind != Value::Kind::OBJECT) {
+                child = host.addObject(Value::ObjectType::OTHER, walked);
+                host.setProperty(current, segment, child);
+            }
+            current = child;
+            dot = next;
+        }
+    }
+
+    int runHandler(const RunOptions& options, const std::string& title, const std::shared_ptr<ExecuteBlock>& block) {
+        std::cout << title << "\n";
+        auto program = block ? Compiler::compile(*block) : std::nullopt;
+        if (!program) {
+            std::cout << "  (not compiled, runs on the tree walker)\n";
+            return 1;
+        }
+
+        VirtualMachine vm(std::move(*program));
+        double nanos = 0;
+        size_t calls = 0;
+
+        // Every run gets fresh variables, since writes and sends change the host
+        for (long i = 0; i < options.repeat; i++) {
+            LocalHost host;
+            std::map<std::string, Value> variables;
+            variables["sender"] = host.addObject(Value::ObjectType::OTHER, "CONSOLE");
+            for (const auto& player : options.players) {
+                assign(host, variables, player.first, host.addObject(Value::ObjectType::PLAYER, player.second));
+            }
+            for (const auto& value : options.values) {
+                assign(host, variables, value.first, parseValue(host, value.second));
+            }
+
+            std::vector<Value> frame;
+            for (const auto& name : block->getSlotNames()) {
+                auto it = variables.find(name);
+                frame.push_back(it != variables.end() ? it->second : Value::nil());
+            }
+
+            size_t callsBefore = host.getCalls();
+            auto start = std::chrono::steady_clock::now();
+            VirtualMachine::Outcome outcome = vm.run(frame, host);
+            nanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            calls += host.getCalls() - callsBefore;
+
+            if (i == 0) {
+                for (const auto& line : host.getLog()) {
+                    std::cout << "  " << line << "\n";
+                }
+                if (outcome == VirtualMachine::Outcome::HALTED) {
+                    std::cout << "  halt\n";
+                }
+            }
+        }
+
+        std::cout << "; " << options.repeat << " run(s), " << static_cast<long>(nanos / options.repeat)
+                  << " ns/run, " << calls / options.repeat << " host call(s)/run\n";
+        return 0;
+    }
+
+    // The class the runtime would define for the block; see HandlerClasses.java
+    int writeClass(const std::string& directory, const std::string& title, const Program& program,
+                   const ExecuteBlock& block) {
+        std::string path = directory + "/" + title + ".class";
+        std::replace(path.begin() + static_cast<long>(directory.size()) + 1, path.end(), ' ', '_');
+
+        try {
+            std::vector<uint8_t> bytes = JvmBackend::generate(program, block.getSlotNames().size(),
+                                                              "net/swofty/GeneratedHandler");
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!file) {
+                std::cerr << "swoftc: cannot write " << path << std::endl;
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cout << "; no class: " << e.what() << "\n";
+        }
+        return 0;
+    }
+
+    int printBlock(const RunOptions& options, const std::string& title, const std::shared_ptr<ExecuteBlock>& block) {
+        std::cout << title << "\n";
+        if (!block) {
+            std::cout << "  (no execute block)\n\n";
+            return 0;
+        }
+
+        auto program = Compiler::compile(*block);
+        if (!program) {
+            std::cout << "  (not compiled, runs on the tree walker)\n\n";
+            return 0;
+        }
+        std::cout << Disassembler::disassemble(*program, block->getSlotNames()) << "\n";
+        return options.classDirectory.empty() ? 0 : writeClass(options.classDirectory, title, *program, *block);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* usage = "usage: swoftc [--emit-class <dir>] [--run <command|event> <name>] [--set path=value]... "
+                        "[--player path=Name]... [--repeat N] <script.sw>...";
+
+    RunOptions options;
+    std::vector<std::string> scripts;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        std::pair<std::string, std::string> assignment;
+
+        if (argument == "--run" && i + 2 < argc) {
+            options.kind = argv[++i];
+            options.name = argv[++i];
+        } else if (argument == "--set" && i + 1 < argc && splitAssignment(argv[i + 1], assignment)) {
+            options.values.push_back(assignment);
+            i++;
+        } else if (argument == "--player" && i + 1 < argc && splitAssignment(argv[i + 1], assignment)) {
+            options.players.push_back(assignment);
+            i++;
+        } else if (argument == "--emit-class" && i + 1 < argc) {
+            options.classDirectory = argv[++i];
+        } else if (argument == "--repeat" && i + 1 < argc && std::atol(argv[i + 1]) > 0) {
+            options.repeat = std::atol(argv[++i]);
+        } else if (argument.rfind("--", 0) == 0) {
+            std::cerr << usage << std::endl;
+            return 2;
+        } else {
+            scripts.push_back(argument);
+        }
+    }
+
+    if (scripts.empty() || (!options.kind.empty() && options.kind != "command" && options.kind != "event")) {
+        std::cerr << usage << std::endl;
+        return 2;
+    }
+
+    int status = 0;
+    bool ran = false;
+    for (const auto& script : scripts) {
+        std::ifstream file(script, std::ios::binary);
+        if (!file) {
+            std::cerr << "swoftc: cannot read " << script << std::endl;
+            status = 1;
+            continue;
+        }
+        std::stringstream source;
+        source << file.rdbuf();
+
+        try {
+            Diagnostics::Scope diagnostics;
+            auto parsed = SwoftLangParser::parseAll(source.str());
+
+            if (!options.kind.empty()) {
+                if (options.kind == "command") {
+                    for (const auto& command : parsed.first) {
+                        if (command && command->getName() == options.name) {
+                            status |= runHandler(options, "command " + options.name, command->getExecuteBlock());
+                            ran = true;
+                        }
+                    }
+                } else {
+                    for (const auto& event : parsed.second) {
+                        if (event && event->getName() == options.name) {
+                            status |= runHandler(options, "event " + options.name, event->getExecuteBlock());
+                            ran = true;
+                        }
+                    }
+                }
+                continue;
+            }
+
+            std::cout << "== " << script << "\n";
+            for (const auto& note : diagnostics.getNotes()) {
+                std::cout << "; " << note << "\n";
+            }
+            for (const auto& command : parsed.first) {
+                if (command) status |= printBlock(options, "command " + command->getName(), command->getExecuteBlock());
+            }
+            for (const auto& event : parsed.second) {
+                if (event) status |= printBlock(options, "event " + event->getName(), event->getExecuteBlock());
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "swoftc: " << script << ": " << e.what() << std::endl;
+            status = 1;
+        }
+    }
+
+    if (!options.kind.empty() && !ran) {
+        std::cerr << "swoftc: no " << options.kind << " named " << options.name << std::endl;
+        status = 1;
+    }
+    return status;
+}